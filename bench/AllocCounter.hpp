@@ -0,0 +1,55 @@
+/*
+ * AllocCounter.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef BENCH_ALLOCCOUNTER_HPP_
+#define BENCH_ALLOCCOUNTER_HPP_
+
+#include <cstddef>
+
+/**
+ * Contadores globales de reservas de memoria. Sólo debe incluirse desde un
+ * único fichero por programa, ya que reemplaza los operadores globales
+ * "new" y "delete" (con <cli++/CountingNew.hpp>, contando todas las
+ * reservas y no sólo las de los análisis con estadísticas).
+ */
+namespace bench {
+
+struct AllocCounter {
+	unsigned long	allocations;	/// Número de reservas.
+	unsigned long	bytes;			/// Bytes reservados.
+};
+
+static AllocCounter	gAllocCounter = { 0, 0 };
+
+/**
+ * Cuenta una reserva.
+ *
+ * @param size_t size Tamaño de la reserva.
+ */
+inline void
+countAllocation(std::size_t size) {
+	gAllocCounter.allocations++;
+	gAllocCounter.bytes += size;
+}
+
+/**
+ * Devuelve una copia de los contadores actuales.
+ *
+ * @return AllocCounter Contadores.
+ */
+inline AllocCounter
+allocSnapshot() {
+	return gAllocCounter;
+}
+
+}	// namespace bench
+
+#define CLIPP_COUNT_ALLOCATION(size)	bench::countAllocation(size)
+#include <cli++/CountingNew.hpp>
+
+#endif /* BENCH_ALLOCCOUNTER_HPP_ */
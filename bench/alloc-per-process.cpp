@@ -0,0 +1,71 @@
+/*
+ * alloc-per-process.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "AllocCounter.hpp"
+
+/**
+ * Mide la memoria reservada por cada llamada a "process()" con una línea de
+ * comandos típica (unas pocas opciones con 0 o 1 valores y un par de
+ * argumentos posicionales).
+ */
+
+static const int	Iterations	= 20000;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int
+main(int argc, char** argv) {
+
+	const char* args[] = {
+		"prog", "--verbose", "-v", "--input", "a.txt", "--output=b.txt",
+		"--threads", "8", "-q", "--mode", "fast", "file1", "file2"
+	};
+	int count = sizeof(args) / sizeof(args[0]);
+
+	unsigned long allocations = 0;
+	unsigned long bytes = 0;
+	double elapsed = 0;
+
+	for(int i = 0; i < Iterations; i++) {
+		clipp::OptionManager om(count, const_cast<char**>(args));
+		om.option("verbose").alias("v").multiple().description("Verbose.");
+		om.option("input").argumentRequired().description("Input file.");
+		om.option("output").argumentRequired().description("Output file.");
+		om.option("threads").argumentRequired().typeInteger().description("Threads.");
+		om.option("q").description("Quiet.");
+		om.option("mode").argumentRequired().description("Mode.");
+		om.option("help").exclusive().description("Help.");
+
+		bench::AllocCounter before = bench::allocSnapshot();
+		double start = now();
+		om.process();
+		elapsed += now() - start;
+		bench::AllocCounter after = bench::allocSnapshot();
+
+		allocations += after.allocations - before.allocations;
+		bytes += after.bytes - before.bytes;
+	}
+
+	printf("process(): %.1f allocations, %.1f bytes, %.0f ns per call (%d iterations)\n",
+			(double)allocations / Iterations, (double)bytes / Iterations, elapsed / Iterations, Iterations);
+
+	return 0;
+}
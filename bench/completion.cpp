@@ -0,0 +1,129 @@
+/*
+ * completion.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Latencia de una pulsación de TAB en un programa con 1000 opciones: el
+ * programa se arranca, crea sus definiciones y responde a "--__complete".
+ * Se mide dentro del proceso (definiciones + complete(), y definiciones +
+ * process() para comparar) y ejecutando el propio programa como lo haría la
+ * shell.
+ */
+
+static const int	Options = 1000;
+static const int	Iterations = 200;
+static const int	Runs = 50;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void
+define(clipp::OptionManager& om) {
+	const string levels[] = { "debug", "error", "info", "trace", "warning" };
+	for(int i = 0; i < Options; i++) {
+		ostringstream name;
+		name << "option-" << i;
+		clipp::OptionDefinition& od = om.option(name.str(), i);
+		if(i % 10 == 0) {
+			od.argumentRequired().validStrings(levels, 5).description("An option with a few valid values.");
+		} else {
+			od.description("A flag.");
+		}
+	}
+}
+
+int
+main(int argc, char** argv) {
+	clipp::OptionManager om;
+	define(om);
+	if(om.complete(argc, argv)) {
+		return 0;
+	}
+
+	const char* request[] = { argv[0], clipp::Completion::Request, "1", "tool", "--option-12", NULL };
+	const char* values[] = { argv[0], clipp::Completion::Request, "2", "tool", "--option-10", "", NULL };
+	const char* line[] = { "tool", "--option-12" };
+	size_t candidates = 0;
+
+	{
+		double start = now();
+		for(int n = 0; n < Iterations; n++) {
+			clipp::OptionManager om;
+			define(om);
+			candidates += om.countDefinedOptions();
+		}
+		printf("%-34s %8.1f us/invocation\n", "definitions only", (now() - start) / 1e3 / Iterations);
+	}
+
+	{
+		double start = now();
+		for(int n = 0; n < Iterations; n++) {
+			clipp::OptionManager om;
+			define(om);
+			ostringstream out;
+			if(n % 2 == 0) {
+				om.complete(5, const_cast<char**>(request), out);
+			} else {
+				om.complete(6, const_cast<char**>(values), out);
+			}
+			candidates += out.str().length();
+		}
+		printf("%-34s %8.1f us/keystroke\n", "definitions + complete()", (now() - start) / 1e3 / Iterations);
+	}
+
+	{
+		double start = now();
+		for(int n = 0; n < Iterations; n++) {
+			clipp::OptionManager om;
+			define(om);
+			om.process(2, const_cast<char**>(line));
+			candidates += om.countProcessedOptions();
+		}
+		printf("%-34s %8.1f us/invocation\n", "definitions + process()", (now() - start) / 1e3 / Iterations);
+	}
+
+	{
+		// Como la shell: un proceso nuevo por pulsación.
+		double start = now();
+		for(int n = 0; n < Runs; n++) {
+			pid_t pid = fork();
+			if(pid == 0) {
+				int null = open("/dev/null", O_WRONLY);
+				dup2(null, 1);
+				execv(argv[0], const_cast<char**>(request));
+				_exit(127);
+			}
+			int status;
+			waitpid(pid, &status, 0);
+			if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+				fprintf(stderr, "Completion request failed.\n");
+				return 1;
+			}
+		}
+		printf("%-34s %8.1f us/keystroke\n", "fork + exec + complete()", (now() - start) / 1e3 / Runs);
+	}
+
+	return candidates > 0 ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+/*
+ * decode-tokens.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "AllocCounter.hpp"
+
+/**
+ * Mide las reservas de memoria y el tiempo por cada elemento de la línea de
+ * comandos en la decodificación de opciones largas, cortas, agrupadas y de
+ * la forma --opcion=valor. Las opciones se repiten muchas veces para que el
+ * coste fijo (crear cada Option) no influya.
+ */
+
+static const int	Tokens		= 10000;
+static const int	Iterations	= 50;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void
+run(const char* title, const char* token) {
+	vector<string> storage(Tokens + 1, token);
+	storage[0] = "prog";
+	vector<char*> args;
+	for(size_t i = 0; i < storage.size(); i++) {
+		args.push_back(const_cast<char*>(storage[i].c_str()));
+	}
+
+	unsigned long allocations = 0;
+	double elapsed = 0;
+
+	for(int i = 0; i < Iterations; i++) {
+		clipp::OptionManager om((int)args.size(), &args[0]);
+		om.option("verbose-output-level").alias("v").multiple();
+		om.option("a").multiple();
+		om.option("b").multiple();
+		om.option("c").multiple();
+		om.option("define-preprocessor-macro").alias("D").multiple().argumentRequired();
+
+		bench::AllocCounter before = bench::allocSnapshot();
+		double start = now();
+		om.process();
+		elapsed += now() - start;
+		allocations += bench::allocSnapshot().allocations - before.allocations;
+	}
+
+	printf("%-28s %8.4f allocations/token %8.1f ns/token\n", title,
+			(double)allocations / Iterations / Tokens, elapsed / Iterations / Tokens);
+}
+
+int
+main(int argc, char** argv) {
+	run("long (--name)", "--verbose-output-level");
+	run("short (-v)", "-v");
+	run("short cluster (-abc)", "-abc");
+	run("long (--name=value)", "--define-preprocessor-macro=NDEBUG");
+	run("short with value (-Dvalue)", "-DNDEBUG");
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * id-queries.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Compara las consultas por id (hasOption(id), getOption(id) y
+ * occurrences(id)) con el recorrido secuencial de las apariciones que
+ * hacía antes hasOption(id). Se definen 500 opciones múltiples con id
+ * del 1 al 500 y la línea de comandos tiene 10000 apariciones.
+ */
+
+static const int	Options = 500;
+static const int	Occurrences = 10000;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Búsqueda secuencial por id sobre todas las apariciones (lo que hacía
+ * hasOption(id) recorriendo la lista de opciones).
+ */
+static bool
+scanHasOption(clipp::OptionManager& om, int id) {
+	om.rewind();
+	const clipp::Option* op;
+	while((op = om.next()) != NULL) {
+		if(op->id() == id) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int
+main() {
+	clipp::OptionManager om;
+	vector<string> names;
+	for(int i = 0; i < Options; i++) {
+		char name[32];
+		sprintf(name, "option-%d", i);
+		names.push_back(string("--") + name);
+		om.option(name, i + 1).multiple();
+	}
+
+	vector<char*> argv;
+	argv.push_back(const_cast<char*>("id-queries"));
+	for(int i = 0; i < Occurrences; i++) {
+		// Sólo aparece la mitad de las opciones, para que haya consultas que fallan.
+		argv.push_back(const_cast<char*>(names[(i * 2) % Options].c_str()));
+	}
+	om.process(argv.size(), &argv[0]);
+
+	// Cada consulta pregunta por todos los id (y uno que no existe).
+	int found = 0;
+	double start = now();
+	const int scanRounds = 2;
+	for(int r = 0; r < scanRounds; r++) {
+		for(int id = 1; id <= Options + 1; id++) {
+			found += scanHasOption(om, id);
+		}
+	}
+	double scan = (now() - start) / (scanRounds * (Options + 1));
+
+	const int rounds = 2000;
+	start = now();
+	for(int r = 0; r < rounds; r++) {
+		for(int id = 1; id <= Options + 1; id++) {
+			found += om.hasOption(id);
+		}
+	}
+	double has = (now() - start) / (rounds * (Options + 1));
+
+	start = now();
+	long count = 0;
+	for(int r = 0; r < rounds; r++) {
+		for(int id = 1; id <= Options + 1; id++) {
+			const clipp::Option* op = om.getOption(id);
+			count += (op != NULL ? op->occurrences() : 0);
+		}
+	}
+	double get = (now() - start) / (rounds * (Options + 1));
+
+	start = now();
+	for(int r = 0; r < rounds; r++) {
+		for(int id = 1; id <= Options + 1; id++) {
+			count += om.occurrences(id);
+		}
+	}
+	double occ = (now() - start) / (rounds * (Options + 1));
+
+	printf("%-40s %10.1f ns/query\n", "scan of the occurrences", scan);
+	printf("%-40s %10.1f ns/query\n", "hasOption(id)", has);
+	printf("%-40s %10.1f ns/query\n", "getOption(id)->occurrences()", get);
+	printf("%-40s %10.1f ns/query\n", "occurrences(id)", occ);
+
+	return (found > 0 && count > 0) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/*
+ * parse-numbers.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "AllocCounter.hpp"
+
+/**
+ * Compara la conversión de números con "stringstream" (la implementación
+ * anterior de StringIs/StringTo, copiada aquí) con ParseValue(), y mide el
+ * coste de analizar una línea de comandos con argumentos enteros, reales y
+ * booleanos (cada argumento se convierte una sola vez) y el coste de leer
+ * los valores ya convertidos con Option::get<T>().
+ */
+
+static const int	Conversions	= 200000;
+static const int	Iterations	= 2000;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+template <typename T>
+static bool
+streamIs(const string value) {
+	stringstream iss(value);
+	T result;
+	iss >> result;
+	return !iss.fail() && iss.rdbuf()->in_avail() <= 0;
+}
+
+template <typename T>
+static T
+streamTo(const string value, T defaultValue) {
+	stringstream iss(value);
+	T result;
+	iss >> result;
+	return (iss.fail() ? defaultValue : result);
+}
+
+template <typename T>
+static void
+compare(const char* title, const char* text) {
+	volatile double sink = 0;
+	bench::AllocCounter before = bench::allocSnapshot();
+	double start = now();
+	for(int i = 0; i < Conversions; i++) {
+		// Como antes: comprobar el tipo y luego convertir.
+		if(streamIs<T>(text)) {
+			sink += streamTo<T>(text, 0);
+		}
+	}
+	double oldTime = (now() - start) / Conversions;
+	double oldAllocs = (double)(bench::allocSnapshot().allocations - before.allocations) / Conversions;
+
+	clipp::StringRef ref(text);
+	before = bench::allocSnapshot();
+	start = now();
+	for(int i = 0; i < Conversions; i++) {
+		T value;
+		if(clipp::ParseValue(ref, value)) {
+			sink += value;
+		}
+	}
+	double newTime = (now() - start) / Conversions;
+	double newAllocs = (double)(bench::allocSnapshot().allocations - before.allocations) / Conversions;
+
+	printf("%-18s stringstream %7.1f ns %5.2f allocs | ParseValue %6.1f ns %5.2f allocs\n", title, oldTime, oldAllocs, newTime, newAllocs);
+}
+
+int
+main(int argc, char** argv) {
+	compare<int>("int 123456", "123456");
+	compare<int>("int -42", "-42");
+	compare<float>("float 3.14159", "3.14159");
+	compare<float>("float -1.5e-3", "-1.5e-3");
+	compare<double>("double 2.5e10", "2.5e10");
+
+	const char* args[] = { "prog", "--count", "123456", "--ratio", "3.14159", "--enabled", "yes", "-n", "42", "-s", "0.5" };
+	int count = sizeof(args) / sizeof(args[0]);
+	int n;
+	float s;
+
+	clipp::OptionManager om;
+	om.option("count").argumentRequired().typeInteger();
+	om.option("ratio").argumentRequired().typeFloat();
+	om.option("enabled").argumentRequired().typeBool();
+	om.option("n").var(&n);
+	om.option("s").var(&s);
+
+	clipp::ParseResult result;
+	om.process(count, const_cast<char**>(args), result);
+
+	bench::AllocCounter before = bench::allocSnapshot();
+	double start = now();
+	for(int i = 0; i < Iterations; i++) {
+		om.process(count, const_cast<char**>(args), result);
+	}
+	printf("%-18s %8.1f ns/parse %8.2f allocs/parse\n", "typed command line",
+			(now() - start) / Iterations, (double)(bench::allocSnapshot().allocations - before.allocations) / Iterations);
+
+	const clipp::Option* countOption = result.getOption("count");
+	const clipp::Option* ratioOption = result.getOption("ratio");
+	volatile double sink = 0;
+	before = bench::allocSnapshot();
+	start = now();
+	for(int i = 0; i < Conversions; i++) {
+		sink += countOption->get<int>(0) + ratioOption->get<double>(0);
+	}
+	printf("%-18s %8.1f ns/call  %8.2f allocs/call\n", "get<int>+get<double>",
+			(now() - start) / Conversions, (double)(bench::allocSnapshot().allocations - before.allocations) / Conversions);
+
+	return 0;
+}
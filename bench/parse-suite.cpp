@@ -0,0 +1,282 @@
+/*
+ * parse-suite.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sys/resource.h>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+#include <cli++/StaticParser.hpp>
+
+#include "AllocCounter.hpp"
+
+/**
+ * Batería de pruebas de rendimiento del análisis de la línea de comandos.
+ * Para cada caso se muestra el tiempo y las reservas de memoria por cada
+ * análisis (o por cada llamada a description()) y el pico de memoria
+ * residente del proceso hasta ese momento. Se ejecuta con "make bench".
+ *
+ * Si se pasa un argumento, sólo se ejecutan los casos cuyo nombre lo
+ * contengan.
+ */
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static long
+peakRss() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;	// KiB en Linux.
+}
+
+/**
+ * Línea de comandos de un caso. Guarda las cadenas para que "argv" siga
+ * siendo válido mientras se usa.
+ */
+class CommandLine {
+	private:
+		vector<string>	fStorage;
+		vector<char*>	fArgv;
+
+	public:
+		CommandLine() { add("prog"); }
+
+		CommandLine& add(const string arg) {
+			fStorage.push_back(arg);
+			return *this;
+		}
+
+		CommandLine& add(const string arg, int times) {
+			for(int i = 0; i < times; i++) {
+				fStorage.push_back(arg);
+			}
+			return *this;
+		}
+
+		int argc() const { return fStorage.size(); }
+
+		char** argv() {
+			fArgv.clear();
+			for(size_t i = 0; i < fStorage.size(); i++) {
+				fArgv.push_back(const_cast<char*>(fStorage[i].c_str()));
+			}
+			return &fArgv[0];
+		}
+};
+
+static const char*	gFilter = NULL;
+
+static bool
+selected(const char* name) {
+	return gFilter == NULL || strstr(name, gFilter) != NULL;
+}
+
+static void
+report(const char* name, int iterations, double elapsed, const bench::AllocCounter& before, const char* unit) {
+	bench::AllocCounter after = bench::allocSnapshot();
+	printf("%-30s %10.1f ns/%-5s %8.2f allocs/%-5s %10.0f bytes/%-5s %7ld KiB peak RSS\n", name,
+			elapsed / iterations, unit,
+			(double)(after.allocations - before.allocations) / iterations, unit,
+			(double)(after.bytes - before.bytes) / iterations, unit,
+			peakRss());
+}
+
+static void
+run(const char* name, clipp::OptionManager& om, CommandLine& line, int iterations) {
+	if(!selected(name)) {
+		return;
+	}
+	clipp::ParseResult result;
+	char** argv = line.argv();
+	om.process(line.argc(), argv, result);	// Calentamiento (y compilación del esquema).
+
+	bench::AllocCounter before = bench::allocSnapshot();
+	double start = now();
+	for(int i = 0; i < iterations; i++) {
+		om.process(line.argc(), argv, result);
+	}
+	report(name, iterations, now() - start, before, "parse");
+}
+
+static void
+defineSmall(clipp::OptionManager& om) {
+	om.option("help", 'h').alias("h").exclusive().description("Shows this help.");
+	om.option("verbose", 'v').alias("v").multiple().description("More verbose output.");
+	om.option("quiet", 'q').alias("q").description("Quiet output.");
+	om.option("input", 'i').alias("i").argumentRequired().description("Input file.");
+	om.option("output", 'o').alias("o").argumentRequired().description("Output file.");
+	om.option("threads", 't').alias("t").argumentRequired().typeInteger().description("Number of threads.");
+	om.option("ratio").argumentRequired().typeFloat().description("Compression ratio.");
+	om.option("mode").argumentRequired().validString("fast").validString("slow").description("Mode.");
+	om.option("define", 'D').alias("D").multiple().argumentRequired().description("Defines a macro.");
+	om.option("color").allowNoPreffix().description("Colored output.");
+}
+
+/**
+ * El esquema pequeño en tiempo de compilación (sin las cadenas válidas de
+ * "--mode").
+ */
+struct SHelp : clipp::StaticOption<bool, clipp::StaticExclusive, 'h'> { static constexpr const char* name() { return "help"; } };
+struct SVerbose : clipp::StaticOption<bool, clipp::StaticMultiple, 'v'> { static constexpr const char* name() { return "verbose"; } };
+struct SQuiet : clipp::StaticOption<bool, clipp::StaticNone, 'q'> { static constexpr const char* name() { return "quiet"; } };
+struct SInput : clipp::StaticOption<clipp::StringRef, clipp::StaticNone, 'i'> { static constexpr const char* name() { return "input"; } };
+struct SOutput : clipp::StaticOption<clipp::StringRef, clipp::StaticNone, 'o'> { static constexpr const char* name() { return "output"; } };
+struct SThreads : clipp::StaticOption<int, clipp::StaticNone, 't'> { static constexpr const char* name() { return "threads"; } };
+struct SRatio : clipp::StaticOption<float> { static constexpr const char* name() { return "ratio"; } };
+struct SMode : clipp::StaticOption<clipp::StringRef> { static constexpr const char* name() { return "mode"; } };
+struct SDefine : clipp::StaticOption<clipp::StringRef, clipp::StaticMultiple, 'D'> { static constexpr const char* name() { return "define"; } };
+struct SColor : clipp::StaticOption<bool> { static constexpr const char* name() { return "color"; } };
+
+typedef clipp::StaticParser<SHelp, SVerbose, SQuiet, SInput, SOutput, SThreads, SRatio, SMode, SDefine, SColor>	SmallStaticParser;
+
+static void
+runStatic(const char* name, CommandLine& line, int iterations) {
+	if(!selected(name)) {
+		return;
+	}
+	SmallStaticParser parser;
+	char** argv = line.argv();
+	parser.process(line.argc(), argv);	// Calentamiento.
+
+	bench::AllocCounter before = bench::allocSnapshot();
+	double start = now();
+	for(int i = 0; i < iterations; i++) {
+		parser.process(line.argc(), argv);
+	}
+	report(name, iterations, now() - start, before, "parse");
+}
+
+static void
+defineLarge(clipp::OptionManager& om, int count) {
+	defineSmall(om);
+	for(int i = 0; i < count - 10; i++) {
+		char name[64];
+		sprintf(name, "generated-option-number-%d", i);
+		clipp::OptionDefinition& od = om.option(name).description("Generated option for the benchmark.");
+		if(i % 3 == 0) {
+			od.argumentRequired();
+		}
+	}
+}
+
+int
+main(int argc, char** argv) {
+	gFilter = (argc > 1 ? argv[1] : NULL);
+
+	{
+		clipp::OptionManager om;
+		defineSmall(om);
+		CommandLine line;
+		line.add("-v").add("--input").add("in.txt").add("-o").add("out.txt").add("--threads=8").add("--ratio").add("0.5")
+			.add("--mode").add("fast").add("--no-color").add("file1").add("file2");
+		run("small schema (10 options)", om, line, 20000);
+		runStatic("small static schema", line, 20000);
+	}
+
+	{
+		clipp::OptionManager om;
+		defineLarge(om, 500);
+		CommandLine line;
+		line.add("-v").add("--input").add("in.txt").add("--threads=8");
+		for(int i = 0; i < 490; i += 25) {
+			char name[64];
+			sprintf(name, "--generated-option-number-%d", i);
+			line.add(name);
+			if(i % 3 == 0) {
+				line.add("value");
+			}
+		}
+		line.add("file1");
+		run("large schema (500 options)", om, line, 5000);
+	}
+
+	{
+		clipp::OptionManager om;
+		const char* shorts = "abcdef";
+		for(const char* c = shorts; *c != '\0'; c++) {
+			om.option(string(1, *c)).multiple();
+		}
+		CommandLine line;
+		line.add("-abcdef", 100);
+		run("short clusters (100 x -abcdef)", om, line, 2000);
+	}
+
+	{
+		clipp::OptionManager om;
+		defineSmall(om);
+		CommandLine line;
+		line.add("--define=NAME=value", 100);
+		run("--key=value (100 times)", om, line, 2000);
+	}
+
+	{
+		clipp::OptionManager om;
+		defineSmall(om);
+		CommandLine line;
+		line.add("--verbose", 1000);
+		run("multiple() (1000 x --verbose)", om, line, 500);
+	}
+
+	{
+		clipp::OptionManager om;
+		defineSmall(om);
+		CommandLine line;
+		line.add("-v").add("positional-argument", 10000);
+		run("positional (10000 arguments)", om, line, 200);
+	}
+
+	if(selected("help")) {
+		clipp::OptionManager om;
+		defineLarge(om, 500);
+		om.credits("parse-suite");
+		om.usage("parse-suite [options] files...");
+		const int iterations = 200;
+		size_t length = om.description().length();
+		bench::AllocCounter before = bench::allocSnapshot();
+		double start = now();
+		for(int i = 0; i < iterations; i++) {
+			length += om.description().length();
+		}
+		report("help (description(), 500 opts)", iterations, now() - start, before, "call");
+
+		// La ayuda ajustada a 80 columnas, en un buffer del que llama.
+		std::vector<char> buffer(om.help(NULL, 0, 80) + 1);
+		before = bench::allocSnapshot();
+		start = now();
+		for(int i = 0; i < iterations; i++) {
+			length += om.help(&buffer[0], buffer.size(), 80);
+		}
+		report("help (help(buffer, 80), 500 opts)", iterations, now() - start, before, "call");
+
+		// Cada cambio en las definiciones obliga a componerla otra vez.
+		clipp::OptionDefinition& changing = om.option("changing");
+		before = bench::allocSnapshot();
+		start = now();
+		for(int i = 0; i < iterations; i++) {
+			changing.description(i % 2 == 0 ? "Changing description." : "Another description.");
+			length += om.help(&buffer[0], buffer.size(), 80);
+		}
+		report("help (re-layout, 500 opts)", iterations, now() - start, before, "call");
+		if(length == 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
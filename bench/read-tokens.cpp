@@ -0,0 +1,134 @@
+/*
+ * read-tokens.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Lectura de los elementos de la línea de comandos de un descriptor (como
+ * "find -print0 | programa") comparada con leer todo el fichero y montar un
+ * "argv" con él. Se genera un fichero de N MiB (128 por defecto, o el
+ * primer argumento) con nombres de fichero separados por '\0' y se muestra
+ * la velocidad y la memoria anónima que ha hecho falta en cada caso.
+ */
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Devuelve un valor en KiB de /proc/self/status ("RssAnon"...).
+ */
+static long
+statusKiB(const char* field) {
+	FILE* status = fopen("/proc/self/status", "r");
+	if(status == NULL) {
+		return 0;
+	}
+	char line[256];
+	long value = 0;
+	size_t length = strlen(field);
+	while(fgets(line, sizeof(line), status) != NULL) {
+		if(strncmp(line, field, length) == 0 && line[length] == ':') {
+			value = atol(line + length + 1);
+			break;
+		}
+	}
+	fclose(status);
+	return value;
+}
+
+static unsigned long	gLength = 0;
+
+static int
+onArgument(const clipp::StringRef argument, int) {
+	gLength += argument.length();
+	return 0;
+}
+
+static void
+report(const char* name, double elapsed, long size, long anon, int arguments) {
+	printf("%-30s %10.1f MiB/s %10.1f MiB anonymous %10d arguments\n", name,
+			(size / (1024.0 * 1024.0)) / (elapsed / 1e9), anon / 1024.0, arguments);
+}
+
+int
+main(int argc, char** argv) {
+	long mib = (argc > 1 ? atol(argv[1]) : 128);
+	const char* path = "/tmp/clipp-bench.tokens";
+
+	FILE* out = fopen(path, "w");
+	if(out == NULL) {
+		perror(path);
+		return 1;
+	}
+	long size = 0;
+	for(long i = 0; size < mib * 1024 * 1024; i++) {
+		size += fprintf(out, "./some/directory/source-file-number-%ld.c%c", i, '\0');
+	}
+	fclose(out);
+
+	char* line[] = { const_cast<char*>("read-tokens"), const_cast<char*>("-v") };
+
+	{
+		// Todo a memoria y un "argv" con todos los elementos.
+		clipp::OptionManager om;
+		om.option("verbose", 'v').alias("v");
+		clipp::ParseResult result;
+		long before = statusKiB("RssAnon");
+		double start = now();
+		int fd = open(path, O_RDONLY);
+		string data;
+		char buffer[64 * 1024];
+		ssize_t bytes;
+		while((bytes = read(fd, buffer, sizeof(buffer))) > 0) {
+			data.append(buffer, bytes);
+		}
+		close(fd);
+		vector<char*> args(line, line + 2);
+		for(size_t pos = 0; pos < data.size(); pos = data.find('\0', pos) + 1) {
+			args.push_back(&data[pos]);
+		}
+		om.process(args.size(), &args[0], result);
+		double elapsed = now() - start;
+		report("argv built from the file", elapsed, size, statusKiB("RssAnon") - before, result.countArguments() - 1);
+	}
+
+	{
+		// Elementos leídos por bloques y argumentos sin guardar.
+		clipp::OptionManager om;
+		om.option("verbose", 'v').alias("v");
+		om.streamArguments(onArgument);
+		clipp::ParseResult result;
+		long before = statusKiB("RssAnon");
+		double start = now();
+		int fd = open(path, O_RDONLY);
+		om.process(2, line, fd, '\0', result);
+		close(fd);
+		double elapsed = now() - start;
+		report("process(fd) + streamArguments", elapsed, size, statusKiB("RssAnon") - before, result.countArguments() - 1);
+	}
+
+	remove(path);
+	return gLength > 0 ? 0 : 1;
+}
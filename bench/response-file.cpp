@@ -0,0 +1,107 @@
+/*
+ * response-file.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Análisis de un fichero de respuestas grande ("@fichero"). Se genera un
+ * fichero de N MiB (128 por defecto, o el primer argumento) con opciones
+ * "-D" y argumentos posicionales (uno de cada diez con comillas), y se
+ * muestra el tiempo por elemento y cuánta memoria anónima (la que no es
+ * la proyección del fichero) ha hecho falta: los elementos son referencias
+ * al fichero, así que no se duplica.
+ */
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Devuelve un valor en KiB de /proc/self/status ("RssAnon", "RssFile"...).
+ */
+static long
+statusKiB(const char* field) {
+	FILE* status = fopen("/proc/self/status", "r");
+	if(status == NULL) {
+		return 0;
+	}
+	char line[256];
+	long value = 0;
+	size_t length = strlen(field);
+	while(fgets(line, sizeof(line), status) != NULL) {
+		if(strncmp(line, field, length) == 0 && line[length] == ':') {
+			value = atol(line + length + 1);
+			break;
+		}
+	}
+	fclose(status);
+	return value;
+}
+
+int
+main(int argc, char** argv) {
+	long mib = (argc > 1 ? atol(argv[1]) : 128);
+	const char* path = "/tmp/clipp-bench.rsp";
+
+	// Generamos el fichero.
+	FILE* out = fopen(path, "w");
+	if(out == NULL) {
+		perror(path);
+		return 1;
+	}
+	long size = 0;
+	long written = 0;
+	for(long i = 0; size < mib * 1024 * 1024; i++) {
+		if(i < 1000) {
+			written = fprintf(out, "-DMACRO_NUMBER_%ld=value\n", i);
+		} else if(i % 10 == 0) {
+			written = fprintf(out, "\"quoted source file %ld.c\"\n", i);
+		} else {
+			written = fprintf(out, "source-file-number-%ld.c\n", i);
+		}
+		size += written;
+	}
+	fclose(out);
+
+	clipp::OptionManager om;
+	om.responseFiles(true);
+	om.option("define", 'D').alias("D").multiple().argumentRequired();
+
+	string arg = string("@") + path;
+	char* line[] = { const_cast<char*>("response-file"), const_cast<char*>(arg.c_str()) };
+
+	clipp::ParseStats stats;
+	om.stats(&stats);
+	long anonBefore = statusKiB("RssAnon");
+	double start = now();
+	om.process(2, line);
+	double elapsed = now() - start;
+	long anonAfter = statusKiB("RssAnon");
+
+	unsigned long tokens = stats.tokens();
+	printf("%-30s %10.1f MiB\n", "response file", size / (1024.0 * 1024.0));
+	printf("%-30s %10lu\n", "tokens", tokens);
+	printf("%-30s %10.1f ms (%.1f ns/token)\n", "parse", elapsed / 1e6, elapsed / tokens);
+	printf("%-30s %10.1f MiB (%.1f bytes/token)\n", "anonymous memory", (anonAfter - anonBefore) / 1024.0, (anonAfter - anonBefore) * 1024.0 / tokens);
+	printf("%-30s %10.1f MiB\n", "mapped file resident", statusKiB("RssFile") / 1024.0);
+
+	remove(path);	// La proyección sigue siendo válida hasta el siguiente análisis.
+	return om.countArguments() > 1 ? 0 : 1;
+}
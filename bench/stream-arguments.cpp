@@ -0,0 +1,107 @@
+/*
+ * stream-arguments.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Compara guardar los argumentos posicionales con pasarlos según se
+ * analizan (streamArguments()) en una línea de comandos con N argumentos
+ * (2000000 por defecto, o el primer argumento). Se muestra el tiempo por
+ * argumento y la memoria anónima que ha hecho falta para el análisis.
+ */
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Devuelve un valor en KiB de /proc/self/status ("RssAnon"...).
+ */
+static long
+statusKiB(const char* field) {
+	FILE* status = fopen("/proc/self/status", "r");
+	if(status == NULL) {
+		return 0;
+	}
+	char line[256];
+	long value = 0;
+	size_t length = strlen(field);
+	while(fgets(line, sizeof(line), status) != NULL) {
+		if(strncmp(line, field, length) == 0 && line[length] == ':') {
+			value = atol(line + length + 1);
+			break;
+		}
+	}
+	fclose(status);
+	return value;
+}
+
+static unsigned long	gLength = 0;
+
+static int
+onArgument(const clipp::StringRef argument, int) {
+	gLength += argument.length();
+	return 0;
+}
+
+static void
+run(const char* name, clipp::OptionManager& om, vector<char*>& argv) {
+	clipp::ParseResult result;
+	long before = statusKiB("RssAnon");
+	double start = now();
+	om.process(argv.size(), &argv[0], result);
+	double elapsed = now() - start;
+	long after = statusKiB("RssAnon");
+	printf("%-30s %10.1f ns/arg %10.1f MiB %10d arguments\n", name, elapsed / argv.size(),
+			(after - before) / 1024.0, result.countArguments() - 1);
+}
+
+int
+main(int argc, char** argv) {
+	long count = (argc > 1 ? atol(argv[1]) : 2000000);
+
+	vector<string> storage;
+	storage.reserve(count);
+	vector<char*> line;
+	line.push_back(const_cast<char*>("stream-arguments"));
+	line.push_back(const_cast<char*>("-v"));
+	for(long i = 0; i < count; i++) {
+		char name[64];
+		sprintf(name, "file-%ld.txt", i);
+		storage.push_back(name);
+		line.push_back(const_cast<char*>(storage.back().c_str()));
+	}
+
+	{
+		clipp::OptionManager om;
+		om.option("verbose", 'v').alias("v");
+		run("stored arguments", om, line);
+	}
+
+	{
+		clipp::OptionManager om;
+		om.option("verbose", 'v').alias("v");
+		om.streamArguments(onArgument);
+		run("streamed arguments", om, line);
+	}
+
+	return gLength > 0 ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+/*
+ * subcommands.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "AllocCounter.hpp"
+
+/**
+ * Coste de arrancar una herramienta con 40 subcomandos de 75 opciones cada
+ * uno (3000 opciones) y analizar "tool build --build-option-3 value file":
+ * todas las opciones en un solo OptionManager, los subcomandos creados al
+ * principio y los subcomandos creados sólo cuando se eligen. Se mide cada
+ * invocación completa (definiciones, análisis y destrucción).
+ */
+
+static const int	Subcommands = 40;
+static const int	OptionsPerSubcommand = 75;
+static const int	Iterations = 200;
+
+static const char*	gNames[Subcommands];
+static string		gNameStorage[Subcommands];
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Crea las opciones de un subcomando (con el nombre como prefijo para que
+ * también quepan todas en un solo OptionManager).
+ */
+static void
+define(clipp::OptionManager& om, const string& prefix) {
+	for(int i = 0; i < OptionsPerSubcommand; i++) {
+		ostringstream name;
+		name << prefix << "-option-" << i;
+		clipp::OptionDefinition& od = om.option(name.str(), i);
+		if(i % 3 == 0) {
+			od.argumentRequired().description("An option with a required argument.");
+		} else {
+			od.description("A flag.");
+		}
+	}
+}
+
+/**
+ * Una función por subcomando (el nombre sale de la función).
+ */
+template <int N>
+static void
+factory(clipp::OptionManager& om) {
+	define(om, gNames[N]);
+}
+
+typedef void (*Factory)(clipp::OptionManager&);
+
+template <int N>
+struct Factories {
+	static void fill(Factory* table) {
+		table[N] = factory<N>;
+		Factories<N - 1>::fill(table);
+	}
+};
+
+template <>
+struct Factories<0> {
+	static void fill(Factory* table) {
+		table[0] = factory<0>;
+	}
+};
+
+static Factory	gFactories[Subcommands];
+
+static void
+report(const char* name, double elapsed, const bench::AllocCounter& before, const bench::AllocCounter& after) {
+	printf("%-28s %10.1f us/invocation %8lu allocations %10.1f KiB\n", name, elapsed / 1e3 / Iterations,
+			(after.allocations - before.allocations) / Iterations, (after.bytes - before.bytes) / 1024.0 / Iterations);
+}
+
+int
+main() {
+	for(int i = 0; i < Subcommands; i++) {
+		gNameStorage[i] = (i == 0 ? string("build") : "command-" + clipp::StringFrom<int>(i));
+		gNames[i] = gNameStorage[i].c_str();
+	}
+	Factories<Subcommands - 1>::fill(gFactories);
+
+	const char* line[] = { "tool", "build", "--build-option-3", "value", "file" };
+	const char* flat[] = { "tool", "--build-option-3", "value", "file" };
+	int ok = 0;
+
+	{
+		bench::AllocCounter before = bench::allocSnapshot();
+		double start = now();
+		for(int n = 0; n < Iterations; n++) {
+			clipp::OptionManager om;
+			for(int i = 0; i < Subcommands; i++) {
+				define(om, gNames[i]);
+			}
+			om.process(4, const_cast<char**>(flat));
+			ok += om.hasOption("build-option-3");
+		}
+		report("single OptionManager", now() - start, before, bench::allocSnapshot());
+	}
+
+	{
+		bench::AllocCounter before = bench::allocSnapshot();
+		double start = now();
+		for(int n = 0; n < Iterations; n++) {
+			clipp::OptionManager om;
+			for(int i = 0; i < Subcommands; i++) {
+				om.subcommand(gNames[i], gFactories[i]);
+				om.subcommand(gNames[i]);	// Se crea ya.
+			}
+			om.process(5, const_cast<char**>(line));
+			ok += om.subcommand(om.selectedSubcommand()).hasOption("build-option-3");
+		}
+		report("eager subcommands", now() - start, before, bench::allocSnapshot());
+	}
+
+	{
+		bench::AllocCounter before = bench::allocSnapshot();
+		double start = now();
+		for(int n = 0; n < Iterations; n++) {
+			clipp::OptionManager om;
+			for(int i = 0; i < Subcommands; i++) {
+				om.subcommand(gNames[i], gFactories[i]);
+			}
+			om.process(5, const_cast<char**>(line));
+			ok += om.subcommand(om.selectedSubcommand()).hasOption("build-option-3");
+		}
+		report("lazy subcommands", now() - start, before, bench::allocSnapshot());
+	}
+
+	return ok == 3 * Iterations ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+/*
+ * suggestions.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Coste de las sugerencias de "did you mean" en un esquema con miles de
+ * opciones: lo que añaden a compilar el esquema y lo que tarda una opción
+ * mal escrita en lanzar su excepción, comparado con calcular la distancia de
+ * edición a todos los nombres.
+ */
+
+static const int	Options = 5000;
+static const int	Compilations = 50;
+static const int	Typos = 2000;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static const string
+name(int i) {
+	const char* words[] = { "cache", "color", "depth", "format", "level", "limit", "output", "path", "retry", "timeout" };
+	ostringstream out;
+	out << words[i % 10] << "-" << words[(i / 10) % 10] << "-" << i;
+	return out.str();
+}
+
+static void
+define(clipp::OptionManager& om) {
+	for(int i = 0; i < Options; i++) {
+		om.option(name(i), i).description("An option.");
+	}
+}
+
+static size_t
+distance(const string& a, const string& b) {
+	vector<size_t> previous(b.length() + 1), current(b.length() + 1);
+	for(size_t j = 0; j <= b.length(); j++) {
+		previous[j] = j;
+	}
+	for(size_t i = 1; i <= a.length(); i++) {
+		current[0] = i;
+		for(size_t j = 1; j <= b.length(); j++) {
+			current[j] = min(min(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1));
+		}
+		previous.swap(current);
+	}
+	return previous[b.length()];
+}
+
+int
+main() {
+	size_t found = 0;
+	for(unsigned int suggestions = 0; suggestions <= 3; suggestions += 3) {
+		double start = now();
+		for(int n = 0; n < Compilations; n++) {
+			clipp::OptionManager om;
+			om.suggestions(suggestions);
+			define(om);
+			found += &om.compile() != NULL;
+		}
+		printf("define + compile, %u suggestions %10.1f us\n", suggestions, (now() - start) / 1e3 / Compilations);
+	}
+
+	clipp::OptionManager om;
+	define(om);
+	vector<string> typos;
+	for(int i = 0; i < Typos; i++) {
+		string typo = name((i * 7919) % Options);
+		std::swap(typo[1], typo[2]);
+		typos.push_back("--" + typo);
+	}
+
+	{
+		double start = now();
+		for(int i = 0; i < Typos; i++) {
+			char* argv[] = { const_cast<char*>("suggestions"), const_cast<char*>(typos[i].c_str()) };
+			try {
+				om.process(2, argv);
+			} catch(clipp::error::InvalidOption& e) {
+				found += e.suggestions().size();
+			}
+		}
+		printf("%-34s %10.1f us/typo\n", "indexed suggestions", (now() - start) / 1e3 / Typos);
+	}
+
+	{
+		double start = now();
+		for(int i = 0; i < Typos / 20; i++) {
+			string typo = typos[i].substr(2);
+			size_t best = typo.length();
+			for(int o = 0; o < Options; o++) {
+				best = min(best, distance(typo, name(o)));
+			}
+			found += best;
+		}
+		printf("%-34s %10.1f us/typo\n", "edit distance to every name", (now() - start) / 1e3 / (Typos / 20));
+	}
+
+	return found > 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/*
+ * threads-throughput.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Mide cuántas líneas de comandos por segundo se analizan con un único
+ * esquema compilado compartido por 1, 2, 4... hilos (hasta el número de
+ * procesadores, o el indicado como primer argumento). Cada hilo usa su
+ * propio ParseResult. Si el esquema no tiene bloqueos ni estado compartido
+ * mutable, el rendimiento crece de forma lineal con el número de hilos.
+ */
+
+static const int	ParsesPerThread	= 200000;
+
+static const char*	gArgs[] = {
+	"prog", "--verbose", "-v", "--input", "a.txt", "--output=b.txt",
+	"--threads", "8", "-q", "--mode", "fast", "file1", "file2"
+};
+
+struct Worker {
+	const clipp::CompiledSchema*	schema;
+	pthread_t						thread;
+};
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void*
+work(void* data) {
+	Worker* worker = static_cast<Worker*>(data);
+	clipp::ParseResult result;
+	int count = sizeof(gArgs) / sizeof(gArgs[0]);
+	for(int i = 0; i < ParsesPerThread; i++) {
+		worker->schema->process(count, const_cast<char**>(gArgs), result);
+	}
+	return NULL;
+}
+
+static double
+run(const clipp::CompiledSchema& schema, int threads) {
+	vector<Worker> workers(threads);
+	double start = now();
+	for(int i = 0; i < threads; i++) {
+		workers[i].schema = &schema;
+		pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+	}
+	for(int i = 0; i < threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+	return (double)threads * ParsesPerThread / (now() - start);
+}
+
+int
+main(int argc, char** argv) {
+
+	clipp::OptionManager om;
+	om.option("verbose").alias("v").multiple().description("Verbose.");
+	om.option("input").argumentRequired().description("Input file.");
+	om.option("output").argumentRequired().description("Output file.");
+	om.option("threads").argumentRequired().typeInteger().description("Threads.");
+	om.option("q").description("Quiet.");
+	om.option("mode").argumentRequired().description("Mode.");
+	om.option("help").exclusive().description("Help.");
+
+	const clipp::CompiledSchema& schema = om.compile();
+
+	int maxThreads = (argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN));
+	if(maxThreads < 1) {
+		maxThreads = 1;
+	}
+
+	double base = 0;
+	for(int threads = 1; threads <= maxThreads; threads *= 2) {
+		double rate = run(schema, threads);
+		if(threads == 1) {
+			base = rate;
+		}
+		printf("%3d threads: %12.0f parses/s  speedup %5.2fx\n", threads, rate, rate / base);
+		if(threads < maxThreads && threads * 2 > maxThreads) {
+			threads = maxThreads / 2;
+		}
+	}
+
+	return 0;
+}
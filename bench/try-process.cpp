@@ -0,0 +1,73 @@
+/*
+ * try-process.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <ctime>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+/**
+ * Coste de las líneas de comandos incorrectas: "process()" con su excepción
+ * (mensaje compuesto, sugerencias y el "throw"/"catch") comparado con
+ * "tryProcess()", que sólo guarda el error, y con una línea correcta.
+ */
+
+static const int	Lines = 200000;
+
+static double
+now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void
+define(clipp::OptionManager& om) {
+	om.option("verbose", 'v').alias("v").description("Verbose output.");
+	om.option("level", 'l').alias("l").typeInteger().argumentRequired().description("Level.");
+	om.option("output", 'o').alias("o").argumentRequired().description("Output file.");
+	om.option("color").argumentRequired().validString("red").validString("blue").description("Color.");
+	om.option("quiet", 'q').alias("q").conflictsWith("verbose").description("Quiet.");
+}
+
+int
+main() {
+	clipp::OptionManager om;
+	define(om);
+	const char* lines[][4] = {
+		{ "try-process", "-v", "--output", "out" },
+		{ "try-process", "-v", "--outptu", "out" },
+		{ "try-process", "-v", "-l", "high" },
+		{ "try-process", "-q", "-v", "out" }
+	};
+	const char* names[] = { "valid", "invalid option", "invalid argument", "conflict" };
+	size_t errors = 0;
+	for(int l = 0; l < 4; l++) {
+		char** argv = const_cast<char**>(lines[l]);
+		double start = now();
+		for(int i = 0; i < Lines; i++) {
+			try {
+				om.process(4, argv);
+			} catch(clipp::error::Exception& e) {
+				errors++;
+			}
+		}
+		double thrown = (now() - start) / Lines;
+		start = now();
+		for(int i = 0; i < Lines; i++) {
+			errors += om.tryProcess(4, argv).error != clipp::OptionManager::ERROR_NONE;
+		}
+		double status = (now() - start) / Lines;
+		printf("%-18s process %8.1f ns/line   tryProcess %8.1f ns/line\n", names[l], thrown, status);
+	}
+	return errors > 0 ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/*
+ * ApproximateIndex.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef APPROXIMATEINDEX_HPP_
+#define APPROXIMATEINDEX_HPP_
+
+#include <algorithm>
+#include <vector>
+
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Índice de bigramas para buscar las claves parecidas a una palabra (las
+ * sugerencias de "¿quisiste decir...?"). Cada clave se parte en pares de
+ * caracteres seguidos (con un marcador al principio y otro al final) y cada
+ * par apunta a las claves que lo tienen. Una búsqueda cuenta los pares que
+ * comparte cada clave con la palabra, descarta las que no pueden estar a la
+ * distancia pedida (cada edición cambia como mucho tres pares) y calcula la
+ * distancia de edición sólo de las que más comparten, hasta un máximo fijo,
+ * así que el tiempo no depende del número de claves sino de cuántas se
+ * parecen. Las claves no se copian: tienen que seguir siendo válidas mientras
+ * se use el índice.
+ */
+template <typename T>
+class ApproximateIndex {
+	public:
+
+		static const size_t		MaxDistance = 3;	/// Distancia de edición máxima de una sugerencia.
+		static const size_t		MaxChecked = 64;	/// Claves de las que se calcula la distancia, como mucho.
+
+	private:
+
+		/**
+		 * Clave candidata en una búsqueda.
+		 */
+		struct Candidate {
+			unsigned int	key;		/// Posición de la clave.
+			unsigned int	score;		/// Bigramas compartidos o distancia.
+		};
+
+		/**
+		 * Ordena por más bigramas compartidos (y por posición).
+		 */
+		struct MoreShared {
+			bool operator () (const Candidate& a, const Candidate& b) const {
+				return a.score != b.score ? a.score > b.score : a.key < b.key;
+			}
+		};
+
+		/**
+		 * Ordena por menor distancia (y por clave).
+		 */
+		struct Closer {
+			const StringRefs* keys;
+			bool operator () (const Candidate& a, const Candidate& b) const {
+				return a.score != b.score ? a.score < b.score : (*keys)[a.key] < (*keys)[b.key];
+			}
+		};
+
+		std::vector<unsigned int>	fOffsets;	/// Inicio de las claves de cada cubo en fPostings.
+		std::vector<unsigned int>	fPostings;	/// Claves de cada cubo, seguidas.
+		StringRefs					fKeys;		/// Claves.
+		std::vector<T>				fValues;	/// Valores (en el orden de fKeys).
+
+		/**
+		 * Devuelve el cubo del bigrama en la posición "i" de la clave con
+		 * los marcadores (0 es el marcador de inicio, length() el del final).
+		 */
+		size_t bucket(const StringRef key, size_t i) const {
+			unsigned int a = (i == 0 ? 1u : static_cast<unsigned char>(key[i - 1]) + 2u);
+			unsigned int b = (i == key.length() ? 0u : static_cast<unsigned char>(key[i]) + 2u);
+			return (((a << 9) ^ b) * 0x9e3779b1u >> 8) & (fOffsets.size() - 2);
+		}
+
+		/**
+		 * Distancia de edición (con transposiciones de caracteres seguidos)
+		 * entre dos cadenas, o "limit + 1" en cuanto se sabe que la supera.
+		 */
+		static size_t distance(const StringRef a, const StringRef b, size_t limit) {
+			std::vector<size_t> before(b.length() + 1), previous(b.length() + 1), current(b.length() + 1);
+			for(size_t j = 0; j <= b.length(); j++) {
+				previous[j] = j;
+			}
+			for(size_t i = 1; i <= a.length(); i++) {
+				current[0] = i;
+				size_t best = current[0];
+				for(size_t j = 1; j <= b.length(); j++) {
+					size_t cost = (a[i - 1] == b[j - 1] ? 0 : 1);
+					current[j] = std::min(std::min(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + cost);
+					if(i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+						current[j] = std::min(current[j], before[j - 2] + 1);
+					}
+					best = std::min(best, current[j]);
+				}
+				if(best > limit) {
+					return limit + 1;
+				}
+				before.swap(previous);
+				previous.swap(current);
+			}
+			return previous[b.length()];
+		}
+
+	public:
+
+		/**
+		 * Construye el índice (dos pasadas por los caracteres de las claves).
+		 *
+		 * @param StringRefs keys Claves.
+		 * @param vector<T> values Valores (en el mismo orden que las claves).
+		 */
+		void build(const StringRefs& keys, const std::vector<T>& values) {
+			fKeys = keys;
+			fValues = values;
+			size_t grams = 0;
+			for(size_t k = 0; k < fKeys.size(); k++) {
+				grams += fKeys[k].length() + 1;
+			}
+			// Un número de cubos potencia de dos (de media, dos bigramas por cubo).
+			size_t buckets = 16;
+			while(buckets < grams / 2) {
+				buckets *= 2;
+			}
+			fOffsets.assign(buckets + 1, 0);
+			fPostings.resize(grams);
+			for(size_t k = 0; k < fKeys.size(); k++) {
+				for(size_t i = 0; i <= fKeys[k].length(); i++) {
+					fOffsets[bucket(fKeys[k], i) + 1]++;
+				}
+			}
+			for(size_t b = 1; b < fOffsets.size(); b++) {
+				fOffsets[b] += fOffsets[b - 1];
+			}
+			std::vector<unsigned int> next(fOffsets.begin(), fOffsets.end() - 1);
+			for(size_t k = 0; k < fKeys.size(); k++) {
+				for(size_t i = 0; i <= fKeys[k].length(); i++) {
+					fPostings[next[bucket(fKeys[k], i)]++] = k;
+				}
+			}
+		}
+
+		/**
+		 * Busca las claves más parecidas a una palabra, de la más cercana a
+		 * la más lejana, con una sola clave por valor. La distancia máxima
+		 * crece con la longitud de la palabra (1 hasta 4 caracteres, 2 hasta
+		 * 8 y 3 a partir de ahí).
+		 *
+		 * @param StringRef word Palabra.
+		 * @param size_t count Número máximo de claves.
+		 * @param StringRefs& keys Dónde se añaden las claves.
+		 * @param vector<T>& values Dónde se añaden sus valores.
+		 * @return size_t Número de claves añadidas.
+		 */
+		size_t find(const StringRef word, size_t count, StringRefs& keys, std::vector<T>& values) const {
+			if(fKeys.empty() || word.length() == 0 || count == 0) {
+				return 0;
+			}
+			size_t limit = (word.length() <= 4 ? 1 : (word.length() <= 8 ? 2 : MaxDistance));
+
+			// Bigramas compartidos con cada clave (sólo las que comparten alguno).
+			std::vector<unsigned int> shared(fKeys.size(), 0);
+			std::vector<unsigned int> touched;
+			for(size_t i = 0; i <= word.length(); i++) {
+				size_t b = bucket(word, i);
+				for(unsigned int p = fOffsets[b]; p < fOffsets[b + 1]; p++) {
+					if(shared[fPostings[p]]++ == 0) {
+						touched.push_back(fPostings[p]);
+					}
+				}
+			}
+			std::vector<Candidate> candidates;
+			for(size_t t = 0; t < touched.size(); t++) {
+				size_t length = fKeys[touched[t]].length();
+				size_t longest = std::max(length, word.length());
+				if(longest - std::min(length, word.length()) > limit) {
+					continue;
+				}
+				if(longest + 1 > 3 * limit && shared[touched[t]] < longest + 1 - 3 * limit) {
+					continue;
+				}
+				Candidate candidate = { touched[t], shared[touched[t]] };
+				candidates.push_back(candidate);
+			}
+			if(candidates.size() > MaxChecked) {
+				std::partial_sort(candidates.begin(), candidates.begin() + MaxChecked, candidates.end(), MoreShared());
+				candidates.resize(MaxChecked);
+			}
+
+			// Distancia de las que quedan.
+			std::vector<Candidate> found;
+			for(size_t c = 0; c < candidates.size(); c++) {
+				size_t d = distance(word, fKeys[candidates[c].key], limit);
+				if(d <= limit) {
+					Candidate candidate = { candidates[c].key, static_cast<unsigned int>(d) };
+					found.push_back(candidate);
+				}
+			}
+			Closer closer = { &fKeys };
+			std::sort(found.begin(), found.end(), closer);
+			size_t added = 0;
+			size_t first = values.size();
+			for(size_t f = 0; f < found.size() && added < count; f++) {
+				const T& value = fValues[found[f].key];
+				if(std::find(values.begin() + first, values.end(), value) == values.end()) {
+					keys.push_back(fKeys[found[f].key]);
+					values.push_back(value);
+					added++;
+				}
+			}
+			return added;
+		}
+
+		/**
+		 * Devuelve el número de claves.
+		 *
+		 * @return size_t Número de claves.
+		 */
+		size_t size() const { return fKeys.size(); }
+};
+
+template <typename T> const size_t ApproximateIndex<T>::MaxDistance;
+template <typename T> const size_t ApproximateIndex<T>::MaxChecked;
+
+}	// namespace clipp
+
+#endif /* APPROXIMATEINDEX_HPP_ */
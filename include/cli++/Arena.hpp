@@ -0,0 +1,236 @@
+/*
+ * Arena.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <cstddef>
+#include <new>
+
+namespace clipp {
+
+/**
+ * Zona de memoria monótona: las reservas sólo avanzan un puntero dentro de
+ * un bloque y no se liberan de una en una; toda la memoria se libera a la
+ * vez con release(). Se usa para todo lo que crea un análisis (opciones,
+ * valores y listas), de modo que al empezar el siguiente análisis basta
+ * con una sola liberación.
+ *
+ * Puede empezar con un buffer del usuario (que no se libera nunca); si se
+ * llena, se reservan bloques del sistema. Al liberar, si hubo que reservar
+ * varios bloques se sustituyen por uno solo con sitio para todo, así que
+ * en un uso repetido (el mismo tipo de análisis una y otra vez) no se
+ * vuelve a reservar memoria del sistema.
+ *
+ * Las reservas grandes (LargeAllocation o más) que no caben en el bloque
+ * actual van en bloques propios que sí se pueden liberar de uno en uno con
+ * deallocate(); así, un contenedor que crece mucho (por ejemplo, los
+ * argumentos de un fichero de respuestas enorme) no deja detrás todas sus
+ * versiones anteriores.
+ *
+ * En la zona sólo se deben crear objetos cuyo destructor no libere memoria
+ * o cuyo destructor se llame explícitamente antes de release().
+ */
+class Arena {
+	private:
+
+		/**
+		 * Cabecera de un bloque reservado del sistema (los datos van
+		 * detrás).
+		 */
+		struct Block {
+			Block*		next;	/// Bloque siguiente.
+			size_t		size;	/// Tamaño de los datos.
+		};
+
+		/**
+		 * Cabecera de un bloque de una reserva grande (los datos van
+		 * detrás).
+		 */
+		struct LargeBlock {
+			LargeBlock*	prev;	/// Bloque anterior.
+			LargeBlock*	next;	/// Bloque siguiente.
+		};
+
+		char*			fBuffer;		/// Buffer del usuario (o NULL).
+		size_t			fBufferSize;	/// Tamaño del buffer del usuario.
+		Block*			fBlocks;		/// Bloques reservados del sistema (el primero es el actual).
+		char*			fCurrent;		/// Primer byte libre.
+		char*			fEnd;			/// Fin de la zona actual.
+		size_t			fBlockSize;		/// Tamaño mínimo de los bloques.
+		size_t			fUsed;			/// Bytes reservados desde la última liberación (sin las reservas grandes).
+		LargeBlock*		fLarge;			/// Bloques de las reservas grandes.
+
+		/**
+		 * Evitamos que esta clase se pueda clonar o asignar.
+		 */
+		Arena(const Arena&);
+		Arena& operator = (const Arena&);
+
+		/**
+		 * Reserva un bloque del sistema y lo hace el actual.
+		 *
+		 * @param size_t size Tamaño mínimo de los datos.
+		 */
+		void			addBlock(size_t size);
+
+		/**
+		 * Libera todos los bloques reservados del sistema.
+		 */
+		void			freeBlocks();
+
+		/**
+		 * Reserva un bloque propio para una reserva grande.
+		 *
+		 * @param size_t size Bytes a reservar.
+		 * @return void* Memoria reservada.
+		 */
+		void*			allocateLarge(size_t size);
+
+		/**
+		 * Libera el bloque de una reserva grande, si lo es.
+		 *
+		 * @param void* memory Memoria reservada.
+		 */
+		void			deallocateLarge(void* memory);
+
+		/**
+		 * Libera todos los bloques de las reservas grandes.
+		 */
+		void			freeLarge();
+
+	public:
+
+		/**
+		 * Tamaño predeterminado de los bloques.
+		 */
+		static const size_t	DefaultBlockSize = 4096;
+
+		/**
+		 * Alineación de todas las reservas.
+		 */
+		static const size_t	Alignment = 2 * sizeof(void*);
+
+		/**
+		 * Tamaño a partir del cual una reserva que no cabe en el bloque actual
+		 * va en un bloque propio.
+		 */
+		static const size_t	LargeAllocation = 64 * 1024;
+
+		/**
+		 * Constructores de la clase.
+		 *
+		 * @param size_t blockSize Tamaño mínimo de los bloques del sistema.
+		 * @param void* buffer Buffer del usuario por el que se empieza (tiene
+		 * que seguir siendo válido mientras exista la zona).
+		 * @param size_t size Tamaño del buffer del usuario.
+		 */
+		Arena(size_t blockSize = DefaultBlockSize);
+		Arena(void* buffer, size_t size, size_t blockSize = DefaultBlockSize);
+
+		/**
+		 * Destructor de la clase. Libera los bloques del sistema.
+		 */
+		virtual			~Arena();
+
+		/**
+		 * Reserva memoria alineada a Alignment.
+		 *
+		 * @param size_t size Bytes a reservar.
+		 * @return void* Memoria reservada.
+		 * @throw std::bad_alloc Si no hay memoria.
+		 */
+		void*			allocate(size_t size) {
+			size_t padding = (Alignment - reinterpret_cast<size_t>(fCurrent) % Alignment) % Alignment;
+			if(fCurrent == NULL || size + padding > static_cast<size_t>(fEnd - fCurrent)) {
+				if(size >= LargeAllocation) {
+					return allocateLarge(size);
+				}
+				addBlock(size);
+				padding = 0;
+			}
+			void* result = fCurrent + padding;
+			fCurrent += padding + size;
+			fUsed += padding + size;
+			return result;
+		}
+
+		/**
+		 * Libera una reserva. Sólo hace algo con las reservas grandes que
+		 * tienen bloque propio; el resto se recupera con release().
+		 *
+		 * @param void* memory Memoria reservada con allocate().
+		 * @param size_t size Bytes que se reservaron.
+		 */
+		void			deallocate(void* memory, size_t size) {
+			if(size >= LargeAllocation && fLarge != NULL) {
+				deallocateLarge(memory);
+			}
+		}
+
+		/**
+		 * Libera toda la memoria reservada de una sola vez. Los objetos
+		 * creados en la zona dejan de ser válidos.
+		 */
+		void			release();
+
+		/**
+		 * Devuelve los bytes reservados desde la última liberación.
+		 *
+		 * @return size_t Bytes reservados.
+		 */
+		size_t			used() const { return fUsed; }
+};
+
+/**
+ * Reservador (allocator) para los contenedores de la STL que toma la
+ * memoria de una Arena. Liberar sólo devuelve las reservas grandes (ver
+ * Arena::deallocate()); el resto se recupera con Arena::release().
+ */
+template <typename T>
+class ArenaAllocator {
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+
+		template <typename U>
+		struct rebind {
+			typedef ArenaAllocator<U>	other;
+		};
+
+		Arena*					fArena;		/// Zona de memoria.
+
+		ArenaAllocator(Arena* arena) : fArena(arena) {}
+
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) : fArena(other.fArena) {}
+
+		pointer					address(reference value) const { return &value; }
+		const_pointer			address(const_reference value) const { return &value; }
+		size_type				max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+
+		pointer					allocate(size_type n, const void* = 0) { return static_cast<pointer>(fArena->allocate(n * sizeof(T))); }
+		void					deallocate(pointer p, size_type n) { fArena->deallocate(p, n * sizeof(T)); }
+
+		void					construct(pointer p, const T& value) { new(p) T(value); }
+		void					destroy(pointer p) { p->~T(); }
+
+		template <typename U>
+		bool					operator == (const ArenaAllocator<U>& other) const { return fArena == other.fArena; }
+		template <typename U>
+		bool					operator != (const ArenaAllocator<U>& other) const { return fArena != other.fArena; }
+};
+
+}	// namespace clipp
+
+#endif /* ARENA_HPP_ */
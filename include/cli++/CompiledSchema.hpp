@@ -0,0 +1,470 @@
+/*
+ * CompiledSchema.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef COMPILEDSCHEMA_HPP_
+#define COMPILEDSCHEMA_HPP_
+
+#include <deque>
+#include <string>
+#include <vector>
+
+using std::string;
+
+#include <cli++/OptionDefinition.hpp>
+#include <cli++/ParseResult.hpp>
+#include <cli++/ParseStats.hpp>
+#include <cli++/ApproximateIndex.hpp>
+#include <cli++/Exceptions.hpp>
+#include <cli++/PatternTable.hpp>
+#include <cli++/PerfectHash.hpp>
+#include <cli++/PrefixTrie.hpp>
+#include <cli++/SlotBits.hpp>
+#include <cli++/StringRef.hpp>
+#include <cli++/Utils.hpp>
+
+namespace clipp {
+
+class OptionManager;
+
+/**
+ * Forma "compilada" y de sólo lectura de las definiciones de un
+ * OptionManager. Contiene las tablas de búsqueda y el analizador de la
+ * línea de comandos; como no tiene ningún estado mutable, varios hilos
+ * pueden usar el mismo esquema a la vez sin bloqueos, cada uno con su
+ * propio ParseResult.
+ *
+ * Se obtiene con OptionManager::compile() y deja de ser válido si se
+ * destruye el OptionManager o se añaden opciones o alias. Las definiciones
+ * no se deben modificar mientras haya hilos analizando.
+ *
+ * Este análisis no actualiza las variables asociadas (var()) ni ejecuta las
+ * funciones (execute(), executeOnArgument()); eso sólo lo hace
+ * OptionManager::process().
+ */
+class CompiledSchema {
+	private:
+
+		typedef std::vector<const OptionDefinition*>		DefinitionList;
+
+		/**
+		 * Número de entradas de la tabla de opciones de un carácter (una por
+		 * cada valor posible de un byte).
+		 */
+		static const int			ShortTableSize = 256;
+
+		typedef PerfectHash<const OptionDefinition*>		DefinitionTable;
+
+		typedef std::vector<SlotWord>						SlotSet;
+
+		/**
+		 * Restricción de una definición: un conjunto de posiciones que
+		 * empieza en fMasks[offset] (y ocupa fWords palabras).
+		 */
+		struct SlotMask {
+			int				slot;		/// Posición de la definición.
+			size_t			offset;		/// Inicio del conjunto en fMasks.
+		};
+
+		typedef std::vector<SlotMask>						SlotMaskList;
+
+		std::deque<string>			fKeys;							/// Nombres y alias (referenciados por las tablas).
+		const OptionDefinition*		fShortTable[ShortTableSize];	/// Definiciones de un carácter, por carácter.
+		DefinitionTable				fLongTable;						/// Definiciones de más de un carácter.
+		DefinitionList				fSlots;							/// Definiciones en orden de inserción.
+		DefinitionList				fVariables;						/// Definiciones con variable (ver OptionDefinition::var()).
+		PerfectHash<int>			fSubcommands;					/// Posición de cada subcomando por su nombre.
+		bool						fAbbreviations;					/// Si se aceptan prefijos de las opciones largas.
+		PrefixTrie<const OptionDefinition*>	fPrefixes;				/// Definiciones de más de un carácter por prefijo (si fAbbreviations).
+		unsigned int				fSuggestions;					/// Sugerencias para una opción inválida.
+		ApproximateIndex<const OptionDefinition*>	fApproximate;	/// Nombres de más de un carácter para sugerir (si fSuggestions).
+		PatternTable<const OptionDefinition*>	fPatterns;			/// Definiciones con un patrón como nombre.
+		const Range<int>*			fArgumentsCount;				/// Número de argumentos posicionales (del OptionManager).
+		bool						fResponseFiles;					/// Si se expanden los ficheros de respuestas ("@fichero").
+		OnArgumentStreamed			fStreamArguments;				/// Función a la que se pasan los argumentos sin guardarlos (o NULL).
+
+		int							fWords;							/// Palabras de cada conjunto de posiciones.
+		SlotSet						fRequired;						/// Opciones obligatorias.
+		SlotSet						fExclusive;						/// Opciones exclusivas.
+		SlotSet						fMasks;							/// Conjuntos de las restricciones (uno tras otro).
+		SlotMaskList				fConflicts;						/// Opciones con las que tiene conflicto cada definición.
+		SlotMaskList				fRequiredIf;					/// Opciones que pasan a ser obligatorias si está cada definición.
+		SlotMaskList				fRequiredIfNot;					/// Opciones de las que tiene que estar alguna si no está cada definición.
+
+		/**
+		 * Evitamos que esta clase se pueda clonar o asignar.
+		 */
+		CompiledSchema(const CompiledSchema&);
+		CompiledSchema& operator = (const CompiledSchema&);
+
+		/**
+		 * Clase que crea los esquemas.
+		 */
+		friend class OptionManager;
+
+		/**
+		 * Constructor de la clase. Compila las definiciones del OptionManager.
+		 *
+		 * @param OptionManager& om Dueño de las definiciones.
+		 */
+		CompiledSchema(const OptionManager& om);
+
+		/**
+		 * Devuelve una definición de opción, o NULL si no existe. Los nombres
+		 * de un carácter se buscan directamente en una tabla y el resto en
+		 * una tabla hash perfecta; no se reserva memoria.
+		 *
+		 * @param StringRef nameOrAlias Nombre o alias de la opción.
+		 * @return OptionDefinicion* Definición de opción o NULL.
+		 */
+		const OptionDefinition*		getOptionDefinition(const StringRef nameOrAlias) const;
+
+		/**
+		 * Añade una restricción con las definiciones de unos nombres (los
+		 * que no existen se ignoran). No se añade si no queda ninguna.
+		 *
+		 * @param SlotMaskList& list Lista de restricciones.
+		 * @param int slot Posición de la definición.
+		 * @param StringSet names Nombres o alias de las opciones.
+		 */
+		void						compileMask(SlotMaskList& list, int slot, const StringSet& names);
+
+		/**
+		 * Busca una definición por su nombre o alias o, si se aceptan
+		 * abreviaturas, por un prefijo de un solo nombre largo.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param StringRef name Nombre, alias o prefijo (sin "--").
+		 * @param StringRef option Opción como se escribió (para el error).
+		 * @param bool& failed Se pone a true si el prefijo es de varias (y
+		 * el error ya se ha guardado).
+		 * @return OptionDefinition* Definición o NULL si no hay.
+		 * @throw clipp::error::AmbiguousOption Si el prefijo es de varias.
+		 */
+		const OptionDefinition*		getLongOptionDefinition(ParseResult& result, const StringRef name, const StringRef option, bool& failed) const;
+
+		/**
+		 * Busca la definición cuyo patrón encaja con un nombre que no es de
+		 * ninguna definición.
+		 *
+		 * @param StringRef name Nombre (sin guiones ni "=argumento").
+		 * @return OptionDefinition* Definición o NULL si no encaja ninguno.
+		 */
+		const OptionDefinition*		getPatternDefinition(const StringRef name) const;
+
+		/**
+		 * Cómo se compone el mensaje de un error (ver describe()). Junto con
+		 * el tipo de error decide qué datos del error se usan.
+		 */
+		enum Reason {
+			ReasonText = -1,			/// El texto ya es el mensaje (de una excepción).
+			ReasonPlain,				/// Sólo el elemento o la definición.
+			ReasonSuggest,				/// Opción inválida, con las parecidas a su nombre.
+			ReasonAssigned,				/// Opción inválida de la forma "--option=argument".
+			ReasonNegated,				/// Opción negada inválida ("--no-option").
+			ReasonPrefix,				/// Abreviatura de varias opciones.
+			ReasonNoArgument,			/// Argumento para una opción que no lleva.
+			ReasonRequiredIf,			/// Obligatoria si está otra (su posición en "other").
+			ReasonRequiredIfNot,		/// Obligatoria si no está ninguna de otras (su máscara en "other").
+			ReasonAtLeast,				/// Menos argumentos que el mínimo (cuántos en "other").
+			ReasonAtMost,				/// Más argumentos que el máximo (cuántos en "other").
+			ReasonProblem = 100			/// Argumento incorrecto (más el OptionDefinition::ArgumentProblem).
+		};
+
+		/**
+		 * Registra un error del análisis. Si los errores no se guardan (ver
+		 * tryProcess()), lanza directamente la excepción; si se guardan, no
+		 * se compone el mensaje: sólo se copian los elementos que no van a
+		 * seguir siendo válidos.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param int error Tipo de error (OptionManager::Error).
+		 * @param int reason Cómo se compone el mensaje (Reason).
+		 * @param int slot Posición de la definición (o -1).
+		 * @param StringRef text Elemento de la línea de comandos.
+		 * @param StringRef name Nombre de la opción (sin guiones).
+		 * @param int other Otro dato del mensaje.
+		 * @throw clipp::error::Exception La del error, si no se guardan.
+		 */
+		void						fail(ParseResult& result, int error, int reason, int slot, const StringRef text = StringRef(), const StringRef name = StringRef(), int other = 0) const;
+
+		/**
+		 * Guarda como error una excepción de la librería que se produce
+		 * fuera de las comprobaciones (ficheros de respuestas, lectura,
+		 * variables, funciones...).
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param clipp::error::Exception e Excepción.
+		 */
+		void						fail(ParseResult& result, const clipp::error::Exception& e) const;
+
+		/**
+		 * Lanza la excepción de un error.
+		 *
+		 * @param Failure failure Error.
+		 * @throw clipp::error::Exception Siempre (del tipo del error).
+		 */
+		void						throwFailure(const ParseResult::Failure& failure) const;
+
+		/**
+		 * Compone el mensaje de un error, el mismo que tendría su excepción.
+		 *
+		 * @param Failure failure Error.
+		 * @param string& optionName Dónde se deja el nombre de la opción de
+		 * la excepción.
+		 * @param vector<string>& suggestions Dónde se dejan las opciones
+		 * parecidas (si es una opción inválida).
+		 * @return string Mensaje.
+		 */
+		const string				describe(const ParseResult::Failure& failure, string& optionName, std::vector<string>& suggestions) const;
+
+		/**
+		 * Busca las opciones parecidas a un nombre.
+		 *
+		 * @param StringRef name Nombre de la opción (sin "--" ni "no-").
+		 * @param string marker Lo que va delante de cada sugerencia ("--" o "--no-").
+		 * @param vector<string>& suggestions Dónde se dejan las sugerencias.
+		 * @return string Texto que se añade al mensaje (o vacío si no hay).
+		 */
+		const string				suggest(const StringRef name, const string marker, std::vector<string>& suggestions) const;
+
+		/**
+		 * Comprueba si el primer argumento posicional es un subcomando y, si
+		 * lo es, lo deja elegido en el resultado. Sólo se tienen en cuenta
+		 * los elementos de "argv" (no los de ficheros de respuestas ni los
+		 * de un descriptor).
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param StringRef argument Argumento.
+		 * @return bool True si es un subcomando (y termina el análisis).
+		 */
+		bool						selectSubcommand(ParseResult& result, const StringRef argument) const;
+
+		/**
+		 * Devuelve si un parámetro de la línea de comandos es una opción,
+		 * es decir, comienza por "-" y más caracters o por "--" y más
+		 * caracteres.
+		 *
+		 * @param StringRef option Opción.
+		 * @return bool True si es opción, false en otro caso.
+		 */
+		bool						isOption(const StringRef option) const;
+
+		/**
+		 * Devuelve si una opción es corta (si comienza por "-" y tiene más
+		 * caracteres).
+		 *
+		 * @param StringRef option La opción.
+		 * @return bool True si es corta, false en otro caso.
+		 */
+		bool						isShortOption(const StringRef option) const;
+
+		/**
+		 * Devuelve si una opción es larga (comienza por "--" y tiene más
+		 * caracteres).
+		 *
+		 * @param StringRef option Opción.
+		 * @return bool True si es larga, false en otro caso.
+		 */
+		bool						isLongOption(const StringRef option) const;
+
+		/**
+		 * Devuelve una opción normalizada. Si es corta quita el "-" y si
+		 * es larga quita el "--".
+		 *
+		 * @param StringRef option La opción de la línea de comandos.
+		 * @param bool isShort True para indicar que es corta, false para
+		 * indicar que es larga.
+		 * @return StringRef La opción normalizada (sin copia).
+		 */
+		const StringRef				normalizeOption(const StringRef option, bool isShort = false) const;
+
+		/**
+		 * Procesa una opción corta. Puede obtener más parámetros de la línea
+		 * de comandos del resultado.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param StringRef option La opción.
+		 * @param bool normalize True para normalizar (-a -> a), false para
+		 * no normalizar.
+		 */
+		void						decodeShortOption(ParseResult& result, const StringRef option, bool normalize = true) const;
+
+		/**
+		 * Procesa una opción larga. Puede obtener más parámetros de la línea
+		 * de comandos del resultado.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param StringRef option La opción.
+		 * @param bool normalize True para normalizar (--help -> help), false
+		 * para no normalizar.
+		 */
+		void						decodeLongOption(ParseResult& result, const StringRef option, bool normalize = true) const;
+
+		/**
+		 * Postprocesa una opción, una vez decodificada la cadena de la línea
+		 * de comandos, ya está la definición y se comprueba si es exclusiva,
+		 * etc. y se añade a las opciones.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param OptionDefinition* od Definición de la opción.
+		 * @param StringRef realOption Opción real que llegó en la línea de
+		 * comandos (por si es un alias).
+		 * @param bool isNegated True si la opción es la negada, false en otro
+		 * caso.
+		 * @param StringRef match Elemento que encaja con el patrón de la
+		 * definición (vacío si no es un patrón).
+		 */
+		void						postProcessOption(ParseResult& result, const OptionDefinition* optdef, const StringRef realOption = StringRef(), bool isNegated = false, const StringRef match = StringRef()) const;
+
+		/**
+		 * Añade una opción ya procesada. Si la opción ya existe, añade el
+		 * argumento.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param string OptionDefinition* Definición de la opción.
+		 * @param StringRef argument Argumento (referencia a "argv").
+		 * @param bool True si la opción es la negada, false en otro caso.
+		 * @param StringRef match Elemento que encaja con el patrón de la
+		 * definición (vacío si no es un patrón).
+		 */
+		void						addOption(ParseResult& result, const OptionDefinition* optdef, const StringRef argument = StringRef(), bool isNegated = false, const StringRef match = StringRef()) const;
+
+		/**
+		 * Añade un argumento posicional o, si se pasan según se analizan, lo
+		 * cuenta y se lo pasa a la función.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 * @param StringRef argument Argumento.
+		 * @throw clipp::error::Length Si hay más argumentos que el máximo (sólo
+		 * si se pasan según se analizan; si no, se comprueba al final).
+		 */
+		void						addArgument(ParseResult& result, const StringRef argument) const;
+
+		/**
+		 * Hace el análisis de process() y tryProcess().
+		 *
+		 * @param bool collect True para guardar los errores en vez de lanzarlos.
+		 * @param bool collectAll True para seguir después del primer error.
+		 */
+		void						run(int argc, char** argv, int fd, char delimiter, ParseResult& result, ParseStats* stats, bool collect, bool collectAll) const;
+
+		/**
+		 * Decodifica todos los elementos de la línea de comandos, separando
+		 * las opciones de los argumentos posicionales.
+		 *
+		 * @param ParseResult& result Resultado del análisis en curso.
+		 */
+		void						decode(ParseResult& result) const;
+
+		/**
+		 * Procesa si están todas las opciones que tiene que estar. Las
+		 * restricciones están compiladas como conjuntos de bits, así que
+		 * sólo se combinan con el conjunto de opciones presentes.
+		 *
+		 * @param ParseResult& result Resultado del análisis.
+		 * @throw RequiredOptionException Si hace falta alguna opción.
+		 */
+		void						checkProcessedOptions(ParseResult& result) const;
+
+		/**
+		 * Chequea los conflictos entre opciones.
+		 *
+		 * @param ParseResult& result Resultado del análisis.
+		 */
+		void						checkConflicts(ParseResult& result) const;
+
+		/**
+		 * Procesa los argumentos una vez procesada la línea de comandos,
+		 * es decir, mira a ver si el número de ellos es correcto.
+		 *
+		 * @param ParseResult& result Resultado del análisis.
+		 */
+		void						processArguments(ParseResult& result) const;
+
+	public:
+
+		/**
+		 * Destructor de la clase.
+		 */
+		virtual						~CompiledSchema();
+
+		/**
+		 * Devuelve el número de opciones definidas (sin contar los alias).
+		 *
+		 * @return int Número de opciones definidas.
+		 */
+		int							countDefinitions() const;
+
+		/**
+		 * Procesa una línea de comandos dejando el resultado en "result",
+		 * que se vacía antes de empezar. Se puede llamar desde varios hilos
+		 * a la vez siempre que cada uno use su propio resultado (y sus
+		 * propias estadísticas).
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param ParseResult& result Dónde se deja el resultado.
+		 * @param ParseStats* stats Estadísticas del análisis (se vacían al
+		 * empezar), o NULL para no tomarlas.
+		 */
+		void						process(int argc, char** argv, ParseResult& result, ParseStats* stats = NULL) const;
+
+		/**
+		 * Procesa una línea de comandos que sigue, después de "argv", con
+		 * los elementos que se leen de un descriptor (separados por '\0' o
+		 * por saltos de línea). Se leen por bloques según se analizan, así
+		 * que, si los argumentos posicionales no se guardan (ver
+		 * OptionManager::streamArguments()), la memoria no depende de
+		 * cuánto se lea.
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param int fd Descriptor del que se leen más elementos (o -1).
+		 * @param char delimiter Separador de los elementos ('\0' o '\n').
+		 * @param ParseResult& result Dónde se deja el resultado.
+		 * @param ParseStats* stats Estadísticas del análisis (se vacían al
+		 * empezar), o NULL para no tomarlas.
+		 * @throw clipp::error::Input Si falla la lectura.
+		 */
+		void						process(int argc, char** argv, int fd, char delimiter, ParseResult& result, ParseStats* stats = NULL) const;
+
+		/**
+		 * Procesa una línea de comandos como process(), pero sin lanzar
+		 * excepciones: los errores se guardan en el resultado (ver
+		 * ParseResult::countErrors()) sin componer sus mensajes, que se
+		 * piden después con errorMessage(). Se para en el primer error o,
+		 * con "collectAll", sigue y los guarda todos (de cada opción sólo
+		 * su primer argumento incorrecto). Si hay errores el resultado no
+		 * está completo y no se debe usar.
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param int fd Descriptor del que se leen más elementos (o -1).
+		 * @param char delimiter Separador de los elementos ('\0' o '\n').
+		 * @param ParseResult& result Dónde se dejan el resultado y los errores.
+		 * @param bool collectAll True para guardar todos los errores.
+		 * @param ParseStats* stats Estadísticas del análisis, o NULL.
+		 * @return bool True si no hay errores.
+		 */
+		bool						tryProcess(int argc, char** argv, int fd, char delimiter, ParseResult& result, bool collectAll = false, ParseStats* stats = NULL) const;
+
+		/**
+		 * Compone el mensaje de un error guardado por tryProcess(), el mismo
+		 * que el de la excepción que lanzaría process().
+		 *
+		 * @param ParseResult& result Resultado de tryProcess().
+		 * @param int index Índice del error.
+		 * @return string Mensaje.
+		 * @throw clipp::error::OutOfBounds Si el índice es incorrecto.
+		 */
+		const string				errorMessage(const ParseResult& result, int index) const;
+};
+
+}	// namespace clipp
+
+#endif /* COMPILEDSCHEMA_HPP_ */
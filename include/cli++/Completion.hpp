@@ -0,0 +1,69 @@
+/*
+ * Completion.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef COMPLETION_HPP_
+#define COMPLETION_HPP_
+
+#include <string>
+
+using std::string;
+
+namespace clipp {
+
+/**
+ * Protocolo de autocompletado de la línea de comandos. Los scripts de la
+ * shell ejecutan el programa con
+ *
+ *   programa --__complete <cword> <palabras...>
+ *
+ * donde las palabras son las de la línea que se está escribiendo (la cero
+ * es el programa) y "cword" la posición de la que se completa. El programa
+ * responde con un candidato por línea (ver OptionManager::complete()). Los
+ * scripts los escribe el propio programa con
+ *
+ *   programa --__completion bash|zsh
+ *
+ * y se cargan con "source <(programa --__completion bash)".
+ */
+class Completion {
+	public:
+
+		/**
+		 * Shell para la que se genera el script.
+		 */
+		enum Shell {
+			ShellBash,
+			ShellZsh
+		};
+
+		static const char* const	Request;		/// Primer argumento de una petición de candidatos.
+		static const char* const	ScriptRequest;	/// Primer argumento de una petición del script.
+
+		/**
+		 * Devuelve el script de autocompletado de un programa.
+		 *
+		 * @param Shell shell Shell.
+		 * @param string program Nombre del programa (se usa su nombre sin
+		 * directorio).
+		 * @return string Script.
+		 */
+		static const string			script(Shell shell, const string program);
+
+		/**
+		 * Devuelve la shell de un nombre ("bash" o "zsh").
+		 *
+		 * @param string name Nombre.
+		 * @param Shell& shell Dónde se deja la shell.
+		 * @return bool True si se conoce.
+		 */
+		static bool					shell(const string name, Shell& shell);
+};
+
+}	// namespace clipp
+
+#endif /* COMPLETION_HPP_ */
@@ -0,0 +1,146 @@
+/*
+ * Configuration.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef CONFIGURATION_HPP_
+#define CONFIGURATION_HPP_
+
+#include <map>
+#include <string>
+
+using std::string;
+
+namespace clipp {
+
+/**
+ * Capas de valores de las opciones que no vienen de la línea de comandos:
+ * un fichero de configuración y variables de entorno. Las consulta el
+ * OptionManager (ver OptionManager::value()) con esta prioridad, de menor
+ * a mayor: valor por defecto de la definición, fichero, entorno y línea de
+ * comandos.
+ *
+ * El fichero tiene líneas "clave = valor" (el valor puede ir entre
+ * comillas), comentarios que empiezan por '#' o ';' y secciones "[nombre]",
+ * cuyas claves pasan a ser "nombre.clave". Una clave sin '=' vale "true".
+ * Sólo se lee la primera vez que hace falta un valor suyo, así que si todas
+ * las opciones que se consultan están en la línea de comandos o en el
+ * entorno, no se llega a abrir.
+ *
+ * La variable de entorno de una opción es el prefijo, '_' y el nombre en
+ * mayúsculas, con '-' y '.' cambiados por '_' ("APP" y "dry-run" dan
+ * "APP_DRY_RUN").
+ */
+class Configuration {
+	public:
+
+		/**
+		 * De dónde viene un valor.
+		 */
+		enum Source {
+			SourceNone = 0,			/// No tiene valor.
+			SourceDefault,			/// Valor por defecto de la definición.
+			SourceFile,				/// Fichero de configuración.
+			SourceEnvironment,		/// Variable de entorno.
+			SourceCommandLine		/// Línea de comandos.
+		};
+
+	private:
+
+		typedef std::map<string, string>	ValueMap;
+
+		string				fFile;		/// Ruta del fichero (vacía si no hay).
+		string				fPrefix;	/// Prefijo de las variables de entorno (vacío si no se usan).
+		bool				fLoaded;	/// Si ya se ha leído el fichero.
+		ValueMap			fValues;	/// Valores del fichero por clave.
+
+		/**
+		 * Lee el fichero de configuración. Si falla, no queda leído y se
+		 * vuelve a leer en la siguiente consulta.
+		 *
+		 * @throw clipp::error::Configuration Si no se puede leer o hay una
+		 * línea mal formada.
+		 */
+		void				load();
+
+	public:
+
+		/**
+		 * Constructor de la clase (sin fichero ni prefijo).
+		 */
+		Configuration();
+
+		/**
+		 * Destructor de la clase.
+		 */
+		virtual				~Configuration();
+
+		/**
+		 * Fija y devuelve la ruta del fichero de configuración. Al cambiarla
+		 * se olvidan los valores ya leídos.
+		 *
+		 * @param string path Ruta del fichero (vacía para no usar ninguno).
+		 * @return string Ruta del fichero.
+		 */
+		void				file(const string path);
+		const string&		file() const;
+
+		/**
+		 * Fija y devuelve el prefijo de las variables de entorno.
+		 *
+		 * @param string prefix Prefijo (vacío para no usar el entorno).
+		 * @return string Prefijo.
+		 */
+		void				prefix(const string prefix);
+		const string&		prefix() const;
+
+		/**
+		 * Devuelve si ya se ha leído el fichero de configuración.
+		 *
+		 * @return bool True si ya se ha leído.
+		 */
+		bool				loaded() const;
+
+		/**
+		 * Busca el valor de una clave en el fichero, leyéndolo si todavía no
+		 * se ha leído.
+		 *
+		 * @param string key Clave (nombre de la opción).
+		 * @param string& value Dónde se deja el valor.
+		 * @return bool True si está.
+		 * @throw clipp::error::Configuration Si no se puede leer el fichero.
+		 */
+		bool				fromFile(const string& key, string& value);
+
+		/**
+		 * Busca el valor de una opción en el entorno.
+		 *
+		 * @param string name Nombre de la opción.
+		 * @param string& value Dónde se deja el valor.
+		 * @return bool True si está la variable.
+		 */
+		bool				fromEnvironment(const string& name, string& value) const;
+
+		/**
+		 * Devuelve el nombre de la variable de entorno de una opción.
+		 *
+		 * @param string name Nombre de la opción.
+		 * @return string Nombre de la variable (vacío si no hay prefijo).
+		 */
+		const string		environmentName(const string& name) const;
+
+		/**
+		 * Devuelve el nombre de una capa ("default", "file"...).
+		 *
+		 * @param Source source Capa.
+		 * @return char* Nombre.
+		 */
+		static const char*	sourceName(Source source);
+};
+
+}	// namespace clipp
+
+#endif /* CONFIGURATION_HPP_ */
@@ -0,0 +1,105 @@
+/*
+ * CountingNew.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef COUNTINGNEW_HPP_
+#define COUNTINGNEW_HPP_
+
+#include <cstdlib>
+#include <new>
+
+#include <cli++/ParseStats.hpp>
+
+/**
+ * Reemplaza los operadores globales "new" y "delete" para que las reservas
+ * de memoria hechas durante un análisis con estadísticas se cuenten en
+ * ParseStats. Es opcional y sólo debe incluirse desde un único fichero de
+ * la aplicación. Si la aplicación ya tiene su propio "operator new", basta
+ * con que llame a clipp::ParseStats::allocation().
+ *
+ * Se reemplazan todas las formas (también las "nothrow" y, según el
+ * estándar, las de tamaño y alineamiento), así que todo se reserva con
+ * malloc() y se libera con free(). Para contar las reservas de otra forma,
+ * se define CLIPP_COUNT_ALLOCATION(size) antes de incluir este fichero.
+ */
+
+#ifndef CLIPP_COUNT_ALLOCATION
+#define CLIPP_COUNT_ALLOCATION(size)	clipp::ParseStats::allocation(size)
+#endif
+
+#if __cplusplus >= 201103L
+#define CLIPP_NOTHROW	noexcept
+#else
+#define CLIPP_NOTHROW	throw()
+#endif
+
+namespace clipp {
+
+/**
+ * Reserva memoria para los operadores reemplazados y la cuenta.
+ *
+ * @param size_t size Tamaño.
+ * @param size_t alignment Alineamiento (0 para el de malloc()).
+ * @return void* Memoria o NULL si no hay.
+ */
+inline void*
+CountedAllocate(std::size_t size, std::size_t alignment = 0) {
+	CLIPP_COUNT_ALLOCATION(size);
+	if(size == 0) {
+		size = 1;
+	}
+	if(alignment == 0) {
+		return std::malloc(size);
+	}
+	void* p = NULL;
+	return posix_memalign(&p, alignment, size) == 0 ? p : NULL;
+}
+
+/**
+ * Reserva memoria o lanza std::bad_alloc.
+ */
+inline void*
+CountedAllocateOrThrow(std::size_t size, std::size_t alignment = 0) {
+	void* p = CountedAllocate(size, alignment);
+	if(p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+}	// namespace clipp
+
+void* operator new(std::size_t size) { return clipp::CountedAllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return clipp::CountedAllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) CLIPP_NOTHROW { return clipp::CountedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) CLIPP_NOTHROW { return clipp::CountedAllocate(size); }
+
+void operator delete(void* p) CLIPP_NOTHROW { std::free(p); }
+void operator delete[](void* p) CLIPP_NOTHROW { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) CLIPP_NOTHROW { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) CLIPP_NOTHROW { std::free(p); }
+
+#if __cplusplus >= 201402L
+void operator delete(void* p, std::size_t) CLIPP_NOTHROW { std::free(p); }
+void operator delete[](void* p, std::size_t) CLIPP_NOTHROW { std::free(p); }
+#endif
+
+#if __cplusplus >= 201703L
+void* operator new(std::size_t size, std::align_val_t alignment) { return clipp::CountedAllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return clipp::CountedAllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) CLIPP_NOTHROW { return clipp::CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) CLIPP_NOTHROW { return clipp::CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* p, std::align_val_t) CLIPP_NOTHROW { std::free(p); }
+void operator delete[](void* p, std::align_val_t) CLIPP_NOTHROW { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) CLIPP_NOTHROW { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) CLIPP_NOTHROW { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) CLIPP_NOTHROW { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) CLIPP_NOTHROW { std::free(p); }
+#endif
+
+#endif /* COUNTINGNEW_HPP_ */
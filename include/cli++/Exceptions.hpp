@@ -11,6 +11,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 using std::runtime_error;
 using std::length_error;
@@ -75,9 +76,21 @@ class OptionDefinition : public Exception {
  * Excepción que se lanza cuando una opción es inválida.
  */
 class InvalidOption : public Exception {
+	protected:
+		std::vector<string>	_suggestions;	/// Opciones parecidas (ver OptionManager::suggestions()).
 	public:
-		InvalidOption(const string msg) : Exception(msg) {}
-		InvalidOption(const string msg, const string optionName) : Exception(msg,optionName) {}
+		InvalidOption(const string msg) : Exception(msg), _suggestions() {}
+		InvalidOption(const string msg, const string optionName) : Exception(msg,optionName), _suggestions() {}
+		InvalidOption(const string msg, const string optionName, const std::vector<string>& suggestions) : Exception(msg,optionName), _suggestions(suggestions) {}
+		virtual ~InvalidOption() throw() {}
+
+		/**
+		 * Devuelve las opciones parecidas a la inválida, de la más a la menos
+		 * parecida (con "--"), que ya van en el mensaje.
+		 *
+		 * @return vector<string> Opciones.
+		 */
+		const std::vector<string>&	suggestions() const { return _suggestions; }
 };
 
 /**
@@ -180,6 +193,36 @@ class Unprocessed : public Exception {
 		Unprocessed(const string msg, const string optionName) : Exception(msg,optionName) {}
 };
 
+/**
+ * Excepción que se lanza cuando no se puede leer un fichero de respuestas
+ * ("@fichero") o hay un error en él.
+ */
+class ResponseFile : public Exception {
+	public:
+		ResponseFile(const string msg) : Exception(msg) {}
+		ResponseFile(const string msg, const string optionName) : Exception(msg,optionName) {}
+};
+
+/**
+ * Excepción que se lanza cuando no se pueden leer los elementos de la línea
+ * de comandos de un descriptor.
+ */
+class Input : public Exception {
+	public:
+		Input(const string msg) : Exception(msg) {}
+		Input(const string msg, const string optionName) : Exception(msg,optionName) {}
+};
+
+/**
+ * Excepción que se lanza cuando no se puede leer el fichero de
+ * configuración o hay una línea mal formada.
+ */
+class Configuration : public Exception {
+	public:
+		Configuration(const string msg) : Exception(msg) {}
+		Configuration(const string msg, const string optionName) : Exception(msg,optionName) {}
+};
+
 }	// namespace clipp::error
 
 }	// namespace clipp
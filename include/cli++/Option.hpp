@@ -11,10 +11,15 @@
 
 #include <string>
 #include <vector>
+#include <list>
 
 using std::string;
 
 #include <cli++/Utils.hpp>
+#include <cli++/Arena.hpp>
+#include <cli++/SmallVector.hpp>
+#include <cli++/StringRef.hpp>
+#include <cli++/ValueParser.hpp>
 
 namespace clipp {
 
@@ -23,11 +28,24 @@ namespace clipp {
  */
 typedef std::vector<string>	Strings;
 
+/**
+ * Valores de los argumentos de una opción (el primero se guarda en línea).
+ * Son referencias a los elementos de "argv" o a fOwnedValues.
+ */
+typedef SmallVector<StringRef>	OptionValues;
+
+/**
+ * Valores de los argumentos ya convertidos al tipo de la opción (en el
+ * mismo orden que OptionValues).
+ */
+typedef SmallVector<TypedValue>	TypedValues;
+
 /**
  * Definiciónes de clases para que puedan ser usadas aquí.
  */
 class OptionDefinition;
 class OptionManager;
+class CompiledSchema;
 
 /**
  * Esta clase mantiene el nombre de la opción y los posibles valores de los
@@ -36,10 +54,13 @@ class OptionManager;
 class Option {
 	private:
 		int					fId;			/// Id numérico de la opción.
-		string				fName;			/// Nombre de la opción.
+		string				fName;			/// Nombre de la opción (vacío si se toma de fOptdef).
 		bool				fIsNegated;		/// Indica si la opción es la negada (--option -> --no-option).
 		int					fOccurrences;	/// Número de veces que aparece.
-		Strings				fValues;		/// Valores de los argumentos, si hay.
+		OptionValues		fValues;		/// Valores de los argumentos, si hay.
+		OptionValues		fMatches;		/// Elementos que encajan con el patrón de la definición, si es uno.
+		TypedValues			fTypedValues;	/// Valores convertidos al comprobar los argumentos.
+		std::list<string>	fOwnedValues;	/// Copias de los valores que no vienen de "argv" (add() y set()).
 		OptionDefinition*	fOptdef;		/// Definición de opción donde está esta opción.
 
 		/**
@@ -56,12 +77,59 @@ class Option {
 		 * Clase que puede acceder a las propiedades internas de esta clase.
 		 */
 		friend class OptionManager;
+		friend class CompiledSchema;
+		friend class ParseResult;
+
+		/**
+		 * Constructor para el análisis: la opción no copia el nombre (lo
+		 * toma de la definición) y sus valores se guardan en "arena".
+		 *
+		 * @param OptionDefinition* optdef Definición de la opción.
+		 * @param Arena* arena Zona de memoria del análisis.
+		 */
+		Option(const OptionDefinition* optdef, Arena* arena);
 
 		/**
 		 * Actualiza la variable.
 		 */
 		void					updateVariable();
 
+		/**
+		 * Añade un valor de un argumento sin copiarlo (sólo para el
+		 * OptionManager, que pasa referencias a "argv").
+		 *
+		 * @param StringRef value Valor del argumento.
+		 * @throw clipp::error::Length Si se supera el número máximo de valores.
+		 */
+		void					append(const StringRef value);
+
+		/**
+		 * Chequea los argumentos como checkArguments(), pero sin lanzar
+		 * excepciones: se para en el primero que no es correcto.
+		 *
+		 * @param size_t index Donde se deja el índice del argumento incorrecto.
+		 * @return int Problema (OptionDefinition::ArgumentProblem) o 0 si
+		 * todos son correctos.
+		 */
+		int						checkArguments(size_t& index);
+
+		/**
+		 * Devuelve el valor ya convertido de un argumento si está comprobado
+		 * y el tipo pedido corresponde al de la opción. La versión genérica
+		 * siempre devuelve false (el valor se convierte desde la cadena).
+		 *
+		 * @param int index Índice del argumento.
+		 * @param T value Donde se deja el valor.
+		 * @return bool True si se ha devuelto el valor, false en otro caso.
+		 */
+		template <typename T>
+		bool					typedAt(unsigned short, T&) const { return false; }
+		bool					typedAt(unsigned short index, int& value) const;
+		bool					typedAt(unsigned short index, long& value) const;
+		bool					typedAt(unsigned short index, float& value) const;
+		bool					typedAt(unsigned short index, double& value) const;
+		bool					typedAt(unsigned short index, bool& value) const;
+
 	public:
 
 		/**
@@ -123,6 +191,7 @@ class Option {
 		 * Añade un valor de un argumento.
 		 *
 		 * @param string value Valor del argumento.
+		 * @throw clipp::error::Length Si se supera el número máximo de valores.
 		 */
 		void					add(const string value);
 
@@ -153,14 +222,21 @@ class Option {
 
 		/**
 		 * Devuelve el valor de un argumento según su índice convertido
-		 * al tipo indicado en la plantilla (template).
+		 * al tipo indicado en la plantilla (template). Si el argumento ya
+		 * está comprobado y el tipo coincide con el de la opción (int o long
+		 * para TypeInteger, float o double para TypeFloat y bool para
+		 * TypeBoolean) se devuelve el valor ya convertido sin volver a
+		 * analizar la cadena.
 		 *
 		 * @param T default_value Valor por defecto.
 		 * @param int index Índice del argumento.
 		 * @return T Valor del argumento convertido al tipo indicado.
 		 */
 		template <typename T>
-		const T					getAt(T default_value, unsigned short index) const { return StringTo<T>(getAt(index), default_value); }
+		const T					getAt(T default_value, unsigned short index) const {
+			T value;
+			return (typedAt(index, value) ? value : StringTo<T>(getAt(index), default_value));
+		}
 
 		/**
 		 * Devuelve el valor de un argumento en el índice cero convertido
@@ -170,7 +246,18 @@ class Option {
 		 * @return T Valor del argumento convertido al tipo indicado.
 		 */
 		template <typename T>
-		const T					get(T default_value) const { return StringTo<T>(get(), default_value); }
+		const T					get(T default_value) const { return getAt<T>(default_value, 0); }
+
+		/**
+		 * Devuelve la posición del valor de un argumento dentro de las
+		 * cadenas válidas de su opción (OptionDefinition::validStrings(), en
+		 * orden alfabético), útil para usar el argumento como un "enum".
+		 *
+		 * @param int index Índice del argumento.
+		 * @return int Posición en las cadenas válidas o -1 si la opción no
+		 * tiene cadenas válidas o el argumento no está comprobado.
+		 */
+		int						validStringIndex(unsigned short index = 0) const;
 
 		/**
 		 * Devuelve el número de argumentos.
@@ -179,10 +266,30 @@ class Option {
 		 */
 		int						countValues() const;
 
+		/**
+		 * Devuelve el elemento de la línea de comandos que ha encajado con
+		 * el patrón de la definición en una aparición (con guiones y, si lo
+		 * tiene, con "=argumento"), para las opciones con un patrón como
+		 * nombre (ver OptionDefinition::isPattern()).
+		 *
+		 * @param int index Índice de la aparición.
+		 * @return string Elemento.
+		 * @throw clipp::error::OutOfBounds Si no existe.
+		 */
+		const string			matchAt(unsigned short index) const;
+
+		/**
+		 * Devuelve el número de elementos que han encajado con el patrón.
+		 *
+		 * @return int Número de elementos.
+		 */
+		int						countMatches() const;
+
 		/**
 		 * Chequea que los argumentos sean correctos. Esta función hace uso
 		 * de _optdef para saber qué tipo de parámetros tiene y cómo
-		 * chequearlos.
+		 * chequearlos. Cada argumento se convierte una sola vez y el valor
+		 * convertido se guarda para no volver a hacerlo.
 		 */
 		void					checkArguments();
 };
@@ -12,6 +12,9 @@
 #include <list>
 #include <set>
 
+#include <cli++/StringRef.hpp>
+#include <cli++/ValueParser.hpp>
+
 namespace clipp {
 
 /**
@@ -23,6 +26,7 @@ typedef std::set<string>		StringSet;
  * Declaración de la clase que contiene estas clases.
  */
 class OptionManager;
+class CompiledSchema;
 class Option;
 
 /**
@@ -53,6 +57,7 @@ class OptionDefinition {
 	private:
 		OptionManager*		fOwner;				/// Puntero al OpcionManager que tiene esta instancia.
 		int					fId;				/// El id numérico de la opción.
+		int					fSlot;				/// Posición en el OptionManager (o -1 si no está en ninguno).
 		string				fName;				/// Nombre de la opción.
 		OptionType			fType;				/// Tipo de la opción.
 		string				fDescription;		/// Descripción de la opción.
@@ -66,6 +71,8 @@ class OptionDefinition {
 		string				fAlias;				/// Si tiene un alias (sólo uno).
 		StringSet			fValidStrings;		/// Cadenas válidas para su argumento.
 		StringSet			fConflictsWith;		/// Opciones con las que tiene conflicto (no pueden estar juntas).
+		StringSet			fRequiredIf;		/// Opciones que, si están, hacen que esta sea obligatoria.
+		StringSet			fRequiredIfNot;		/// Opciones que, si no está ninguna, hacen que esta sea obligatoria.
 		bool				fHasMinValue;		/// Si tiene valor mínimo si es numérico el argumento.
 		float				fMinValue;			/// Valor mínimo.
 		bool				fHasMaxValue;		/// Si tiene valor máximo.
@@ -79,6 +86,16 @@ class OptionDefinition {
 		 * Clase amiga que puede acceder a las propiedades de esta clase.
 		 */
 		friend class		OptionManager;
+		friend class		CompiledSchema;
+		friend class		ParseResult;
+
+		/**
+		 * Avisa al OptionManager de que la definición ha cambiado algo que
+		 * está compilado en su esquema (obligatoriedad, exclusividad y
+		 * relaciones con otras opciones) o en su ayuda (descripción, tipo
+		 * y argumento).
+		 */
+		void				changed();
 
 		/**
 		 * Si la opción es exclusiva no puede ser múltiple ni obligatoria.
@@ -94,20 +111,87 @@ class OptionDefinition {
 		friend class		Option;
 
 		/**
-		 * Comprueba el tipo de argumento.
+		 * Problema de un argumento (el mensaje sólo se compone si se pide,
+		 * ver argumentMessage()).
+		 */
+		enum ArgumentProblem {
+			ArgumentOk,
+			ArgumentNotInteger,
+			ArgumentNotFloat,
+			ArgumentNotBoolean,
+			ArgumentNotValid,
+			ArgumentTooBig,
+			ArgumentTooSmall
+		};
+
+		/**
+		 * Comprueba el tipo del argumento y lo convierte, sin lanzar
+		 * excepciones.
+		 *
+		 * @param StringRef argument El argumento a comprobar.
+		 * @param TypedValue typed Donde se deja el valor convertido.
+		 * @return ArgumentProblem Problema o ArgumentOk.
+		 */
+		ArgumentProblem		typeProblem(const StringRef argument, TypedValue& typed) const;
+
+		/**
+		 * Comprueba el valor del argumento (rango y valores de cadena), ya
+		 * convertido por typeProblem(), sin lanzar excepciones.
+		 *
+		 * @param StringRef value Valor a comprobar.
+		 * @param TypedValue typed Valor convertido; se le añade la posición
+		 * en las cadenas válidas.
+		 * @return ArgumentProblem Problema o ArgumentOk.
+		 */
+		ArgumentProblem		valueProblem(const StringRef value, TypedValue& typed) const;
+
+		/**
+		 * Comprueba el tipo del argumento (y lo convierte) y su valor sin
+		 * lanzar excepciones.
 		 *
-		 * @param string argument El argumento a comprobar.
+		 * @param StringRef argument El argumento a comprobar.
+		 * @param TypedValue typed Donde se deja el valor convertido.
+		 * @return ArgumentProblem Problema o ArgumentOk.
+		 */
+		ArgumentProblem		argumentProblem(const StringRef argument, TypedValue& typed) const;
+
+		/**
+		 * Compone el mensaje de un problema de un argumento.
+		 *
+		 * @param ArgumentProblem problem Problema.
+		 * @param StringRef argument Argumento.
+		 * @return string Mensaje.
+		 */
+		const string		argumentMessage(ArgumentProblem problem, const StringRef argument) const;
+
+		/**
+		 * Lanza la excepción de un problema de un argumento.
+		 *
+		 * @param ArgumentProblem problem Problema.
+		 * @param StringRef argument Argumento.
+		 * @throw clipp::error::InvalidArgument Siempre.
+		 */
+		void				throwArgumentProblem(ArgumentProblem problem, const StringRef argument) const;
+
+		/**
+		 * Comprueba el tipo de argumento y lo convierte (una sola vez) a su
+		 * tipo.
+		 *
+		 * @param StringRef argument El argumento a comprobar.
+		 * @param TypedValue typed Donde se deja el valor convertido.
 		 * @throw clipp::Exception En caso de fallo.
 		 */
-		void				checkArgumentType(const string argument) const;
+		void				checkArgumentType(const StringRef argument, TypedValue& typed) const;
 
 		/**
 		 * Comprueba el valor del argrumento (rango y valores de cadena).
 		 *
-		 * @param string value Valor a comprobar.
+		 * @param StringRef value Valor a comprobar.
+		 * @param TypedValue typed Valor ya convertido por checkArgumentType();
+		 * se le añade la posición en las cadenas válidas.
 		 * @throw clipp::Exception En caso de fallo.
 		 */
-		void				checkArgumentValue(const string value) const;
+		void				checkArgumentValue(const StringRef value, TypedValue& typed) const;
 
 		/**
 		 * Asigna un puntero a una variable y su tipo.
@@ -288,7 +372,8 @@ class OptionDefinition {
 
 		/**
 		 * Fija y devuelve si una opción es requerida sólo si ya existe una
-		 * opción indicada. Este método se puede invocar varias veces.
+		 * opción indicada. Este método se puede invocar varias veces: la
+		 * opción es requerida si está cualquiera de las indicadas.
 		 *
 		 * @param string option La opción requerida para que esta lo sea.
 		 * @return OptionDefinition& this
@@ -300,7 +385,8 @@ class OptionDefinition {
 
 		/**
 		 * Fija y devuelve si una opción NO es requerida sólo si ya existe una
-		 * opción indicada. Este método se puede invocar varias veces.
+		 * opción indicada. Este método se puede invocar varias veces: la
+		 * opción es requerida si no está ninguna de las indicadas.
 		 *
 		 * @param string option La opción requerida para que esta lo sea.
 		 * @return OptionDefinition& this
@@ -354,6 +440,15 @@ class OptionDefinition {
 		OptionDefinition&	multiple(bool multiple = true);
 		bool				isMultiple() const;
 
+		/**
+		 * Devuelve si el nombre de la opción es un patrón ("*" es cualquier
+		 * secuencia de caracteres y "%n" uno o más dígitos; ver
+		 * OptionManager::option()).
+		 *
+		 * @return bool True si es un patrón.
+		 */
+		bool				isPattern() const;
+
 		/**
 		 * Fija y devuelve si la opción es exclusiva.
 		 *
@@ -375,7 +470,9 @@ class OptionDefinition {
 		bool				allowNoPreffix() const;
 
 		/**
-		 * Fija y devuelve el valor predeterminado de esta opción.
+		 * Fija y devuelve el valor predeterminado de esta opción. Es la capa
+		 * más baja de OptionManager::value() y se asigna a la variable de la
+		 * opción (ver var()) si no hay otro valor.
 		 *
 		 * @param string defaultValue Valor por defecto.
 		 * @return string Valor por defecto.
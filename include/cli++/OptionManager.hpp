@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <deque>
+#include <vector>
 
 #if __cplusplus >= 201103L
 #include <unordered_map>
@@ -22,6 +23,11 @@ using std::ostream;
 
 #include <cli++/OptionDefinition.hpp>
 #include <cli++/Option.hpp>
+#include <cli++/ParseResult.hpp>
+#include <cli++/ParseStats.hpp>
+#include <cli++/CompiledSchema.hpp>
+#include <cli++/Completion.hpp>
+#include <cli++/Configuration.hpp>
 #include <cli++/Utils.hpp>
 #include <cli++/Exceptions.hpp>
 
@@ -36,6 +42,16 @@ namespace clipp {
  */
 typedef int (*OnArgumentProcessed)(const string argument, int position);
 
+class OptionManager;
+
+/**
+ * Tipo de función que crea las definiciones de un subcomando en su
+ * OptionManager (ver OptionManager::subcommand()).
+ *
+ * @param OptionManager& om OptionManager del subcomando.
+ */
+typedef void (*SubcommandFactory)(OptionManager& om);
+
 /**
  * Clase que gestiona las definiciones de las opciones de la línea de comandos
  * y que analiza dicha línea para ver si coinciden los valores pasados con
@@ -48,64 +64,151 @@ class OptionManager {
 		 * Tipo de error que se puede producir.
 		 */
 		enum Error {
-			ERROR_INVALID_OPTION,
+			ERROR_NONE,					/// No hay error.
+			ERROR_INVALID_OPTION,		/// Opción que no existe (InvalidOption).
+			ERROR_INVALID_ARGUMENT,		/// Argumento incorrecto (InvalidArgument).
+			ERROR_REQUIRED_OPTION,		/// Falta una opción obligatoria (RequiredOption).
+			ERROR_REQUIRED_ARGUMENT,	/// Falta el argumento de una opción (RequiredArgument).
+			ERROR_EXCLUSIVE_OPTION,		/// Opción exclusiva con otras (ExclusiveOption).
+			ERROR_MULTIPLE_OPTION,		/// Opción repetida que no es múltiple (MultipleOption).
+			ERROR_AMBIGUOUS_OPTION,		/// Opción ambigua (AmbiguousOption).
+			ERROR_CONFLICT,				/// Opciones en conflicto (Conflict).
+			ERROR_LENGTH,				/// Número de argumentos o valores incorrecto (Length).
+			ERROR_RESPONSE_FILE,		/// Fichero de respuestas que no se puede leer (ResponseFile).
+			ERROR_INPUT,				/// Fallo al leer del descriptor (Input).
+			ERROR_OTHER,				/// Otra excepción de la librería (de las variables o funciones, por ejemplo).
 			ERROR_LAST_ERROR
 		};
 
+		/**
+		 * Resultado de un análisis sin excepciones (ver tryProcess()) o uno
+		 * de sus errores (ver parseError()).
+		 */
+		struct Status {
+			Error		error;		/// Tipo del error (ERROR_NONE si no hay).
+			int			token;		/// Posición del elemento en la línea de comandos (0 es el programa), o -1 si no es de uno.
+			int			slot;		/// Posición de la definición en el orden en que se crearon, o -1 si no es de una.
+		};
+
 	private:
 
 		/**
 		 * Tipo de dato que mantiene las definiciones de opciones. Si está
 		 * disponible C++11 se usa 'unordered_map' porque es más rápido a la
 		 * hora de obtener las opciones, aunque realmente no mantiene el orden
-		 * de inserción, sino un orden basado en una función hash.
+		 * de inserción, sino un orden basado en una función hash. Las claves
+		 * son referencias a fDefinitionKeys para poder buscar directamente
+		 * con trozos de "argv" sin crear cadenas temporales.
 		 */
 #if __cplusplus >= 201103L
-		typedef std::unordered_map<string, OptionDefinition*>	OptionDefinitionMap;
+		typedef std::unordered_map<StringRef, OptionDefinition*, StringRefHash>	OptionDefinitionMap;
+		typedef std::unordered_map<int, int>									SlotMap;
 #else
-		typedef std::map<string, OptionDefinition*>				OptionDefinitionMap;
+		typedef std::map<StringRef, OptionDefinition*>							OptionDefinitionMap;
+		typedef std::map<int, int>												SlotMap;
 #endif
 
+		typedef std::vector<OptionDefinition*>					OptionDefinitionList;
+		typedef std::vector<int>								SlotList;
+
 		/**
-		 * Tipo de dato que mantiene las opciones leídas. Si está
-		 * disponible C++11 se usa 'unordered_map' porque es más rápido a la
-		 * hora de obtener las opciones, aunque realmente no mantiene el orden
-		 * de inserción, sino un orden basado en una función hash.
+		 * Ayuda ya compuesta para un ancho y una separación del borde.
 		 */
-#if __cplusplus >= 201103L
-		typedef std::unordered_map<string, Option*>				OptionMap;
-#else
-		typedef std::map<string, Option*>						OptionMap;
-#endif
+		struct HelpLayout {
+			unsigned int		width;		/// Ancho (0 para no partir las líneas).
+			unsigned int		padding;	/// Separación del borde izquierdo.
+			string				text;		/// Texto de la ayuda.
+		};
+
+		typedef std::vector<HelpLayout>							HelpLayoutList;
+
+		/**
+		 * Valor de una opción en las capas que no son la línea de comandos
+		 * (entorno, fichero o valor por defecto), ya comprobado. Se resuelve
+		 * la primera vez que hace falta y se guarda hasta que cambian las
+		 * definiciones o la configuración.
+		 */
+		struct LayeredValue {
+			bool					resolved;	/// Si ya se ha resuelto.
+			Configuration::Source	source;		/// Capa de la que viene (SourceNone si no hay).
+			string					value;		/// Valor.
+			TypedValue				typed;		/// Valor convertido al tipo de la opción.
+		};
+
+		typedef std::vector<LayeredValue>						LayeredValueList;
 
-		typedef std::list<OptionDefinition*>					OptionDefinitionList;
-		typedef	std::list<Option*>								OptionList;
+		/**
+		 * Subcomando. Su OptionManager se crea (y la función crea sus
+		 * definiciones) la primera vez que hace falta.
+		 */
+		struct Subcommand {
+			string					name;			/// Nombre del subcomando.
+			string					description;	/// Descripción para la ayuda.
+			SubcommandFactory		factory;		/// Función que crea sus definiciones.
+			OptionManager*			manager;		/// Su OptionManager (NULL si todavía no se ha creado).
+		};
 
-		std::deque<string>			fRawOptions;				/// Opciones sin procesar.
+		typedef std::vector<Subcommand>							SubcommandList;
+
+		/**
+		 * Número máximo de ayudas compuestas que se guardan.
+		 */
+		static const size_t			MaxHelpLayouts = 8;
 
+		/**
+		 * Los id menores que este valor (y no negativos) se indexan
+		 * directamente en un vector; el resto en un mapa.
+		 */
+		static const int			DenseIdLimit = 4096;
+
+		std::deque<string>			fDefinitionKeys;			/// Nombres y alias de las definiciones (claves de fDefinitions).
 		OptionDefinitionMap			fDefinitions;				/// Las definiciones.
-		OptionDefinitionList		fOrderedDefinitions;		/// Las definiciones ordenadas según la inserción (para mostrarlas en la ayuda).
-		OptionMap					fOptions;					/// Las opciones.
-		OptionList					fOptionsList;				/// Lista de opciones (ordenadas por proceso).
-		OptionList::iterator		fOptionsIterator;			/// Iterador para recorrer las opciones por ID.
-		Strings						fArguments;					/// Los argumentos sin opción.
+		OptionDefinitionList		fOrderedDefinitions;		/// Las definiciones ordenadas según la inserción (su posición es fSlot).
+
+		SlotList					fIdSlots;					/// Primera posición de las definiciones de cada id (-1 si no hay).
+		SlotMap						fSparseIdSlots;				/// Lo mismo para los id fuera de [0, DenseIdLimit).
+		SlotList					fNextSameId;				/// Siguiente posición con el mismo id que cada posición (-1 si no hay).
+
+		HelpLayoutList				fHelpLayouts;				/// Ayudas ya compuestas (se descartan al cambiar las definiciones).
+		Configuration				fConfiguration;				/// Fichero de configuración y prefijo de las variables de entorno.
+		LayeredValueList			fLayeredValues;				/// Valores de las capas por posición de la definición.
+		SubcommandList				fSubcommands;				/// Subcomandos en orden de definición.
+		mutable Strings				fCompletionIndex;			/// Opciones y alias con su marcador ("--name", "-n"), ordenados (vacío si hay que crearlo).
+
+		CompiledSchema*				fSchema;					/// Esquema compilado de las definiciones (NULL si hay que compilarlo).
+		ParseResult					fResult;					/// Resultado del último análisis hecho con "process()".
+		ParseStats*					fStats;						/// Estadísticas de los análisis (NULL si no se toman).
 
 		string						fErrors[ERROR_LAST_ERROR];	/// Las descripciones de los errores.
 
 		Range<int>					fArgumentsCount;			/// Número mínimo y máximo de argumentos posicionales.
 		OnArgumentProcessed			fExecute;					/// Función a ejecutar por cada argumento.
+		bool						fResponseFiles;				/// Si se expanden los ficheros de respuestas ("@fichero").
+		bool						fAbbreviations;				/// Si se aceptan abreviaturas de las opciones largas.
+		unsigned int				fSuggestions;				/// Opciones parecidas que se sugieren si una es inválida.
+		OnArgumentStreamed			fStreamArguments;			/// Función a la que se pasan los argumentos sin guardarlos (o NULL).
 
 		string						fCredits;					/// Cadena con la descripción del título de la aplicación y los créditos.
 		string						fUsage;						/// Cadena con la información de uso.
 
-		int							fArgc;						/// Contador de argumentos de la línea de comandos.
-		char**						fArgv;						/// Argumentos de la línea de comandos.
+		int							fArgc;						/// Contador de argumentos de la línea de comandos (del constructor).
+		char**						fArgv;						/// Argumentos de la línea de comandos (del constructor).
 
 		/**
 		 * Clase amiga para usar la función "alias()".
 		 */
 		friend class	OptionDefinition;
 
+		/**
+		 * Clase amiga que compila las definiciones.
+		 */
+		friend class	CompiledSchema;
+
+		/**
+		 * Clase amiga que busca las opciones del resultado por su nombre.
+		 */
+		friend class	ParseResult;
+
 		/**
 		 * Devuelve una cadena representnado el argumento para la ayuda. Si el
 		 * argumento no tiene tipo, devuelve '%a'; si es un entero devuelve
@@ -132,164 +235,168 @@ class OptionManager {
 		/**
 		 * Devuelve si una opción o alias existe.
 		 *
-		 * @param string nameOrAlias Nombre o alias de la opción.
+		 * @param StringRef nameOrAlias Nombre o alias de la opción.
 		 * @return bool True si existe, false en otro caso.
 		 */
-		bool						hasOptionDefinition(const string nameOrAlias) const;
+		bool						hasOptionDefinition(const StringRef nameOrAlias) const;
 
 		/**
 		 * Devuelve una definición de opción, o NULL si no existe.
 		 *
-		 * @param string nameOrAlias Nombre o alias de la opción.
+		 * @param StringRef nameOrAlias Nombre o alias de la opción.
 		 * @return OptionDefinicion* Definición de opción o NULL.
 		 */
-		OptionDefinition*			getOptionDefinition(const string nameOrAlias) const;
-
-		/**
-		 * Devuelve la primera opción de la lista de opciones sin procesar
-		 * y la saca de dicha lista.
-		 *
-		 * @return string Opción.
-		 */
-		const string				popRawOption();
+		OptionDefinition*			getOptionDefinition(const StringRef nameOrAlias) const;
 
 		/**
-		 * Devuelve la primera opción de la lista de opciones sin procesar
-		 * pero no la saca de la lista.
-		 *
-		 * @return string Opción.
+		 * Descarta el esquema compilado, las ayudas compuestas y los valores
+		 * de las capas ya resueltos (se llama cuando cambian las
+		 * definiciones).
 		 */
-		const string				peekRawOption() const;
+		void						invalidate();
 
 		/**
-		 * Devuelve si todavía quedan opciones sin procesar.
+		 * Devuelve la ayuda compuesta para un ancho y una separación,
+		 * componiéndola si no está ya guardada.
 		 *
-		 * @return uint Número de opciones que quedan sin procesar.
+		 * @param uint width Ancho (0 para no partir las líneas).
+		 * @param uint padding Separación del borde izquierdo.
+		 * @return string& Texto de la ayuda (sin título).
 		 */
-		inline unsigned int			remainRawOptions() const;
+		const string&				helpLayout(unsigned int width, unsigned int padding);
 
 		/**
-		 * Devuelve si un parámetro de la línea de comandos es una opción,
-		 * es decir, comienza por "-" y más caracters o por "--" y más
-		 * caracteres.
+		 * Compone la ayuda de todas las opciones. Sin ancho se mantiene el
+		 * formato de siempre; con ancho, las descripciones van en una
+		 * columna y se parten por palabras para no pasar del ancho.
 		 *
-		 * @param string option Opción.
-		 * @return bool True si es opción, false en otro caso.
+		 * @param string& text Dónde se deja la ayuda.
+		 * @param uint width Ancho (0 para no partir las líneas).
+		 * @param uint padding Separación del borde izquierdo.
 		 */
-		inline bool					isOption(const string option) const;
+		void						renderHelp(string& text, unsigned int width, unsigned int padding) const;
 
 		/**
-		 * Devuelve si una opción es corta (si comienza por "-" y tiene más
-		 * caracteres).
+		 * Devuelve el texto de una opción en la ayuda: nombre, alias y
+		 * argumento ("--input|-i %s").
 		 *
-		 * @param string option La opción.
-		 * @return bool True si es corta, false en otro caso.
+		 * @param OptionDefinition* optdef Definición de la opción.
+		 * @return string Texto de la opción.
 		 */
-		inline bool					isShortOption(const string option) const;
+		const string				optionHelp(const OptionDefinition* optdef) const;
 
 		/**
-		 * Devuelve si una opción es larga (comienza por "--" y tiene más
-		 * caracteres).
+		 * Devuelve la primera posición de las definiciones con un id, o -1
+		 * si no hay ninguna. Las demás se obtienen con fNextSameId, en orden
+		 * de definición.
 		 *
-		 * @param string option Opción.
-		 * @return bool True si es larga, false en otro caso.
+		 * @param int id Id de las opciones.
+		 * @return int Posición o -1.
 		 */
-		inline bool					isLongOption(const string option) const;
+		int							firstSlot(int id) const;
 
 		/**
-		 * Devuelve una opción normalizada. Si es corta quita el "-" y si
-		 * es larga quita el "--".
+		 * Añade o quita una definición del índice por id (según su id
+		 * actual).
 		 *
-		 * @param string option La opción de la línea de comandos.
-		 * @param bool isShort True para indicar que es corta, false para
-		 * indicar que es larga.
-		 * @return string La opción normalizada.
+		 * @param int slot Posición de la definición.
 		 */
-		inline const string			normalizeOption(const string option, bool isShort = false) const;
+		void						linkId(int slot);
+		void						unlinkId(int slot);
 
 		/**
-		 * Procesa una opción corta. Puede obtener más parámetros de la línea
-		 * de comandos mediante la función "pop()".
+		 * Devuelve el valor de una opción en las capas que no son la línea
+		 * de comandos, resolviéndolo si todavía no se ha hecho.
 		 *
-		 * @param string option La opción.
-		 * @param bool normalize True para normalizar (-a -> a), false para
-		 * no normalizar.
+		 * @param OptionDefinition* optdef Definición de la opción.
+		 * @return LayeredValue& Valor (con SourceNone si no hay).
+		 * @throw clipp::error::InvalidArgument Si el valor no es válido.
+		 * @throw clipp::error::Configuration Si no se puede leer el fichero.
 		 */
-		void						decodeShortOption(const string option, bool normalize = true);
+		const LayeredValue&			layeredValue(const OptionDefinition* optdef);
 
 		/**
-		 * Procesa una opción larga. Puede obtener más parámetros de la línea
-		 * de comandos mediante la función "pop()".
+		 * Comprueba un valor de una capa igual que los de la línea de
+		 * comandos. Las opciones sin argumento tienen que tener un valor
+		 * booleano.
 		 *
-		 * @param string option La opción.
-		 * @param bool normalize True para normalizar (--help -> help), false
-		 * para no normalizar.
+		 * @param OptionDefinition* optdef Definición de la opción.
+		 * @param LayeredValue& layered Valor (se deja convertido).
+		 * @param string origin De dónde viene (para el mensaje de error).
+		 * @throw clipp::error::InvalidArgument Si el valor no es válido.
 		 */
-		void						decodeLongOption(const string option, bool normalize = true);
+		void						checkLayeredValue(const OptionDefinition* optdef, LayeredValue& layered, const string& origin) const;
 
 		/**
-		 * Postprocesa una opción, una vez decodificada la cadena de la línea
-		 * de comandos, ya está la definición y se comprueba si es exclusiva,
-		 * etc. y se añade a las opciones.
+		 * Busca el valor de una opción por capas, de la línea de comandos
+		 * al valor por defecto.
 		 *
-		 * @param OptionDefinition* od Definición de la opción.
-		 * @param string realOption Opción real que llegó en la línea de
-		 * comandos (por si es un alias).
-		 * @param bool isNegated True si la opción es la negada, false en otro
-		 * caso.
+		 * @param string name Nombre de la opción.
+		 * @param string& value Dónde se deja el valor.
+		 * @return Source Capa de la que viene (SourceNone si no hay).
 		 */
-		void						postProcessOption(const OptionDefinition* optdef, const string realOption = string(), bool isNegated = false);
+		Configuration::Source		lookupValue(const string& name, string& value);
 
 		/**
-		 * Añade una opción ya procesada. Si la opción ya existe, añade el
-		 * argumento.
+		 * Devuelve el OptionManager de un subcomando, creándolo si todavía
+		 * no existe.
 		 *
-		 * @param string OptionDefinition* Definición de la opción.
-		 * @param string argument Argumento.
-		 * @param bool True si la opción es la negada, false en otro caso.
+		 * @param int index Posición del subcomando.
+		 * @return OptionManager& OptionManager del subcomando.
 		 */
-		void						addOption(const OptionDefinition* optdef, const string argument = string(), bool isNegated = false);
+		OptionManager&				subcommandManager(int index);
 
 		/**
-		 * Procesa si están todas las opciones que tiene que estar.
+		 * Escribe los candidatos para completar una palabra de una línea de
+		 * comandos a medio escribir (ver complete()).
 		 *
-		 * @throw RequiredOptionException Si hace falta alguna opción.
-		 */
-		void						checkProcessedOptions() const;
-
-		/**
-		 * Chequea los conflictos entre opciones.
+		 * @param int count Número de palabras.
+		 * @param char** words Palabras (la cero es el programa o el
+		 * subcomando).
+		 * @param int current Posición de la palabra que se completa (si es
+		 * negativa no hay candidatos).
+		 * @param ostream& os Dónde se escriben los candidatos.
 		 */
-		void						checkConflicts() const;
-
-		/**
-		 * Procesa los argumentos una vez procesada la línea de comandos,
-		 * es decir, mira a ver si el número de ellos es correcto.
-		 */
-		void						processArguments() const;
+		void						completeWords(int count, char** words, int current, ostream& os);
 
 		/**
 		 * Actualiza las variables asignadas a cada opción.
+		 *
+		 * @param ParseResult& result Resultado del análisis.
 		 */
-		void						updateVariables();
+		void						updateVariables(const ParseResult& result);
 
 		/**
 		 * Ejecuta las funciones de las opciones (una por cada opción que
 		 * se fija en la definición).
+		 *
+		 * @param ParseResult& result Resultado del análisis.
 		 */
-		void						executeFunctionsForOptions() const;
+		void						executeFunctionsForOptions(const ParseResult& result) const;
 
 		/**
 		 * Ejecuta la función por cada argumento (una sóla función que se
 		 * ejecuta por cada argumento sin contar las opciones, sólo los
 		 * argumentos posicionales).
+		 *
+		 * @param ParseResult& result Resultado del análisis.
 		 */
-		void						executeFunctionForArguments() const;
+		void						executeFunctionForArguments(const ParseResult& result) const;
 
 	public:
 
 		/**
-		 * Constructor de la clase.
+		 * Constructor de la clase. Sin línea de comandos; se usa con
+		 * "process(argc, argv)" para analizar tantas líneas de comandos como
+		 * se quiera con las mismas definiciones.
+		 */
+		OptionManager();
+
+		/**
+		 * Constructor de la clase. Las opciones se analizan directamente sobre
+		 * "argv" sin copiarlas, así que "argv" tiene que seguir siendo válido
+		 * mientras se use el OptionManager (como ocurre con el "argv" de
+		 * "main()").
 		 *
 		 * @param int argc Contador de opciones.
 		 * @param char** argv Array de char* con las opciones.
@@ -308,6 +415,160 @@ class OptionManager {
 		 */
 		void					process();
 
+		/**
+		 * Procesa otra línea de comandos con las mismas definiciones. El
+		 * resultado anterior se descarta y el nuevo queda disponible tanto
+		 * en el valor devuelto como en los métodos de consulta de esta clase
+		 * (getOption(), next(), getArgument()...).
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @return ParseResult& Resultado del análisis.
+		 */
+		const ParseResult&		process(int argc, char** argv);
+
+		/**
+		 * Procesa una línea de comandos dejando el resultado en "result",
+		 * que se vacía antes de empezar (y se puede reutilizar de un
+		 * análisis a otro). No modifica el resultado interno.
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param ParseResult& result Dónde se deja el resultado.
+		 */
+		void					process(int argc, char** argv, ParseResult& result);
+
+		/**
+		 * Procesa una línea de comandos que sigue, después de "argv", con
+		 * los elementos que se leen de un descriptor, separados por '\0'
+		 * (como "find -print0 | programa") o por saltos de línea (las líneas
+		 * vacías no cuentan). Los elementos se leen por bloques según se
+		 * analizan, sin construir un "argv" con todos; si además los
+		 * argumentos posicionales no se guardan (ver streamArguments()), la
+		 * memoria no depende de cuánto se lea. El descriptor no se cierra.
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param int fd Descriptor del que se leen más elementos (0 para la
+		 * entrada estándar).
+		 * @param char delimiter Separador de los elementos ('\0' o '\n').
+		 * @param ParseResult& result Dónde se deja el resultado (si no se
+		 * pasa, queda en el resultado interno).
+		 * @return ParseResult& Resultado del análisis.
+		 * @throw clipp::error::Input Si falla la lectura.
+		 */
+		const ParseResult&		process(int argc, char** argv, int fd, char delimiter);
+		void					process(int argc, char** argv, int fd, char delimiter, ParseResult& result);
+
+		/**
+		 * Procesa una línea de comandos como "process(argc, argv)", pero sin
+		 * lanzar excepciones por los errores de la línea de comandos: se
+		 * devuelve el primero (su tipo, la posición del elemento y la de la
+		 * definición). Los mensajes no se componen hasta que se piden con
+		 * errorMessage(), y son los mismos que los de las excepciones, así
+		 * que un error cuesta poco más que una línea correcta.
+		 *
+		 * Con "collectAll" no se para en el primer error: se guardan todos
+		 * (ver countErrors() y parseError()). Si hay errores no se asignan
+		 * las variables ni se ejecutan las funciones, y el resultado no se
+		 * debe usar. Las excepciones de la librería que se lancen al asignar
+		 * las variables o en las funciones se guardan como un error más; las
+		 * demás no se capturan. Los errores de un subcomando se devuelven, pero
+		 * se consultan en su OptionManager (ver subcommand()).
+		 *
+		 *   OptionManager::Status status = om.tryProcess(argc, argv, true);
+		 *   for(int i = 0; i < om.countErrors(); i++) {
+		 *       cerr << om.errorMessage(i) << endl;
+		 *   }
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param bool collectAll True para guardar todos los errores.
+		 * @param ParseResult& result Dónde se dejan el resultado y los
+		 * errores (si no se pasa, en el resultado interno).
+		 * @return Status Primer error (ERROR_NONE si no hay).
+		 */
+		Status					tryProcess(int argc, char** argv, bool collectAll = false);
+		Status					tryProcess(int argc, char** argv, ParseResult& result, bool collectAll = false);
+
+		/**
+		 * Devuelve el número de errores del último "tryProcess()" con el
+		 * resultado interno.
+		 *
+		 * @return int Número de errores.
+		 */
+		int						countErrors() const;
+
+		/**
+		 * Devuelve un error del último "tryProcess()" (con el resultado
+		 * interno o con "result").
+		 *
+		 * @param int index Índice del error.
+		 * @param ParseResult& result Resultado de "tryProcess()".
+		 * @return Status Error.
+		 * @throw clipp::error::OutOfBounds Si el índice es incorrecto.
+		 */
+		Status					parseError(int index) const;
+		Status					parseError(const ParseResult& result, int index) const;
+
+		/**
+		 * Compone el mensaje de un error del último "tryProcess()" (con el
+		 * resultado interno o con "result"), el mismo que el de la excepción
+		 * que lanzaría "process()".
+		 *
+		 * @param int index Índice del error.
+		 * @param ParseResult& result Resultado de "tryProcess()".
+		 * @return string Mensaje.
+		 * @throw clipp::error::OutOfBounds Si el índice es incorrecto.
+		 */
+		const string			errorMessage(int index) const;
+		const string			errorMessage(const ParseResult& result, int index) const;
+
+		/**
+		 * Atiende las peticiones de autocompletado de la shell (ver
+		 * Completion): si el primer argumento es "--__complete", escribe
+		 * los candidatos para la palabra que se está completando (nombres y
+		 * alias de opciones, sus cadenas válidas o subcomandos) y si es
+		 * "--__completion bash|zsh", el script para la shell. Se llama antes
+		 * de "process()", que no hace falta: no se compila el esquema ni se
+		 * comprueba ni se ejecuta nada, sólo se buscan los prefijos en un
+		 * índice ordenado. De los subcomandos sólo se crea el que está en la
+		 * línea de comandos.
+		 *
+		 *   if(om.complete(argc, argv)) {
+		 *       return 0;
+		 *   }
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones.
+		 * @param ostream& os Dónde se escribe la respuesta.
+		 * @return bool True si era una petición de autocompletado (y ya se
+		 * ha respondido), false en otro caso.
+		 */
+		bool					complete(int argc, char** argv, ostream& os = std::cout);
+
+		/**
+		 * Compila las definiciones (si no lo estaban ya) y devuelve el
+		 * esquema de sólo lectura, que se puede usar desde varios hilos a
+		 * la vez. Se vuelve a compilar automáticamente si se añaden opciones
+		 * o alias, y entonces la referencia devuelta deja de ser válida.
+		 *
+		 * @return CompiledSchema& Esquema compilado.
+		 */
+		const CompiledSchema&	compile();
+
+		/**
+		 * Fija y devuelve las estadísticas que se rellenan en cada análisis
+		 * (se vacían al empezar cada uno). Con NULL (valor inicial) no se
+		 * toman estadísticas. Las estadísticas no son propiedad del
+		 * OptionManager y tienen que seguir siendo válidas mientras se usen.
+		 *
+		 * @param ParseStats* stats Estadísticas o NULL.
+		 * @return ParseStats* Estadísticas o NULL.
+		 */
+		void					stats(ParseStats* stats);
+		ParseStats*				stats() const;
+
 		/**
 		 * Devuelve el número de opciones definidas, incluidos los alias.
 		 *
@@ -343,6 +604,8 @@ class OptionManager {
 
 		/**
 		 * Devuelve una cadena con las descripciones de todas las opciones.
+		 * Se compone en cada llamada sin guardar nada (para eso está help()),
+		 * así que se puede llamar desde varios hilos a la vez.
 		 *
 		 * @param unsigned int padding Separación, en caracteres, del borde izquierdo.
 		 * @return string Descripciones de todas las opciones.
@@ -350,6 +613,36 @@ class OptionManager {
 		const string			description(const string title, unsigned int padding = 2) const;
 		const string			description(unsigned int padding = 2) const;
 
+		/**
+		 * Escribe la ayuda de todas las opciones, ajustada a un ancho. La
+		 * composición se hace una vez por cada ancho y separación y se
+		 * guarda hasta que cambian las definiciones, así que las siguientes
+		 * llamadas sólo copian el texto, sin crear cadenas intermedias. Por
+		 * eso no es const ni se debe llamar desde varios hilos a la vez.
+		 *
+		 * @param ostream& os Dónde se escribe.
+		 * @param char* buffer Dónde se escribe (se termina en '\0' y se
+		 * corta si no cabe).
+		 * @param size_t size Tamaño de "buffer".
+		 * @param uint width Ancho en caracteres (0 para no partir las líneas,
+		 * como description()).
+		 * @param uint padding Separación, en caracteres, del borde izquierdo.
+		 * @return size_t Longitud de la ayuda completa (si es mayor o igual
+		 * que "size", no ha cabido entera).
+		 */
+		void					help(ostream& os, unsigned int width = 0, unsigned int padding = 2);
+		size_t					help(char* buffer, size_t size, unsigned int width = 0, unsigned int padding = 2);
+
+		/**
+		 * Devuelve el ancho de la terminal asociada a un descriptor, o 0 si
+		 * no es una terminal. Si existe, se usa la variable de entorno
+		 * COLUMNS.
+		 *
+		 * @param int fd Descriptor (1 para la salida estándar).
+		 * @return uint Ancho en caracteres o 0.
+		 */
+		static unsigned int		terminalWidth(int fd = 1);
+
 		/**
 		 * Devuelve el rango (Range<int>) con el mínimo y el máximo de
 		 * número de argumentos posicionales. Hay que tener en cuenta que
@@ -360,10 +653,205 @@ class OptionManager {
 		 */
 		Range<int>&				argumentCountRange();
 
+		/**
+		 * Fija y devuelve si se expanden los ficheros de respuestas: un
+		 * elemento "@fichero" de la línea de comandos se sustituye por los
+		 * elementos del fichero (que a su vez puede tener otros "@fichero").
+		 * Los ficheros se proyectan en memoria y sus elementos no se copian,
+		 * así que siguen abiertos hasta el siguiente análisis. Por defecto no
+		 * se expanden.
+		 *
+		 * @param bool expand True para expandirlos.
+		 * @return bool True si se expanden.
+		 */
+		void					responseFiles(bool expand);
+		bool					responseFiles() const;
+
+		/**
+		 * Fija y devuelve si se aceptan abreviaturas de las opciones largas:
+		 * "--verb" es "--verbose" si es la única que empieza así (el nombre y
+		 * los alias de una misma opción no cuentan como varias). También en
+		 * "--verb=valor" y "--no-verb". Un nombre completo tiene prioridad
+		 * sobre un prefijo y un prefijo de varias opciones lanza
+		 * clipp::error::AmbiguousOption con las candidatas. Por defecto no se
+		 * aceptan.
+		 *
+		 * @param bool allow True para aceptarlas.
+		 * @return bool True si se aceptan.
+		 */
+		void					abbreviations(bool allow);
+		bool					abbreviations() const;
+
+		/**
+		 * Fija y devuelve cuántas opciones parecidas se sugieren cuando una
+		 * opción larga es inválida: "Invalid option: --verbos (did you mean
+		 * --verbose?)". También están en
+		 * clipp::error::InvalidOption::suggestions(). El índice de nombres se
+		 * construye al compilar el esquema y cada búsqueda calcula la
+		 * distancia de edición de un número fijo de nombres, como mucho. Por
+		 * defecto se sugieren tres; cero no sugiere ninguna ni construye el
+		 * índice.
+		 *
+		 * @param uint count Número de sugerencias.
+		 * @return uint Número de sugerencias.
+		 */
+		void					suggestions(unsigned int count);
+		unsigned int			suggestions() const;
+
+		/**
+		 * Fija y devuelve la función a la que se pasan los argumentos
+		 * posicionales según se analizan, para líneas de comandos con muchos
+		 * argumentos (al estilo de "xargs"). Los argumentos no se guardan
+		 * (salvo el cero, el nombre del programa), así que la memoria no
+		 * depende de cuántos haya: countArguments() los cuenta, pero
+		 * getArgument() sólo llega al cero. El máximo de argumentCountRange()
+		 * se comprueba en cuanto se pasa y el mínimo al final.
+		 *
+		 * La función se llama durante el análisis, antes de comprobar las
+		 * opciones obligatorias, los conflictos, etc.; si luego hay un error,
+		 * ya se habrá llamado con algunos argumentos. Con NULL (por defecto),
+		 * los argumentos se guardan como siempre.
+		 *
+		 * @param OnArgumentStreamed streamThis Función o NULL.
+		 * @return OnArgumentStreamed Función o NULL.
+		 */
+		void					streamArguments(OnArgumentStreamed streamThis);
+		OnArgumentStreamed		streamArguments() const;
+
+		/**
+		 * Fija y devuelve el fichero de configuración, una de las capas de
+		 * value() (ver Configuration para el formato). Las claves son los
+		 * nombres de las opciones. El fichero se lee la primera vez que hace
+		 * falta un valor suyo.
+		 *
+		 * @param string path Ruta del fichero (vacía para no usar ninguno).
+		 * @return string Ruta del fichero.
+		 */
+		void					configFile(const string path);
+		const string			configFile() const;
+
+		/**
+		 * Fija y devuelve el prefijo de las variables de entorno, una de las
+		 * capas de value(): con "APP", la opción "dry-run" se toma de
+		 * APP_DRY_RUN.
+		 *
+		 * @param string prefix Prefijo (vacío para no usar el entorno).
+		 * @return string Prefijo.
+		 */
+		void					environmentPrefix(const string prefix);
+		const string			environmentPrefix() const;
+
+		/**
+		 * Devuelven el valor de una opción buscándolo por capas, de mayor a
+		 * menor prioridad: la línea de comandos (resultado del último
+		 * "process()"), el entorno (ver environmentPrefix()), el fichero de
+		 * configuración (ver configFile()) y el valor por defecto de la
+		 * definición. Las tres últimas se resuelven la primera vez que se
+		 * pide cada opción (así el fichero no se lee si no hace falta) y se
+		 * comprueban como los argumentos de la línea de comandos (tipo,
+		 * máximo, mínimo y cadenas válidas); luego se guardan hasta que
+		 * cambian las definiciones, el fichero o el prefijo.
+		 *
+		 * Cada capa da un solo valor (en la línea de comandos, el primero).
+		 * Las opciones sin argumento valen "true" si están en la línea de
+		 * comandos ("false" si están negadas) y en las demás capas tienen
+		 * que tener un valor booleano; hasValue() sólo las da por fijadas si
+		 * valen verdadero. Las opciones obligatorias, exclusivas, etc. sólo
+		 * se comprueban en la línea de comandos. Las variables de las
+		 * opciones (ver OptionDefinition::var()) que no están en la línea de
+		 * comandos se asignan en "process()" con estas capas. Como guardan
+		 * los valores resueltos, no son const ni se deben llamar desde varios
+		 * hilos a la vez.
+		 *
+		 * @param string name Nombre de la opción.
+		 * @param T default_value Valor si no hay o no se puede convertir.
+		 * @return string Valor (vacío si no hay).
+		 * @throw clipp::error::InvalidArgument Si un valor no es válido.
+		 * @throw clipp::error::Configuration Si no se puede leer el fichero.
+		 */
+		bool					hasValue(const string name);
+		const string			value(const string name);
+		template <typename T>
+		const T					value(const string name, T default_value) {
+			// Se convierte como se ha comprobado ("yes" es un booleano, por
+			// ejemplo); lo que no entiende ParseValue(), como con StringTo().
+			string text;
+			T result;
+			if(lookupValue(name, text) == Configuration::SourceNone) {
+				return default_value;
+			}
+			return (ParseValue(StringRef(text), result) ? result : StringTo<T>(text, default_value));
+		}
+
+		/**
+		 * Devuelve de qué capa viene el valor de una opción.
+		 *
+		 * @param string name Nombre de la opción.
+		 * @return Source Capa (SourceNone si no hay valor).
+		 */
+		Configuration::Source	valueSource(const string name);
+
+		/**
+		 * Añade un subcomando ("programa build ..."). Si el primer argumento
+		 * posicional de "argv" es el nombre de un subcomando, el análisis de
+		 * este OptionManager termina ahí (con sus opciones, comprobaciones y
+		 * funciones como siempre) y el resto de la línea de comandos, desde
+		 * el nombre, se analiza con el OptionManager del subcomando, que
+		 * tiene sus propias definiciones, ayuda y número de argumentos.
+		 *
+		 * Ese OptionManager se crea, y la función crea sus definiciones, la
+		 * primera vez que se elige el subcomando (o que se pide con
+		 * subcommand(name)), así que los subcomandos que no se usan no
+		 * cuestan nada. Su resultado se consulta en él (getOption()...).
+		 *
+		 * @param string name Nombre del subcomando.
+		 * @param SubcommandFactory factory Función que crea sus definiciones.
+		 * @param string description Descripción para la ayuda (ver commands()).
+		 * @return OptionManager& OptionManager del subcomando.
+		 * @throw clipp::error::AlreadyExists Si ya existe.
+		 * @throw clipp::error::InvalidOption Si no existe (al pedirlo).
+		 */
+		void					subcommand(const string name, SubcommandFactory factory, const string description = string());
+		OptionManager&			subcommand(const string name);
+
+		/**
+		 * Devuelve el número de subcomandos.
+		 *
+		 * @return int Número de subcomandos.
+		 */
+		int						countSubcommands() const;
+
+		/**
+		 * Devuelve el subcomando elegido en el último "process()", o una
+		 * cadena vacía si no hay.
+		 *
+		 * @return string Nombre del subcomando.
+		 */
+		const string			selectedSubcommand() const;
+
+		/**
+		 * Devuelve una cadena con los nombres y descripciones de los
+		 * subcomandos (sin crearlos).
+		 *
+		 * @param unsigned int padding Separación, en caracteres, del borde izquierdo.
+		 * @return string Subcomandos.
+		 */
+		const string			commands(unsigned int padding = 2) const;
+
 		/**
 		 * Crea una opción. Si el nombre tiene más de 1 caracter, será
 		 * una opción larga, si tiene un sólo caracter será una opción corta.
 		 *
+		 * El nombre puede ser un patrón: "*" es cualquier secuencia de
+		 * caracteres y "%n" uno o más dígitos ("*" recoge cualquier opción y
+		 * "%n" las numéricas como "-2"). Un elemento que no es de ninguna
+		 * opción se busca en los patrones, primero en los que no tienen "*"
+		 * y con más caracteres fijos; encaja el nombre sin guiones ni
+		 * "=argumento". Las opciones de un patrón son múltiples y cada
+		 * elemento que encaja se guarda tal cual (Option::matchAt()); con
+		 * execute() se pasan a una función, para reenviarlos a otro programa,
+		 * por ejemplo.
+		 *
 		 * @param string option Nombre de la opción.
 		 * @param int id Id de la opción.
 		 * @return OptionDefinition& Referencia a la opción creada.
@@ -388,7 +876,9 @@ class OptionManager {
 		
 		/**
 		 * Indica si existe una opción dado su id. Este método no es
-		 * fiable ya que puede haber opciones que no tengan id.
+		 * fiable ya que puede haber opciones que no tengan id. El tiempo
+		 * no depende del número de opciones ni de apariciones (sólo del
+		 * número de definiciones que comparten el id).
 		 * 
 		 * @param int id Id de la opción.
 		 * @return bool True si existe, false en otro caso.
@@ -403,6 +893,25 @@ class OptionManager {
 		 */
 		const Option*			getOption(const string name) const;
 
+		/**
+		 * Devuelve una opción dado su id. Si varias definiciones comparten
+		 * el id, devuelve la primera definida que esté. Sus valores se
+		 * obtienen de la opción (get(), getAt()...).
+		 *
+		 * @param int id Id de la opción.
+		 * @return Option* Puntero a la opción o NULL si no existe.
+		 */
+		const Option*			getOption(const int id) const;
+
+		/**
+		 * Devuelve cuántas veces aparecen las opciones con un id (0 si no
+		 * aparece ninguna).
+		 *
+		 * @param int id Id de las opciones.
+		 * @return int Número de apariciones.
+		 */
+		int						occurrences(const int id) const;
+
 		/**
 		 * Cuenta el número de argumentos.
 		 *
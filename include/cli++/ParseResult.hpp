@@ -0,0 +1,444 @@
+/*
+ * ParseResult.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef PARSERESULT_HPP_
+#define PARSERESULT_HPP_
+
+#include <string>
+#include <vector>
+
+using std::string;
+
+#include <cli++/Arena.hpp>
+#include <cli++/Option.hpp>
+#include <cli++/ResponseFile.hpp>
+#include <cli++/TokenReader.hpp>
+#include <cli++/SlotBits.hpp>
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+class OptionManager;
+class CompiledSchema;
+
+/**
+ * Función a la que se pasan los argumentos posicionales según se analizan,
+ * sin guardarlos (ver OptionManager::streamArguments()).
+ *
+ * @param StringRef argument Argumento (sólo es válido durante la llamada).
+ * @param int position Posición del argumento (desde 1).
+ * @return int Se ignora.
+ */
+typedef int (*OnArgumentStreamed)(const StringRef argument, int position);
+
+/**
+ * Resultado de analizar una línea de comandos: las opciones procesadas y los
+ * argumentos posicionales. Está separado del OptionManager para poder
+ * analizar muchas líneas de comandos con las mismas definiciones; el mismo
+ * resultado se puede reutilizar en cada análisis (se vacía al empezar).
+ *
+ * Las opciones y los argumentos hacen referencia a "argv", que tiene que
+ * seguir siendo válido mientras se use el resultado.
+ *
+ * Todo lo que crea un análisis (las opciones, sus valores y las listas) se
+ * reserva en una Arena, propia o del usuario, que se libera de una sola vez
+ * al empezar el siguiente análisis.
+ *
+ * Las opciones se guardan en una tabla indexada por la posición de su
+ * definición en el esquema, así que buscarlas no necesita calcular ningún
+ * hash; las apariciones se guardan en un vector en el orden de la línea de
+ * comandos.
+ */
+class ParseResult {
+	private:
+
+		/**
+		 * Aparición de una opción en la línea de comandos: la posición de su
+		 * definición y los valores que añadió (índice del primero y cuántos).
+		 */
+		struct Occurrence {
+			int				slot;		/// Posición de la definición en el esquema.
+			unsigned int	first;		/// Índice del primer valor añadido.
+			unsigned int	count;		/// Número de valores añadidos.
+		};
+
+		/**
+		 * Error de un análisis sin excepciones (ver CompiledSchema::tryProcess()).
+		 * El mensaje no se compone hasta que se pide: sólo se guarda lo que
+		 * hace falta para componerlo.
+		 */
+		struct Failure {
+			int				error;		/// Tipo del error (OptionManager::Error).
+			int				reason;		/// Cómo se compone el mensaje (ver CompiledSchema).
+			int				token;		/// Posición del elemento en la línea de comandos (o -1).
+			int				slot;		/// Posición de la definición en el esquema (o -1).
+			int				other;		/// Otro dato del mensaje (otra posición, un número...).
+			StringRef		text;		/// Elemento de la línea de comandos (o el mensaje ya compuesto).
+			StringRef		name;		/// Nombre de la opción (sin guiones).
+		};
+
+		typedef	std::vector<Option*>									OptionTable;
+		typedef	std::vector<Option*, ArenaAllocator<Option*> >			OptionList;
+		typedef	std::vector<Occurrence, ArenaAllocator<Occurrence> >	OccurrenceList;
+		typedef	std::vector<StringRef, ArenaAllocator<StringRef> >		ArgumentList;
+		typedef	std::vector<ResponseFile*, ArenaAllocator<ResponseFile*> >	ResponseFileList;
+		typedef	std::vector<Failure, ArenaAllocator<Failure> >			FailureList;
+
+		Arena						fOwnArena;			/// Zona de memoria propia.
+		Arena*						fArena;				/// Zona de memoria del análisis (fOwnArena o la del usuario).
+
+		int							fArgc;				/// Contador de argumentos de la línea de comandos.
+		char**						fArgv;				/// Argumentos de la línea de comandos.
+		int							fRawIndex;			/// Índice del primer elemento de "argv" sin procesar.
+		unsigned long				fTokens;			/// Elementos devueltos por popRawOption().
+		bool						fExpandFiles;		/// Si se expanden los ficheros de respuestas ("@fichero").
+		StringRef					fPending;			/// Siguiente elemento ya leído (por peekRawOption()).
+		bool						fHasPending;		/// Si hay un elemento en fPending.
+		ResponseFileList			fResponseFiles;		/// Ficheros de respuestas abiertos (sus elementos se referencian).
+		ResponseFileList			fOpenFiles;			/// Ficheros de respuestas que se están leyendo (el último, el actual).
+		TokenReader*				fReader;			/// Lector de los elementos que siguen a "argv" (o NULL).
+		bool						fProcessed;			/// Si el análisis terminó correctamente.
+
+		OptionTable					fTable;				/// Opciones por posición de su definición (NULL si no está).
+		OptionList					fOptions;			/// Opciones distintas, en orden de primera aparición.
+		SlotWord*					fPresent;			/// Conjunto de las posiciones de las opciones que están.
+		OccurrenceList				fOccurrences;		/// Apariciones en el orden de la línea de comandos.
+		OccurrenceList::size_type	fOptionsIterator;	/// Posición para recorrer las opciones por ID.
+		ArgumentList				fArguments;			/// Los argumentos sin opción (referencias a "argv").
+		int							fArgumentCount;		/// Argumentos analizados (también los que no se guardan).
+		int							fSubcommand;		/// Subcomando elegido (su posición en el OptionManager, o -1).
+		int							fSubcommandIndex;	/// Posición del subcomando en "argv" (donde empieza su línea de comandos).
+		FailureList					fFailures;			/// Errores guardados (sólo sin excepciones).
+		bool						fCollect;			/// Si los errores se guardan en vez de lanzarse.
+		bool						fCollectAll;		/// Si se sigue analizando después del primer error.
+		int							fToken;				/// Posición del elemento que se está analizando (o -1).
+
+		/**
+		 * Evitamos que esta clase se pueda clonar o asignar.
+		 */
+		ParseResult(const ParseResult&);
+		ParseResult& operator = (const ParseResult&);
+
+		/**
+		 * Clase que rellena el resultado.
+		 */
+		friend class OptionManager;
+		friend class CompiledSchema;
+
+		/**
+		 * Vacía el resultado y lo prepara para analizar una nueva línea de
+		 * comandos. Se destruyen las opciones, se cierran los ficheros de
+		 * respuestas y se libera la zona de memoria de una sola vez.
+		 *
+		 * @param int argc Contador de argumentos.
+		 * @param char** argv Argumentos.
+		 * @param bool expandFiles True para expandir los ficheros de
+		 * respuestas ("@fichero").
+		 */
+		void						reset(int argc, char** argv, bool expandFiles = false);
+
+		/**
+		 * Hace que, después de "argv", se sigan leyendo elementos de un
+		 * descriptor.
+		 *
+		 * @param int fd Descriptor.
+		 * @param char delimiter Separador de los elementos ('\0' o '\n').
+		 */
+		void						readFrom(int fd, char delimiter);
+
+		/**
+		 * Devuelve un elemento que se puede guardar hasta el siguiente
+		 * análisis: si es de los buffers del lector del descriptor, que se
+		 * reutilizan, se copia a la zona de memoria.
+		 *
+		 * @param StringRef token Elemento.
+		 * @return StringRef Elemento que se puede guardar.
+		 */
+		const StringRef				keep(const StringRef token) {
+			return fReader != NULL && fReader->owns(token) ? copy(token) : token;
+		}
+
+		/**
+		 * Copia un elemento a la zona de memoria.
+		 *
+		 * @param StringRef token Elemento.
+		 * @return StringRef Copia.
+		 */
+		const StringRef				copy(const StringRef token);
+
+		/**
+		 * Devuelve si hay que dejar de analizar: los errores se guardan, ya
+		 * hay alguno y no se quieren todos.
+		 *
+		 * @return bool True si hay que parar.
+		 */
+		bool						stopped() const {
+			return fCollect && !fCollectAll && !fFailures.empty();
+		}
+
+		/**
+		 * Lee el siguiente elemento sin procesar en fPending, abriendo los
+		 * ficheros de respuestas que aparezcan.
+		 *
+		 * @return bool True si hay elemento, false si no quedan.
+		 * @throw clipp::error::ResponseFile Si no se puede leer un fichero o
+		 * hay un ciclo.
+		 */
+		bool						fetchRawOption();
+
+		/**
+		 * Abre un fichero de respuestas y lo pone como fuente de los
+		 * siguientes elementos.
+		 *
+		 * @param StringRef path Ruta del fichero.
+		 * @throw clipp::error::ResponseFile Si no se puede leer, hay un ciclo
+		 * o demasiados ficheros anidados.
+		 */
+		void						openResponseFile(const StringRef path);
+
+		/**
+		 * Devuelve el primer elemento sin procesar y avanza.
+		 *
+		 * @return StringRef Elemento (referencia a "argv" o a un fichero de
+		 * respuestas).
+		 */
+		const StringRef				popRawOption() {
+			// Sin ficheros de respuestas, directamente de "argv".
+			if(!fHasPending && !fExpandFiles && fRawIndex < fArgc) {
+				fTokens++;
+				return StringRef(fArgv[fRawIndex++]);
+			}
+			if(!fHasPending && !fetchRawOption()) {
+				return StringRef();
+			}
+			fHasPending = false;
+			fTokens++;
+			return fPending;
+		}
+
+		/**
+		 * Devuelve el primer elemento sin procesar sin avanzar.
+		 *
+		 * @return StringRef Elemento (referencia a "argv" o a un fichero de
+		 * respuestas).
+		 */
+		const StringRef				peekRawOption() {
+			if(!fHasPending && !fExpandFiles && fRawIndex < fArgc) {
+				return StringRef(fArgv[fRawIndex]);
+			}
+			if(!fHasPending && !fetchRawOption()) {
+				return StringRef();
+			}
+			return fPending;
+		}
+
+		/**
+		 * Devuelve si quedan elementos sin procesar.
+		 *
+		 * @return bool True si quedan.
+		 */
+		bool						hasRawOptions() {
+			return fHasPending || (!fExpandFiles && fRawIndex < fArgc) || ((fExpandFiles || fReader != NULL) && fetchRawOption());
+		}
+
+		/**
+		 * Prepara la tabla de opciones para un esquema de "slots"
+		 * definiciones y reserva sitio para lo que hay en "argv".
+		 *
+		 * @param int slots Número de definiciones del esquema.
+		 * @param bool storeArguments False si los argumentos posicionales no
+		 * se van a guardar (no se reserva sitio según "argc").
+		 */
+		void						prepare(int slots, bool storeArguments = true);
+
+		/**
+		 * Devuelve una opción para modificarla, o NULL si no existe.
+		 *
+		 * @param StringRef name Nombre de la opción.
+		 * @return Option* Opción o NULL.
+		 */
+		Option*						findOption(const StringRef name) const;
+
+		/**
+		 * Devuelve la opción de una definición, o NULL si no está.
+		 *
+		 * @param OptionDefinition* optdef Definición de la opción.
+		 * @return Option* Opción o NULL.
+		 */
+		Option*						findOption(const OptionDefinition* optdef) const;
+
+		/**
+		 * Devuelve la opción de la primera definición con un id que esté,
+		 * o NULL si no hay ninguna.
+		 *
+		 * @param int id Id de la opción.
+		 * @return Option* Opción o NULL.
+		 */
+		Option*						findOption(const int id) const;
+
+		/**
+		 * Añade una aparición de una opción con su argumento, creando la
+		 * opción en la zona de memoria del análisis si es la primera.
+		 *
+		 * @param OptionDefinition* optdef Definición de la opción.
+		 * @param StringRef argument Argumento (referencia a "argv").
+		 * @param StringRef match Elemento que ha encajado con el patrón de
+		 * la definición (vacío si no es un patrón).
+		 * @return Option* La opción.
+		 */
+		Option*						addOccurrence(const OptionDefinition* optdef, const StringRef argument, const StringRef match = StringRef());
+
+	public:
+
+		/**
+		 * Constructores de la clase. Sin parámetros usa una zona de memoria
+		 * propia; si no, la indicada, que tiene que seguir siendo válida
+		 * mientras exista el resultado y no se debe compartir con otros
+		 * resultados.
+		 *
+		 * @param Arena& arena Zona de memoria para los análisis.
+		 */
+		ParseResult();
+		ParseResult(Arena& arena);
+
+		/**
+		 * Destructor de la clase.
+		 */
+		virtual						~ParseResult();
+
+		/**
+		 * Devuelve el número de opciones procesadas.
+		 *
+		 * @return int Número de opciones procesadas.
+		 */
+		int							countProcessedOptions() const;
+
+		/**
+		 * Indica si existe una opción con dicho nombre.
+		 *
+		 * @param string name Nombre de la opción.
+		 * @return bool True si existe, false en otro caso.
+		 */
+		bool						hasOption(const string name) const;
+
+		/**
+		 * Indica si existe una opción dado su id. Este método no es
+		 * fiable ya que puede haber opciones que no tengan id. El tiempo
+		 * no depende del número de opciones ni de apariciones (sólo del
+		 * número de definiciones que comparten el id).
+		 *
+		 * @param int id Id de la opción.
+		 * @return bool True si existe, false en otro caso.
+		 */
+		bool						hasOption(const int id) const;
+
+		/**
+		 * Devuelve una opción dado el nombre.
+		 *
+		 * @param string name Nombre de la opción.
+		 * @return Option* Puntero a la opción o NULL si no existe.
+		 */
+		const Option*				getOption(const string name) const;
+
+		/**
+		 * Devuelve una opción dado su id. Si varias definiciones comparten
+		 * el id, devuelve la primera definida que esté. Sus valores se
+		 * obtienen de la opción (get(), getAt()...).
+		 *
+		 * @param int id Id de la opción.
+		 * @return Option* Puntero a la opción o NULL si no existe.
+		 */
+		const Option*				getOption(const int id) const;
+
+		/**
+		 * Devuelve cuántas veces aparecen las opciones con un id (0 si no
+		 * aparece ninguna).
+		 *
+		 * @param int id Id de las opciones.
+		 * @return int Número de apariciones.
+		 */
+		int							occurrences(const int id) const;
+
+		/**
+		 * Cuenta el número de argumentos (también los que se han pasado a
+		 * OptionManager::streamArguments() sin guardarlos).
+		 *
+		 * @return int Número de argumentos.
+		 */
+		int							countArguments() const;
+
+		/**
+		 * Devuelve el número de errores guardados por el último análisis
+		 * sin excepciones (ver CompiledSchema::tryProcess()); con los otros
+		 * análisis siempre es 0.
+		 *
+		 * @return int Número de errores.
+		 */
+		int							countErrors() const;
+
+		/**
+		 * Devuelve el nombre del subcomando elegido en la línea de comandos
+		 * (ver OptionManager::subcommand()), o una cadena vacía si no hay.
+		 * Su línea de comandos se analiza con su propio OptionManager.
+		 *
+		 * @return string Nombre del subcomando.
+		 */
+		const string				subcommand() const;
+
+		/**
+		 * Devuelve un argumento dado su índice.
+		 *
+		 * @param int index Índice del argumento a obtener.
+		 * @return string Argumento.
+		 * @throw OutOfBoundsException Si el índice es incorrecto.
+		 */
+		const string				getArgument(int index) const;
+
+		/**
+		 * Devuelve el primer argumento.
+		 *
+		 * @return string Argumento.
+		 * @throw OutOfBoundsException Si no hay argumentos.
+		 */
+		const string				firstArgument() const;
+
+		/**
+		 * Devuelve el último argumento.
+		 *
+		 * @return string Argumento.
+		 * @throw OutOfBoundsException Si no hay argumentos.
+		 */
+		const string				lastArgument() const;
+
+		/**
+		 * Devuelve la opción actual o NULL si ya no hay más incrementando
+		 * el iterador a la siguiente opción.
+		 *
+		 * @return Option* Opción actual o NULL si ya no hay más.
+		 * @throw Unprocessed Si no se ha completado el análisis.
+		 */
+		const Option*				next();
+
+		/**
+		 * Resetea el contador de id's de opciones hasta el principio para
+		 * poder volver a usar el bucle de procesado.
+		 */
+		void						rewind();
+
+		/**
+		 * Devuelve una representación del resultado como cadena para
+		 * depuración.
+		 *
+		 * @return string Cadena representando el resultado.
+		 */
+		const string				dump() const;
+};
+
+}	// namespace clipp
+
+#endif /* PARSERESULT_HPP_ */
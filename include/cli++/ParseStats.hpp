@@ -0,0 +1,172 @@
+/*
+ * ParseStats.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef PARSESTATS_HPP_
+#define PARSESTATS_HPP_
+
+#include <cstddef>
+#include <string>
+
+using std::string;
+
+namespace clipp {
+
+class OptionManager;
+class CompiledSchema;
+
+/**
+ * Estadísticas de un análisis de la línea de comandos: contadores, reservas
+ * de memoria y tiempo de cada fase. Es opcional: sólo se rellena si se le
+ * pasa al análisis (OptionManager::stats() o CompiledSchema::process()), y
+ * se vacía al empezar cada análisis.
+ *
+ * Las reservas de memoria sólo se cuentan si la aplicación llama a
+ * ParseStats::allocation() desde su "operator new" (por ejemplo, incluyendo
+ * <cli++/CountingNew.hpp> en uno de sus ficheros). Se cuentan las reservas
+ * hechas por el hilo que analiza mientras dura el análisis.
+ */
+class ParseStats {
+	public:
+
+		/**
+		 * Fases del análisis.
+		 */
+		enum Phase {
+			PhaseDecode,			/// Decodificación de la línea de comandos.
+			PhaseCheckOptions,		/// Opciones exclusivas, obligatorias y tipos de argumentos.
+			PhaseCheckConflicts,	/// Conflictos entre opciones.
+			PhaseProcessArguments,	/// Número de argumentos posicionales.
+			PhaseUpdateVariables,	/// Actualización de las variables asociadas.
+			PhaseCallbacks,			/// Funciones de las opciones y de los argumentos.
+			PhaseCount
+		};
+
+		/**
+		 * Ámbito en el que unas estadísticas son las del hilo actual, para
+		 * contar las búsquedas y las reservas de memoria. Al salir del
+		 * ámbito (también con excepciones) se restauran las anteriores.
+		 */
+		class Scope {
+			private:
+				ParseStats*		fPrevious;	/// Estadísticas anteriores del hilo.
+
+				Scope(const Scope&);
+				Scope& operator = (const Scope&);
+
+			public:
+				Scope(ParseStats* stats);
+				~Scope();
+		};
+
+		/**
+		 * Medidor del tiempo de una fase: suma a la fase el tiempo que pasa
+		 * desde su creación hasta su destrucción. No hace nada si las
+		 * estadísticas son NULL.
+		 */
+		class Timer {
+			private:
+				ParseStats*		fStats;		/// Estadísticas (o NULL).
+				Phase			fPhase;		/// Fase medida.
+				unsigned long	fStart;		/// Instante de inicio en nanosegundos.
+
+				Timer(const Timer&);
+				Timer& operator = (const Timer&);
+
+			public:
+				Timer(ParseStats* stats, Phase phase);
+				~Timer();
+		};
+
+	private:
+		unsigned long		fTokens;				/// Elementos de la línea de comandos analizados.
+		unsigned long		fLookups;				/// Búsquedas de definiciones por nombre o alias.
+		unsigned long		fOptionsCreated;		/// Objetos Option creados.
+		unsigned long		fAllocations;			/// Reservas de memoria.
+		unsigned long		fAllocatedBytes;		/// Bytes reservados.
+		unsigned long		fTimes[PhaseCount];		/// Tiempo de cada fase en nanosegundos.
+
+		/**
+		 * Clases que rellenan las estadísticas.
+		 */
+		friend class OptionManager;
+		friend class CompiledSchema;
+		friend class Scope;
+		friend class Timer;
+
+		/**
+		 * Devuelve las estadísticas del hilo actual, o NULL si no se está
+		 * analizando con estadísticas.
+		 *
+		 * @return ParseStats* Estadísticas actuales o NULL.
+		 */
+		static ParseStats*	current();
+
+		/**
+		 * Devuelve el instante actual (reloj monótono) en nanosegundos.
+		 *
+		 * @return ulong Instante actual.
+		 */
+		static unsigned long	now();
+
+	public:
+
+		/**
+		 * Constructor de la clase.
+		 */
+		ParseStats();
+
+		/**
+		 * Destructor de la clase.
+		 */
+		virtual					~ParseStats();
+
+		/**
+		 * Pone todos los contadores a cero.
+		 */
+		void					reset();
+
+		/**
+		 * Cuenta una reserva de memoria en las estadísticas del hilo actual,
+		 * si las hay. Está pensada para llamarse desde "operator new", así
+		 * que no reserva memoria.
+		 *
+		 * @param size_t bytes Tamaño de la reserva.
+		 */
+		static void				allocation(size_t bytes);
+
+		/**
+		 * Devuelven los contadores.
+		 *
+		 * @return ulong Valor del contador.
+		 */
+		unsigned long			tokens() const;
+		unsigned long			lookups() const;
+		unsigned long			optionsCreated() const;
+		unsigned long			allocations() const;
+		unsigned long			allocatedBytes() const;
+
+		/**
+		 * Devuelve el tiempo de una fase.
+		 *
+		 * @param Phase phase Fase.
+		 * @return ulong Tiempo en nanosegundos.
+		 */
+		unsigned long			time(Phase phase) const;
+
+		/**
+		 * Devuelve las estadísticas como texto con una línea "clave=valor"
+		 * por contador (los tiempos en nanosegundos).
+		 *
+		 * @return string Estadísticas.
+		 */
+		const string			dump() const;
+};
+
+}	// namespace clipp
+
+#endif /* PARSESTATS_HPP_ */
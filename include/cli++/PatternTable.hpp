@@ -0,0 +1,237 @@
+/*
+ * PatternTable.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef PATTERNTABLE_HPP_
+#define PATTERNTABLE_HPP_
+
+#include <algorithm>
+#include <vector>
+
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Tabla ordenada de patrones de nombres de opción. En un patrón, "*" es
+ * cualquier secuencia de caracteres (también vacía), "%n" uno o más dígitos
+ * y el resto de caracteres son literales. Los patrones se parten al
+ * construir la tabla en piezas y se ordenan de más a menos concretos: antes
+ * los que no tienen "*" y, entre ellos, los que tienen más literales (a
+ * igualdad, en el orden en el que se añadieron). Una búsqueda devuelve el
+ * valor del primero que encaja con el nombre entero; sólo se hace cuando el
+ * nombre no es de ninguna definición, así que no afecta a las demás. Los
+ * patrones no se copian: tienen que seguir siendo válidos mientras se use
+ * la tabla.
+ */
+template <typename T>
+class PatternTable {
+	public:
+
+		static const char			Any = '*';		/// Cualquier secuencia de caracteres.
+		static const char			Escape = '%';	/// Inicio de "%n".
+		static const char			Number = 'n';	/// Uno o más dígitos (tras "%").
+
+		/**
+		 * Devuelve si un nombre es un patrón (tiene "*" o "%n").
+		 *
+		 * @param StringRef name Nombre.
+		 * @return bool True si es un patrón.
+		 */
+		static bool isPattern(const StringRef name) {
+			for(size_t i = 0; i < name.length(); i++) {
+				if(name[i] == Any || (name[i] == Escape && i + 1 < name.length() && name[i + 1] == Number)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+
+		/**
+		 * Tipo de pieza de un patrón.
+		 */
+		enum PieceType {
+			PieceLiteral,		/// Texto literal.
+			PieceAny,			/// "*".
+			PieceNumber			/// "%n".
+		};
+
+		/**
+		 * Pieza de un patrón.
+		 */
+		struct Piece {
+			PieceType		type;		/// Tipo.
+			StringRef		literal;	/// Texto (si es PieceLiteral).
+		};
+
+		/**
+		 * Patrón compilado.
+		 */
+		struct Pattern {
+			size_t			first;		/// Primera pieza en fPieces.
+			size_t			count;		/// Número de piezas.
+			bool			any;		/// Si tiene "*".
+			size_t			literals;	/// Número de caracteres literales.
+			size_t			order;		/// Posición al añadirlo.
+			T				value;		/// Valor.
+		};
+
+		/**
+		 * Ordena de más a menos concreto.
+		 */
+		struct MoreSpecific {
+			bool operator () (const Pattern& a, const Pattern& b) const {
+				if(a.any != b.any) {
+					return !a.any;
+				}
+				return a.literals != b.literals ? a.literals > b.literals : a.order < b.order;
+			}
+		};
+
+		std::vector<Piece>			fPieces;	/// Piezas de todos los patrones, seguidas.
+		std::vector<Pattern>		fPatterns;	/// Patrones ordenados.
+
+		/**
+		 * Devuelve si un patrón encaja con el nombre entero. En lugar de
+		 * volver atrás en "*" y "%n" (que con varias piezas así es
+		 * exponencial), se avanza pieza a pieza el conjunto de posiciones del
+		 * nombre a las que se puede llegar, así que el coste es del orden de
+		 * piezas por longitud del nombre.
+		 *
+		 * @param Pattern pattern Patrón.
+		 * @param StringRef name Nombre.
+		 * @param vector<char> reach Posiciones alcanzables (se reutiliza).
+		 * @param vector<char> next Posiciones de la pieza siguiente (se
+		 * reutiliza).
+		 * @return bool True si encaja.
+		 */
+		bool matches(const Pattern& pattern, const StringRef name, std::vector<char>& reach, std::vector<char>& next) const {
+			const size_t length = name.length();
+			reach.assign(length + 1, 0);
+			reach[0] = 1;
+			for(size_t piece = pattern.first; piece < pattern.first + pattern.count; piece++) {
+				const Piece& p = fPieces[piece];
+				next.assign(length + 1, 0);
+				bool any = false;
+				switch(p.type) {
+					case PieceLiteral:
+						for(size_t position = 0; position + p.literal.length() <= length; position++) {
+							if(reach[position] && name.substr(position).startsWith(p.literal)) {
+								next[position + p.literal.length()] = 1;
+								any = true;
+							}
+						}
+						break;
+					case PieceNumber: {
+						// "digits": hay una posición alcanzable seguida sólo de dígitos
+						// hasta la actual.
+						bool digits = false;
+						for(size_t position = 1; position <= length; position++) {
+							const char c = name[position - 1];
+							digits = (c >= '0' && c <= '9') && (digits || reach[position - 1]);
+							next[position] = digits;
+							any = any || digits;
+						}
+						break;
+					}
+					case PieceAny:
+					default: {
+						bool reached = false;
+						for(size_t position = 0; position <= length; position++) {
+							reached = reached || reach[position];
+							next[position] = reached;
+						}
+						any = reached;
+						break;
+					}
+				}
+				if(!any) {
+					return false;
+				}
+				reach.swap(next);
+			}
+			return reach[length] != 0;
+		}
+
+	public:
+
+		/**
+		 * Construye la tabla.
+		 *
+		 * @param StringRefs patterns Patrones.
+		 * @param vector<T> values Valores (en el mismo orden que los patrones).
+		 */
+		void build(const StringRefs& patterns, const std::vector<T>& values) {
+			fPieces.clear();
+			fPatterns.clear();
+			for(size_t i = 0; i < patterns.size(); i++) {
+				const StringRef text = patterns[i];
+				Pattern pattern = { fPieces.size(), 0, false, 0, i, values[i] };
+				size_t literal = 0;
+				for(size_t c = 0; c <= text.length(); c++) {
+					bool any = (c < text.length() && text[c] == Any);
+					bool number = (c + 1 < text.length() && text[c] == Escape && text[c + 1] == Number);
+					if(c == text.length() || any || number) {
+						if(c > literal) {
+							Piece piece = { PieceLiteral, text.substr(literal, c - literal) };
+							fPieces.push_back(piece);
+							pattern.literals += c - literal;
+						}
+						if(any || number) {
+							// Varios "*" seguidos son uno solo.
+							if(!any || fPieces.size() == pattern.first || fPieces.back().type != PieceAny) {
+								Piece piece = { any ? PieceAny : PieceNumber, StringRef() };
+								fPieces.push_back(piece);
+							}
+							pattern.any = pattern.any || any;
+							c += (number ? 1 : 0);
+						}
+						literal = c + 1;
+					}
+				}
+				pattern.count = fPieces.size() - pattern.first;
+				fPatterns.push_back(pattern);
+			}
+			std::stable_sort(fPatterns.begin(), fPatterns.end(), MoreSpecific());
+		}
+
+		/**
+		 * Busca el primer patrón que encaja con un nombre.
+		 *
+		 * @param StringRef name Nombre (sin guiones).
+		 * @param T& value Dónde se deja el valor del patrón.
+		 * @return bool True si alguno encaja.
+		 */
+		bool find(const StringRef name, T& value) const {
+			std::vector<char> reach;
+			std::vector<char> next;
+			for(size_t i = 0; i < fPatterns.size(); i++) {
+				if(matches(fPatterns[i], name, reach, next)) {
+					value = fPatterns[i].value;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Devuelve si la tabla está vacía.
+		 *
+		 * @return bool True si no hay patrones.
+		 */
+		bool empty() const { return fPatterns.empty(); }
+};
+
+template <typename T> const char PatternTable<T>::Any;
+template <typename T> const char PatternTable<T>::Escape;
+template <typename T> const char PatternTable<T>::Number;
+
+}	// namespace clipp
+
+#endif /* PATTERNTABLE_HPP_ */
@@ -0,0 +1,147 @@
+/*
+ * PerfectHash.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef PERFECTHASH_HPP_
+#define PERFECTHASH_HPP_
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Tabla hash perfecta y mínima (sin colisiones y sin huecos) construida a
+ * partir de un conjunto de claves conocido de antemano, con el método
+ * "hash y desplazamiento": cada clave cae primero en un cubo y cada cubo
+ * tiene un desplazamiento (semilla) elegido al construir la tabla para que
+ * todas sus claves vayan a posiciones libres.
+ *
+ * Una búsqueda son dos pasadas de FNV-1a sobre la clave y una comparación;
+ * no reserva memoria. Las claves no se copian: tienen que seguir siendo
+ * válidas mientras se use la tabla.
+ */
+template <typename T>
+class PerfectHash {
+	private:
+		std::vector<unsigned int>	fSeeds;		/// Desplazamiento de cada cubo.
+		std::vector<StringRef>		fKeys;		/// Claves por posición.
+		std::vector<T>				fValues;	/// Valores por posición.
+
+		/**
+		 * Función hash FNV-1a con semilla.
+		 *
+		 * @param StringRef key Clave.
+		 * @param uint seed Semilla.
+		 * @return uint Valor hash.
+		 */
+		static unsigned int hash(const StringRef key, unsigned int seed) {
+			unsigned int h = 2166136261u ^ (seed * 0x9e3779b9u);
+			for(size_t i = 0; i < key.length(); i++) {
+				h = (h ^ static_cast<unsigned char>(key[i])) * 16777619u;
+			}
+			return h ^ (h >> 15);
+		}
+
+		/**
+		 * Ordena los cubos de mayor a menor número de claves.
+		 */
+		struct BiggerBucket {
+			bool operator () (const std::vector<size_t>* a, const std::vector<size_t>* b) const {
+				return a->size() > b->size();
+			}
+		};
+
+	public:
+
+		/**
+		 * Construye la tabla. Las claves tienen que ser distintas.
+		 *
+		 * @param StringRefs keys Claves.
+		 * @param vector<T> values Valores (en el mismo orden que las claves).
+		 */
+		void build(const StringRefs& keys, const std::vector<T>& values) {
+			size_t count = keys.size();
+			fSeeds.assign(count, 0);
+			fKeys.assign(count, StringRef());
+			fValues.assign(count, T());
+			if(count == 0) {
+				return;
+			}
+
+			std::vector< std::vector<size_t> > buckets(count);
+			for(size_t i = 0; i < count; i++) {
+				buckets[hash(keys[i], 0) % count].push_back(i);
+			}
+			std::vector<const std::vector<size_t>*> order;
+			for(size_t b = 0; b < count; b++) {
+				order.push_back(&buckets[b]);
+			}
+			std::stable_sort(order.begin(), order.end(), BiggerBucket());
+
+			std::vector<bool> used(count, false);
+			std::vector<size_t> positions;
+			for(size_t b = 0; b < order.size() && !order[b]->empty(); b++) {
+				const std::vector<size_t>& bucket = *order[b];
+				// Se busca una semilla con la que todas las claves del cubo caigan en posiciones libres y distintas.
+				for(unsigned int seed = 1; ; seed++) {
+					positions.clear();
+					size_t k = 0;
+					for(; k < bucket.size(); k++) {
+						size_t position = hash(keys[bucket[k]], seed) % count;
+						if(used[position] || std::find(positions.begin(), positions.end(), position) != positions.end()) {
+							break;
+						}
+						positions.push_back(position);
+					}
+					if(k == bucket.size()) {
+						fSeeds[hash(keys[bucket[0]], 0) % count] = seed;
+						for(k = 0; k < bucket.size(); k++) {
+							used[positions[k]] = true;
+							fKeys[positions[k]] = keys[bucket[k]];
+							fValues[positions[k]] = values[bucket[k]];
+						}
+						break;
+					}
+				}
+			}
+		}
+
+		/**
+		 * Busca una clave.
+		 *
+		 * @param StringRef key Clave.
+		 * @param T notFound Valor a devolver si no existe.
+		 * @return T Valor asociado o "notFound".
+		 */
+		T find(const StringRef key, T notFound) const {
+			size_t count = fKeys.size();
+			if(count == 0) {
+				return notFound;
+			}
+			size_t position = hash(key, fSeeds[hash(key, 0) % count]) % count;
+			const StringRef& candidate = fKeys[position];
+			if(candidate.length() == key.length() && std::memcmp(candidate.data(), key.data(), key.length()) == 0) {
+				return fValues[position];
+			}
+			return notFound;
+		}
+
+		/**
+		 * Devuelve el número de claves.
+		 *
+		 * @return size_t Número de claves.
+		 */
+		size_t size() const { return fKeys.size(); }
+};
+
+}	// namespace clipp
+
+#endif /* PERFECTHASH_HPP_ */
@@ -0,0 +1,209 @@
+/*
+ * PrefixTrie.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef PREFIXTRIE_HPP_
+#define PREFIXTRIE_HPP_
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Árbol de prefijos compilado a partir de un conjunto de claves conocido de
+ * antemano, para buscar la clave que empieza por un prefijo (abreviaturas).
+ * Cada nodo guarda el valor de todas las claves que cuelgan de él si es el
+ * mismo para todas (varias claves con el mismo valor, como el nombre y el
+ * alias de una opción, no son ambiguas), así que una búsqueda sólo recorre
+ * el prefijo: los hijos de cada nodo están juntos y ordenados por carácter
+ * y se buscan por bisección. No reserva memoria al buscar. Las claves no se
+ * copian: tienen que seguir siendo válidas mientras se use el árbol.
+ */
+template <typename T>
+class PrefixTrie {
+	public:
+
+		/**
+		 * Resultado de una búsqueda.
+		 */
+		enum Match {
+			MatchNone,			/// Ninguna clave empieza por el prefijo.
+			MatchUnique,		/// Todas las que empiezan por el prefijo tienen el mismo valor.
+			MatchAmbiguous		/// Hay claves con valores distintos.
+		};
+
+	private:
+
+		/**
+		 * Nodo del árbol.
+		 */
+		struct Node {
+			unsigned int	firstChild;		/// Posición del primer hijo en fNodes.
+			unsigned short	children;		/// Número de hijos (seguidos y ordenados por carácter).
+			unsigned char	character;		/// Carácter del arco que llega al nodo.
+			bool			unique;			/// Si todas las claves de debajo tienen el mismo valor.
+			T				value;			/// Ese valor (si "unique").
+		};
+
+		/**
+		 * Rango de claves ordenadas con el mismo prefijo (al construir).
+		 */
+		struct Range {
+			unsigned int	node;			/// Nodo del prefijo.
+			size_t			begin;			/// Primera clave.
+			size_t			end;			/// Siguiente a la última clave.
+			size_t			depth;			/// Longitud del prefijo.
+		};
+
+		/**
+		 * Ordena las posiciones de las claves por su clave.
+		 */
+		struct ByKey {
+			const StringRefs* keys;
+			bool operator () (size_t a, size_t b) const {
+				return (*keys)[a] < (*keys)[b];
+			}
+		};
+
+		std::vector<Node>			fNodes;		/// Nodos (el cero es la raíz).
+		StringRefs					fKeys;		/// Claves ordenadas.
+		std::vector<T>				fValues;	/// Valores (en el orden de fKeys).
+
+		/**
+		 * Devuelve si todas las claves de un rango tienen el mismo valor.
+		 */
+		bool sameValue(size_t begin, size_t end) const {
+			for(size_t i = begin + 1; i < end; i++) {
+				if(!(fValues[i] == fValues[begin])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	public:
+
+		/**
+		 * Construye el árbol. Las claves tienen que ser distintas.
+		 *
+		 * @param StringRefs keys Claves.
+		 * @param vector<T> values Valores (en el mismo orden que las claves).
+		 */
+		void build(const StringRefs& keys, const std::vector<T>& values) {
+			std::vector<size_t> order(keys.size());
+			for(size_t i = 0; i < order.size(); i++) {
+				order[i] = i;
+			}
+			ByKey byKey = { &keys };
+			std::sort(order.begin(), order.end(), byKey);
+			fKeys.clear();
+			fValues.clear();
+			for(size_t i = 0; i < order.size(); i++) {
+				fKeys.push_back(keys[order[i]]);
+				fValues.push_back(values[order[i]]);
+			}
+
+			// Por niveles, para que los hijos de cada nodo queden seguidos.
+			fNodes.clear();
+			Node root = { 0, 0, 0, !fKeys.empty() && sameValue(0, fKeys.size()), fKeys.empty() ? T() : fValues[0] };
+			fNodes.push_back(root);
+			std::deque<Range> pending;
+			Range all = { 0, 0, fKeys.size(), 0 };
+			pending.push_back(all);
+			while(!pending.empty()) {
+				Range range = pending.front();
+				pending.pop_front();
+				fNodes[range.node].firstChild = fNodes.size();
+				size_t begin = range.begin;
+				// Las claves que terminan aquí (como mucho una) no tienen hijos.
+				while(begin < range.end && fKeys[begin].length() == range.depth) {
+					begin++;
+				}
+				while(begin < range.end) {
+					unsigned char c = fKeys[begin][range.depth];
+					size_t end = begin + 1;
+					while(end < range.end && static_cast<unsigned char>(fKeys[end][range.depth]) == c) {
+						end++;
+					}
+					bool unique = sameValue(begin, end);
+					Node node = { 0, 0, c, unique, fValues[begin] };
+					Range child = { static_cast<unsigned int>(fNodes.size()), begin, end, range.depth + 1 };
+					fNodes.push_back(node);
+					fNodes[range.node].children++;
+					pending.push_back(child);
+					begin = end;
+				}
+			}
+		}
+
+		/**
+		 * Busca el valor de las claves que empiezan por un prefijo.
+		 *
+		 * @param StringRef prefix Prefijo.
+		 * @param T& value Dónde se deja el valor (si es MatchUnique).
+		 * @return Match Resultado.
+		 */
+		Match find(const StringRef prefix, T& value) const {
+			if(fNodes.empty() || fKeys.empty()) {
+				return MatchNone;
+			}
+			unsigned int node = 0;
+			for(size_t i = 0; i < prefix.length(); i++) {
+				unsigned char c = prefix[i];
+				// Bisección entre los hijos del nodo.
+				unsigned int low = fNodes[node].firstChild;
+				unsigned int high = low + fNodes[node].children;
+				while(low < high) {
+					unsigned int middle = (low + high) / 2;
+					if(fNodes[middle].character < c) {
+						low = middle + 1;
+					} else {
+						high = middle;
+					}
+				}
+				if(low == fNodes[node].firstChild + fNodes[node].children || fNodes[low].character != c) {
+					return MatchNone;
+				}
+				node = low;
+			}
+			if(!fNodes[node].unique) {
+				return MatchAmbiguous;
+			}
+			value = fNodes[node].value;
+			return MatchUnique;
+		}
+
+		/**
+		 * Devuelve las claves que empiezan por un prefijo, ordenadas (para
+		 * los mensajes de error; recorre las claves).
+		 *
+		 * @param StringRef prefix Prefijo.
+		 * @param StringRefs& keys Dónde se añaden las claves.
+		 * @param vector<T>& values Dónde se añaden sus valores.
+		 */
+		void candidates(const StringRef prefix, StringRefs& keys, std::vector<T>& values) const {
+			for(StringRefs::const_iterator it = std::lower_bound(fKeys.begin(), fKeys.end(), prefix); it != fKeys.end() && it->startsWith(prefix); ++it) {
+				keys.push_back(*it);
+				values.push_back(fValues[it - fKeys.begin()]);
+			}
+		}
+
+		/**
+		 * Devuelve el número de claves.
+		 *
+		 * @return size_t Número de claves.
+		 */
+		size_t size() const { return fKeys.size(); }
+};
+
+}	// namespace clipp
+
+#endif /* PREFIXTRIE_HPP_ */
@@ -0,0 +1,118 @@
+/*
+ * ResponseFile.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef RESPONSEFILE_HPP_
+#define RESPONSEFILE_HPP_
+
+#include <string>
+
+#include <sys/types.h>
+
+using std::string;
+
+#include <cli++/Arena.hpp>
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Fichero de respuestas ("@fichero"): un fichero con más elementos de la
+ * línea de comandos, separados por espacios, tabuladores o saltos de línea.
+ * Entre comillas simples no hay caracteres especiales; entre comillas
+ * dobles, "\" quita el significado especial de '"' y de "\"; fuera de las
+ * comillas, "\" quita el significado especial del carácter siguiente.
+ *
+ * El fichero se proyecta en memoria (sólo lectura) y se divide en
+ * elementos según se van pidiendo, sin copiarlos: cada elemento es una
+ * referencia a la proyección, que se comparte con la caché del sistema y no
+ * ocupa más memoria. Sólo los elementos con comillas o "\" se copian (sin
+ * ellas) a la zona de memoria del análisis.
+ *
+ * Los elementos son válidos mientras exista el objeto (y la zona).
+ */
+class ResponseFile {
+	private:
+
+		const char*			fData;		/// Inicio de la proyección (NULL si el fichero está vacío).
+		size_t				fSize;		/// Tamaño del fichero.
+		size_t				fCursor;	/// Posición del siguiente elemento.
+		dev_t				fDevice;	/// Dispositivo del fichero (para detectar ciclos).
+		ino_t				fInode;		/// Nodo del fichero (para detectar ciclos).
+		string				fPath;		/// Ruta del fichero (para los errores).
+
+		/**
+		 * Evitamos que esta clase se pueda clonar o asignar.
+		 */
+		ResponseFile(const ResponseFile&);
+		ResponseFile& operator = (const ResponseFile&);
+
+	public:
+
+		/**
+		 * Marca que indica que un elemento de la línea de comandos es un
+		 * fichero de respuestas.
+		 */
+		static const char	Marker = '@';
+
+		/**
+		 * Número máximo de ficheros de respuestas anidados.
+		 */
+		static const int	MaxDepth = 64;
+
+		/**
+		 * Constructor de la clase. Abre y proyecta el fichero.
+		 *
+		 * @param StringRef path Ruta del fichero.
+		 * @throw clipp::error::ResponseFile Si no se puede abrir o proyectar.
+		 */
+		ResponseFile(const StringRef path);
+
+		/**
+		 * Destructor de la clase. Deshace la proyección.
+		 */
+		virtual				~ResponseFile();
+
+		/**
+		 * Obtiene el siguiente elemento del fichero.
+		 *
+		 * @param StringRef& token Dónde se deja el elemento.
+		 * @param Arena& arena Dónde se copian los elementos con comillas o "\".
+		 * @return bool True si hay elemento, false si se ha llegado al final.
+		 * @throw clipp::error::ResponseFile Si hay unas comillas sin cerrar.
+		 */
+		bool				next(StringRef& token, Arena& arena);
+
+		/**
+		 * Devuelve si dos objetos son el mismo fichero (aunque se hayan
+		 * abierto con rutas diferentes).
+		 *
+		 * @param ResponseFile& rf Otro fichero de respuestas.
+		 * @return bool True si son el mismo fichero.
+		 */
+		bool				isSameFile(const ResponseFile& rf) const;
+
+		/**
+		 * Devuelve la ruta del fichero.
+		 *
+		 * @return string Ruta del fichero.
+		 */
+		const string&		path() const;
+
+		/**
+		 * Devuelve si un elemento de la línea de comandos es un fichero de
+		 * respuestas ("@" seguido de la ruta).
+		 *
+		 * @param StringRef token Elemento de la línea de comandos.
+		 * @return bool True si lo es.
+		 */
+		static bool			isResponseFile(const StringRef token);
+};
+
+}	// namespace clipp
+
+#endif /* RESPONSEFILE_HPP_ */
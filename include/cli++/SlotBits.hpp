@@ -0,0 +1,127 @@
+/*
+ * SlotBits.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef SLOTBITS_HPP_
+#define SLOTBITS_HPP_
+
+#include <climits>
+
+namespace clipp {
+
+/**
+ * Conjuntos de posiciones de definiciones (slots) como arrays de palabras
+ * de bits: el bit "slot % SlotWordBits" de la palabra "slot / SlotWordBits".
+ * Se usan para las opciones presentes en un análisis y para las
+ * restricciones compiladas del esquema, de modo que comprobarlas son unas
+ * pocas operaciones AND/OR por palabra.
+ */
+typedef unsigned long		SlotWord;
+
+static const int			SlotWordBits = sizeof(SlotWord) * CHAR_BIT;
+
+/**
+ * Devuelve el número de palabras necesarias para un número de posiciones
+ * (al menos una, para no tener nunca conjuntos vacíos).
+ *
+ * @param int slots Número de posiciones.
+ * @return int Número de palabras.
+ */
+inline int
+SlotWords(int slots) {
+	return slots > 0 ? (slots + SlotWordBits - 1) / SlotWordBits : 1;
+}
+
+/**
+ * Añade una posición al conjunto.
+ *
+ * @param SlotWord* bits Conjunto.
+ * @param int slot Posición.
+ */
+inline void
+SetSlot(SlotWord* bits, int slot) {
+	bits[slot / SlotWordBits] |= static_cast<SlotWord>(1) << (slot % SlotWordBits);
+}
+
+/**
+ * Devuelve si una posición está en el conjunto.
+ *
+ * @param SlotWord* bits Conjunto.
+ * @param int slot Posición.
+ * @return bool True si está.
+ */
+inline bool
+HasSlot(const SlotWord* bits, int slot) {
+	return (bits[slot / SlotWordBits] >> (slot % SlotWordBits)) & 1;
+}
+
+/**
+ * Devuelve la primera posición de una palabra que no es cero.
+ *
+ * @param SlotWord word Palabra (distinta de cero).
+ * @return int Índice del bit más bajo.
+ */
+inline int
+LowestBit(SlotWord word) {
+#if defined(__GNUC__)
+	return __builtin_ctzl(word);
+#else
+	int bit = 0;
+	while((word & 1) == 0) {
+		word >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+/**
+ * Devuelve la primera posición que está en los dos conjuntos, o -1.
+ *
+ * @param SlotWord* a Primer conjunto.
+ * @param SlotWord* b Segundo conjunto.
+ * @param int words Palabras de los conjuntos.
+ * @return int Posición o -1.
+ */
+inline int
+FirstCommonSlot(const SlotWord* a, const SlotWord* b, int words) {
+	for(int i = 0; i < words; i++) {
+		SlotWord word = a[i] & b[i];
+		if(word != 0) {
+			return i * SlotWordBits + LowestBit(word);
+		}
+	}
+	return -1;
+}
+
+/**
+ * Devuelve la primera posición (desde "from") del primer conjunto que no
+ * está en el segundo, o -1.
+ *
+ * @param SlotWord* a Primer conjunto.
+ * @param SlotWord* b Segundo conjunto.
+ * @param int words Palabras de los conjuntos.
+ * @param int from Primera posición que se mira.
+ * @return int Posición o -1.
+ */
+inline int
+FirstMissingSlot(const SlotWord* a, const SlotWord* b, int words, int from = 0) {
+	for(int i = from / SlotWordBits; i < words; i++) {
+		SlotWord word = a[i] & ~b[i];
+		if(i == from / SlotWordBits) {
+			word &= ~static_cast<SlotWord>(0) << (from % SlotWordBits);
+		}
+		if(word != 0) {
+			return i * SlotWordBits + LowestBit(word);
+		}
+	}
+	return -1;
+}
+
+}	// namespace clipp
+
+#endif /* SLOTBITS_HPP_ */
@@ -0,0 +1,176 @@
+/*
+ * SmallVector.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef SMALLVECTOR_HPP_
+#define SMALLVECTOR_HPP_
+
+#include <cstddef>
+#include <new>
+
+#include <cli++/Arena.hpp>
+
+namespace clipp {
+
+/**
+ * Vector con almacenamiento en línea para el primer elemento. La mayoría de
+ * las opciones tienen cero o un valor, así que en ese caso no se reserva
+ * memoria dinámica; a partir del segundo elemento el resto se guarda en un
+ * array que crece según se necesita.
+ *
+ * Si se le pasa una Arena, el array se reserva en ella (y sólo se libera si
+ * es una reserva grande, ver Arena::deallocate()); en ese caso T no puede
+ * necesitar destructor.
+ */
+template <typename T>
+class SmallVector {
+	private:
+		size_t				fSize;		/// Número de elementos.
+		size_t				fCapacity;	/// Capacidad de fRest.
+		T					fFirst;		/// Primer elemento (en línea).
+		T*					fRest;		/// Resto de elementos (se crea bajo demanda).
+		Arena*				fArena;		/// Zona de memoria para fRest (o NULL para usar "new").
+
+		/**
+		 * Reserva un array de "count" elementos.
+		 *
+		 * @param size_t count Número de elementos.
+		 * @return T* Array.
+		 */
+		T*				allocate(size_t count) {
+			if(fArena == NULL) {
+				return new T[count];
+			}
+			T* data = static_cast<T*>(fArena->allocate(count * sizeof(T)));
+			for(size_t i = 0; i < count; i++) {
+				new(data + i) T();
+			}
+			return data;
+		}
+
+		/**
+		 * Libera el array (en una Arena, sólo si es una reserva grande).
+		 */
+		void			deallocate() {
+			if(fArena == NULL) {
+				delete[] fRest;
+			} else if(fRest != NULL) {
+				fArena->deallocate(fRest, fCapacity * sizeof(T));
+			}
+			fRest = NULL;
+			fCapacity = 0;
+		}
+
+	public:
+
+		/**
+		 * Constructor por defecto de la clase.
+		 *
+		 * @param Arena* arena Zona de memoria o NULL.
+		 */
+		SmallVector(Arena* arena = NULL) : fSize(0), fCapacity(0), fFirst(), fRest(NULL), fArena(arena) {}
+
+		/**
+		 * Constructor de copia de la clase. La copia usa la misma zona de
+		 * memoria que el original.
+		 *
+		 * @param SmallVector& sv Vector a copiar.
+		 */
+		SmallVector(const SmallVector& sv)
+			: fSize(0),
+			  fCapacity(0),
+			  fFirst(),
+			  fRest(NULL),
+			  fArena(sv.fArena)
+		{
+			*this = sv;
+		}
+
+		/**
+		 * Destructor de la clase.
+		 */
+		~SmallVector() {
+			deallocate();
+		}
+
+		/**
+		 * Operador de asignación.
+		 *
+		 * @param SmallVector& sv Vector a asignar.
+		 * @return SmallVector& El vector asignado.
+		 */
+		SmallVector& operator = (const SmallVector& sv) {
+			if(this == &sv) {
+				return *this;
+			}
+			clear();
+			for(size_t i = 0; i < sv.size(); i++) {
+				push_back(sv[i]);
+			}
+			return *this;
+		}
+
+		/**
+		 * Devuelve el número de elementos.
+		 *
+		 * @return size_t Número de elementos.
+		 */
+		size_t			size() const { return fSize; }
+
+		/**
+		 * Devuelve si no hay elementos.
+		 *
+		 * @return bool True si está vacío.
+		 */
+		bool			empty() const { return fSize == 0; }
+
+		/**
+		 * Añade un elemento al final.
+		 *
+		 * @param T value Elemento a añadir.
+		 */
+		void			push_back(const T& value) {
+			if(fSize == 0) {
+				fFirst = value;
+			} else {
+				if(fSize - 1 == fCapacity) {
+					size_t capacity = (fCapacity == 0 ? 4 : fCapacity * 2);
+					T* data = allocate(capacity);
+					for(size_t i = 0; i < fCapacity; i++) {
+						data[i] = fRest[i];
+					}
+					deallocate();
+					fRest = data;
+					fCapacity = capacity;
+				}
+				fRest[fSize - 1] = value;
+			}
+			fSize++;
+		}
+
+		/**
+		 * Elimina todos los elementos. La memoria ya reservada se conserva
+		 * para reutilizarla.
+		 */
+		void			clear() {
+			fFirst = T();
+			fSize = 0;
+		}
+
+		/**
+		 * Devuelve un elemento dado su índice (no se comprueban los límites).
+		 *
+		 * @param size_t index Índice del elemento.
+		 * @return T& Elemento.
+		 */
+		T&				operator [] (size_t index) { return index == 0 ? fFirst : fRest[index - 1]; }
+		const T&		operator [] (size_t index) const { return index == 0 ? fFirst : fRest[index - 1]; }
+};
+
+}	// namespace clipp
+
+#endif /* SMALLVECTOR_HPP_ */
@@ -0,0 +1,544 @@
+/*
+ * StaticParser.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef STATICPARSER_HPP_
+#define STATICPARSER_HPP_
+
+#if __cplusplus >= 201103L
+
+#include <cfloat>
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using std::string;
+
+#include <cli++/Exceptions.hpp>
+#include <cli++/SmallVector.hpp>
+#include <cli++/StringRef.hpp>
+#include <cli++/Utils.hpp>
+#include <cli++/ValueParser.hpp>
+
+namespace clipp {
+
+/**
+ * Esquema de opciones en tiempo de compilación (requiere C++11). Cada
+ * opción es un tipo que hereda de StaticOption e indica su nombre con una
+ * función constexpr:
+ *
+ *   struct Verbose : clipp::StaticOption<bool, clipp::StaticMultiple, 'v'> {
+ *       static constexpr const char* name() { return "verbose"; }
+ *   };
+ *   struct Threads : clipp::StaticOption<int, clipp::StaticNone, 't'> {
+ *       static constexpr const char* name() { return "threads"; }
+ *   };
+ *
+ *   clipp::StaticParser<Verbose, Threads> parser;
+ *   parser.process(argc, argv);
+ *   int threads = parser.get<Threads>();
+ *
+ * El compilador genera un analizador específico: las opciones cortas se
+ * comparan con constantes (que el compilador convierte en un "switch"),
+ * las largas se comparan primero por un hash calculado en compilación y
+ * los argumentos se convierten y se guardan directamente en el tipo de
+ * cada opción. Los errores son las mismas excepciones, con los mismos
+ * mensajes, que los de OptionManager; como los argumentos se convierten
+ * al leerlos, si una línea de comandos tiene varios errores el primero
+ * que se informa puede ser otro.
+ *
+ * Las opciones de tipo bool no tienen argumento (su valor es si están, o
+ * false con el prefijo "no-"); el resto lo tiene obligatorio. Los tipos
+ * de argumento son int, long, float, double, StringRef (referencia a
+ * "argv", sin copia) y string. Las opciones múltiples con argumento
+ * guardan todos los valores en un SmallVector.
+ */
+
+/**
+ * Características de una opción en tiempo de compilación (se combinan con
+ * "|").
+ */
+enum StaticFlags {
+	StaticNone			= 0,		/// Sin características.
+	StaticRequired		= 1 << 0,	/// Obligatoria.
+	StaticMultiple		= 1 << 1,	/// Puede aparecer varias veces.
+	StaticExclusive		= 1 << 2	/// Exclusiva (no puede haber otras).
+};
+
+/**
+ * Base de las opciones en tiempo de compilación.
+ *
+ * @param T Tipo del valor de la opción.
+ * @param Flags Características (StaticFlags).
+ * @param Short Alias de un carácter ('\0' si no tiene).
+ */
+template <typename T, unsigned Flags = StaticNone, char Short = '\0'>
+struct StaticOption {
+	typedef T						Type;
+	static constexpr unsigned		flags = Flags;
+	static constexpr char			shortName = Short;
+};
+
+/**
+ * Hash FNV-1a de un nombre, en tiempo de compilación y de ejecución (dan
+ * el mismo valor).
+ *
+ * @param char* name Nombre.
+ * @param StringRef name Nombre.
+ * @return uint Hash.
+ */
+constexpr unsigned
+StaticNameHash(const char* name, unsigned hash = 2166136261u) {
+	return *name == '\0' ? hash : StaticNameHash(name + 1, (hash ^ static_cast<unsigned char>(*name)) * 16777619u);
+}
+
+inline unsigned
+StaticNameHash(const StringRef name) {
+	unsigned hash = 2166136261u;
+	for(size_t i = 0; i < name.length(); i++) {
+		hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * Longitud de un nombre en tiempo de compilación.
+ */
+constexpr size_t
+StaticNameLength(const char* name) {
+	return *name == '\0' ? 0 : 1 + StaticNameLength(name + 1);
+}
+
+/**
+ * Conversión y guardado de los argumentos según el tipo de la opción. Si
+ * el argumento no es correcto se lanza la misma excepción que en
+ * OptionDefinition::checkArgumentType().
+ */
+template <typename T>
+struct StaticType;
+
+template <>
+struct StaticType<bool> {
+	static constexpr bool	hasArgument = false;
+};
+
+template <>
+struct StaticType<int> {
+	static constexpr bool	hasArgument = true;
+	static bool				parse(const StringRef text, int& value) {
+		long parsed;
+		if(!ParseInteger(text, parsed, INT_MIN, INT_MAX)) {
+			return false;
+		}
+		value = static_cast<int>(parsed);
+		return true;
+	}
+	static const char*		kind() { return "an integer"; }
+};
+
+template <>
+struct StaticType<long> {
+	static constexpr bool	hasArgument = true;
+	static bool				parse(const StringRef text, long& value) { return ParseInteger(text, value); }
+	static const char*		kind() { return "an integer"; }
+};
+
+template <>
+struct StaticType<float> {
+	static constexpr bool	hasArgument = true;
+	static bool				parse(const StringRef text, float& value) {
+		double parsed;
+		if(!ParseReal(text, parsed, FLT_MAX)) {
+			return false;
+		}
+		value = static_cast<float>(parsed);
+		return true;
+	}
+	static const char*		kind() { return "a float"; }
+};
+
+template <>
+struct StaticType<double> {
+	static constexpr bool	hasArgument = true;
+	static bool				parse(const StringRef text, double& value) { return ParseReal(text, value); }
+	static const char*		kind() { return "a float"; }
+};
+
+template <>
+struct StaticType<StringRef> {
+	static constexpr bool	hasArgument = true;
+	static bool				parse(const StringRef text, StringRef& value) { value = text; return true; }
+	static const char*		kind() { return "a string"; }
+};
+
+template <>
+struct StaticType<string> {
+	static constexpr bool	hasArgument = true;
+	static bool				parse(const StringRef text, string& value) { value.assign(text.data(), text.length()); return true; }
+	static const char*		kind() { return "a string"; }
+};
+
+/**
+ * Datos de una opción calculados en tiempo de compilación.
+ */
+template <typename O>
+struct StaticTraits {
+	typedef typename O::Type	Type;
+
+	static constexpr bool		hasArgument = StaticType<Type>::hasArgument;
+	static constexpr bool		isMultiple = (O::flags & StaticMultiple) != 0;
+
+	/**
+	 * El carácter por el que se busca como opción corta: su alias o su
+	 * nombre si sólo tiene un carácter.
+	 */
+	static constexpr char		shortName = O::shortName != '\0' ? O::shortName : (StaticNameLength(O::name()) == 1 ? O::name()[0] : '\0');
+
+	static constexpr unsigned	hash = StaticNameHash(O::name());
+
+	/**
+	 * Tipo en el que se guarda el valor: el de la opción o un SmallVector
+	 * si es múltiple y tiene argumento.
+	 */
+	typedef typename std::conditional<hasArgument && isMultiple, SmallVector<Type>, Type>::type	Storage;
+
+	/**
+	 * Indicador ("-" o "--") del nombre, como en OptionDefinition.
+	 */
+	static const char*			indicator() { return StaticNameLength(O::name()) > 1 ? "--" : "-"; }
+};
+
+/**
+ * Posición de un tipo en una lista de tipos.
+ */
+template <typename O, typename... Options>
+struct StaticIndexOf;
+
+template <typename O, typename... Rest>
+struct StaticIndexOf<O, O, Rest...> {
+	static constexpr size_t	value = 0;
+};
+
+template <typename O, typename First, typename... Rest>
+struct StaticIndexOf<O, First, Rest...> {
+	static constexpr size_t	value = 1 + StaticIndexOf<O, Rest...>::value;
+};
+
+/**
+ * Analizador de la línea de comandos generado para unas opciones. Guarda
+ * el resultado del último análisis; se puede reutilizar.
+ */
+template <typename... Options>
+class StaticParser {
+	private:
+		static_assert(sizeof...(Options) > 0, "StaticParser needs at least one option.");
+
+		static constexpr size_t		Count = sizeof...(Options);
+
+		typedef std::tuple<Options...>										OptionTypes;
+		typedef std::tuple<typename StaticTraits<Options>::Storage...>		Values;
+
+		template <size_t I>
+		struct At {
+			typedef typename std::tuple_element<I, OptionTypes>::type	Type;
+			typedef StaticTraits<Type>									Traits;
+		};
+
+		/**
+		 * Marca para recorrer las opciones en tiempo de compilación.
+		 */
+		template <size_t I>
+		struct Tag {};
+
+		Values						fValues;				/// Valores de las opciones.
+		unsigned					fOccurrences[Count];	/// Apariciones de cada opción.
+		std::vector<StringRef>		fArguments;				/// Argumentos posicionales (referencias a "argv").
+		int							fArgc;					/// Contador de argumentos.
+		char**						fArgv;					/// Argumentos.
+		int							fIndex;					/// Primer elemento de "argv" sin procesar.
+
+		static bool					isOption(const StringRef option) {
+			return (option.length() > 1 && option[0] == '-' && option[1] != '-') || (option.length() > 2 && option[0] == '-' && option[1] == '-');
+		}
+
+		/**
+		 * Añade una aparición de la opción I con su argumento.
+		 */
+		template <size_t I>
+		void						add(const StringRef argument, bool isNegated) {
+			typedef typename At<I>::Type	O;
+			typedef typename At<I>::Traits	Traits;
+			if(fOccurrences[I] > 0 && !Traits::isMultiple) {
+				throw clipp::error::MultipleOption("Multiple option not allowed: " + string(Traits::indicator()) + O::name(), O::name());
+			}
+			fOccurrences[I]++;
+			store<I>(argument, isNegated, std::integral_constant<bool, Traits::hasArgument>(), std::integral_constant<bool, Traits::hasArgument && Traits::isMultiple>());
+		}
+
+		template <size_t I>
+		void						store(const StringRef, bool isNegated, std::false_type, std::false_type) {
+			std::get<I>(fValues) = !isNegated;
+		}
+
+		template <size_t I>
+		void						store(const StringRef argument, bool, std::true_type, std::false_type) {
+			convert<I>(argument, std::get<I>(fValues));
+		}
+
+		template <size_t I>
+		void						store(const StringRef argument, bool, std::true_type, std::true_type) {
+			typename At<I>::Traits::Type value;
+			convert<I>(argument, value);
+			std::get<I>(fValues).push_back(value);
+		}
+
+		template <size_t I>
+		static void					convert(const StringRef argument, typename At<I>::Traits::Type& value) {
+			typedef typename At<I>::Type	O;
+			typedef typename At<I>::Traits	Traits;
+			if(!StaticType<typename Traits::Type>::parse(argument, value)) {
+				throw clipp::error::InvalidArgument("Argument for option '" + string(Traits::indicator()) + O::name() + "' must be " +
+						StaticType<typename Traits::Type>::kind() + ": " + argument.str(), O::name());
+			}
+		}
+
+		/**
+		 * Procesa la opción I ya decodificada: toma su argumento del
+		 * siguiente elemento si lo necesita.
+		 */
+		template <size_t I>
+		void						postProcess(const StringRef realOption, bool isNegated) {
+			if(At<I>::Traits::hasArgument) {
+				if(fIndex < fArgc && !isOption(StringRef(fArgv[fIndex]))) {
+					add<I>(StringRef(fArgv[fIndex++]), isNegated);
+				} else {
+					throw clipp::error::RequiredArgument("Argument required for option: " + string(realOption.length() == 1 ? "-" : "--") + realOption.str(), realOption.str());
+				}
+			} else {
+				add<I>(StringRef(), isNegated);
+			}
+		}
+
+		/**
+		 * Busca una opción por su carácter. Devuelve false si no existe.
+		 */
+		bool						matchShort(char, const StringRef, Tag<Count>) { return false; }
+
+		template <size_t I>
+		bool						matchShort(char c, const StringRef op, Tag<I>) {
+			if(At<I>::Traits::shortName != '\0' && c == At<I>::Traits::shortName) {
+				decodeShortFound<I>(op);
+				return true;
+			}
+			return matchShort(c, op, Tag<I + 1>());
+		}
+
+		/**
+		 * Procesa una opción corta encontrada: sola ("-v"), con el argumento
+		 * pegado ("-ofile") o seguida de otras opciones cortas ("-vq").
+		 */
+		template <size_t I>
+		void						decodeShortFound(const StringRef op) {
+			if(op.length() == 1) {
+				postProcess<I>(op, false);
+			} else if(At<I>::Traits::hasArgument) {
+				add<I>(op.substr(1), false);
+			} else {
+				add<I>(StringRef(), false);
+				decodeShort(op.substr(1), op.substr(1));
+			}
+		}
+
+		void						decodeShort(const StringRef option, const StringRef op) {
+			if(!matchShort(op[0], op, Tag<0>())) {
+				throw clipp::error::InvalidOption("Invalid option: " + option.str(), option.str());
+			}
+		}
+
+		/**
+		 * Busca una opción por su nombre (o su alias de un carácter) y la
+		 * procesa. Devuelve false si no existe.
+		 */
+		bool						matchLong(const StringRef, unsigned, const StringRef, bool, bool, Tag<Count>) { return false; }
+
+		template <size_t I>
+		bool						matchLong(const StringRef name, unsigned hash, const StringRef argument, bool hasArgument, bool isNegated, Tag<I>) {
+			typedef typename At<I>::Type	O;
+			typedef typename At<I>::Traits	Traits;
+			if((hash == Traits::hash && name == StringRef(O::name(), StaticNameLength(O::name()))) || (name.length() == 1 && Traits::shortName != '\0' && name[0] == Traits::shortName)) {
+				if(!hasArgument) {
+					postProcess<I>(name, isNegated);
+				} else if(Traits::hasArgument) {
+					add<I>(argument, false);
+				} else {
+					throw clipp::error::InvalidArgument("Invalid argument for option: --" + name.str(), name.str());
+				}
+				return true;
+			}
+			return matchLong(name, hash, argument, hasArgument, isNegated, Tag<I + 1>());
+		}
+
+		void						decodeLong(const StringRef option) {
+			StringRef op = option.substr(2);
+			if(matchLong(op, StaticNameHash(op), StringRef(), false, false, Tag<0>())) {
+				return;
+			}
+			size_t position = option.find('=');
+			if(position != StringRef::npos) {
+				StringRef name = option.substr(2, position - 2);
+				if(!matchLong(name, StaticNameHash(name), option.substr(position + 1), true, false, Tag<0>())) {
+					throw clipp::error::InvalidOption("Invalid option: -" + name.str(), name.str());
+				}
+			} else if(op.startsWith("no-")) {
+				StringRef name = op.substr(3);
+				if(!matchLong(name, StaticNameHash(name), StringRef(), false, true, Tag<0>())) {
+					throw clipp::error::InvalidOption("Invalid option: --no-" + name.str(), name.str());
+				}
+			} else {
+				throw clipp::error::InvalidOption("Invalid option: " + option.str(), option.str());
+			}
+		}
+
+		/**
+		 * Nombres y características de las opciones, por posición.
+		 */
+		static const char*			nameAt(size_t index) {
+			static const char* const names[Count] = { Options::name()... };
+			return names[index];
+		}
+
+		static unsigned				flagsAt(size_t index) {
+			static const unsigned flags[Count] = { Options::flags... };
+			return flags[index];
+		}
+
+		static const char*			indicatorAt(size_t index) {
+			return nameAt(index)[0] != '\0' && nameAt(index)[1] != '\0' ? "--" : "-";
+		}
+
+		/**
+		 * Comprueba las opciones exclusivas y obligatorias, como
+		 * CompiledSchema::checkProcessedOptions().
+		 */
+		void						checkProcessedOptions() const {
+			size_t present = 0;
+			int exclusive = -1;
+			for(size_t i = 0; i < Count; i++) {
+				if(fOccurrences[i] > 0) {
+					present++;
+					if(exclusive < 0 && (flagsAt(i) & StaticExclusive) != 0) {
+						exclusive = i;
+					}
+				}
+			}
+			if(exclusive >= 0 && present > 1) {
+				throw clipp::error::ExclusiveOption("Option is exclusive: " + string(indicatorAt(exclusive)) + nameAt(exclusive), nameAt(exclusive));
+			}
+			if(exclusive < 0) {
+				for(size_t i = 0; i < Count; i++) {
+					if((flagsAt(i) & StaticRequired) != 0 && fOccurrences[i] == 0) {
+						throw clipp::error::RequiredOption("Option required: " + string(indicatorAt(i)) + nameAt(i), nameAt(i));
+					}
+				}
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor de la clase.
+		 */
+		StaticParser() : fValues(), fOccurrences(), fArguments(), fArgc(0), fArgv(NULL), fIndex(0) {}
+
+		/**
+		 * Procesa una línea de comandos. El resultado anterior se descarta.
+		 *
+		 * @param int argc Contador de opciones.
+		 * @param char** argv Array de char* con las opciones (tiene que
+		 * seguir siendo válido mientras se use el resultado).
+		 * @throw clipp::error::Exception Los mismos errores que
+		 * OptionManager::process().
+		 */
+		void						process(int argc, char** argv) {
+			fValues = Values();
+			for(size_t i = 0; i < Count; i++) {
+				fOccurrences[i] = 0;
+			}
+			fArguments.clear();
+			fArgc = (argv != NULL ? argc : 0);
+			fArgv = argv;
+			fIndex = 0;
+
+			// El primer elemento es el nombre del programa (argumento posicional cero).
+			if(fIndex < fArgc) {
+				fArguments.push_back(StringRef(fArgv[fIndex++]));
+			}
+			bool lastArgument = false;
+			while(fIndex < fArgc) {
+				StringRef option(fArgv[fIndex++]);
+				if(lastArgument) {
+					fArguments.push_back(option);
+				} else if(option.length() > 1 && option[0] == '-' && option[1] != '-') {
+					decodeShort(option, option.substr(1));
+				} else if(option.length() > 2 && option[0] == '-' && option[1] == '-') {
+					decodeLong(option);
+				} else if(option == StringRef("--")) {
+					lastArgument = true;
+				} else {
+					fArguments.push_back(option);
+				}
+			}
+
+			checkProcessedOptions();
+		}
+
+		/**
+		 * Devuelven si está una opción, cuántas veces y su valor.
+		 *
+		 * @return bool True si está.
+		 * @return uint Número de apariciones.
+		 * @return Storage Valor (o valores) de la opción.
+		 */
+		template <typename O>
+		bool						hasOption() const { return fOccurrences[StaticIndexOf<O, Options...>::value] > 0; }
+
+		template <typename O>
+		unsigned					occurrences() const { return fOccurrences[StaticIndexOf<O, Options...>::value]; }
+
+		template <typename O>
+		const typename StaticTraits<O>::Storage&	get() const { return std::get<StaticIndexOf<O, Options...>::value>(fValues); }
+
+		/**
+		 * Cuenta el número de argumentos.
+		 *
+		 * @return int Número de argumentos.
+		 */
+		int							countArguments() const { return fArguments.size(); }
+
+		/**
+		 * Devuelve un argumento dado su índice.
+		 *
+		 * @param int index Índice del argumento a obtener.
+		 * @return StringRef Argumento (referencia a "argv").
+		 * @throw OutOfBoundsException Si el índice es incorrecto.
+		 */
+		const StringRef				getArgument(int index) const {
+			if(index >= 0 && index < (int)fArguments.size()) {
+				return fArguments[index];
+			}
+			throw clipp::error::OutOfBounds("OptionManager: Cannot get argument at index " + StringFrom<int>(index) + ". Index out of bounds (0.." + StringFrom<int>(fArguments.size() - 1) + ").");
+		}
+};
+
+}	// namespace clipp
+
+#endif /* __cplusplus >= 201103L */
+
+#endif /* STATICPARSER_HPP_ */
@@ -0,0 +1,163 @@
+/*
+ * StringRef.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef STRINGREF_HPP_
+#define STRINGREF_HPP_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using std::string;
+
+namespace clipp {
+
+/**
+ * Referencia a una cadena que no es propiedad de esta clase (puntero y
+ * longitud). Se usa para analizar la línea de comandos sin copiar los
+ * elementos de "argv": la cadena sólo se copia (con "str()") cuando se
+ * necesita un "string" de verdad.
+ *
+ * La memoria referenciada tiene que seguir siendo válida mientras se use
+ * la referencia.
+ */
+class StringRef {
+	private:
+		const char*		fData;		/// Puntero al primer carácter.
+		size_t			fLength;	/// Longitud en caracteres.
+
+	public:
+
+		/**
+		 * Valor que indica "no encontrado" en las búsquedas.
+		 */
+		static const size_t	npos = static_cast<size_t>(-1);
+
+		/**
+		 * Constructores de la clase.
+		 *
+		 * @param char* data Cadena terminada en '\0' o puntero a los datos.
+		 * @param size_t length Longitud de los datos.
+		 * @param string str Cadena referenciada.
+		 */
+		StringRef() : fData(""), fLength(0) {}
+		StringRef(const char* data) : fData(data), fLength(std::strlen(data)) {}
+		StringRef(const char* data, size_t length) : fData(data), fLength(length) {}
+		StringRef(const string& str) : fData(str.data()), fLength(str.length()) {}
+
+		/**
+		 * Devuelve el puntero a los datos (no terminados en '\0').
+		 *
+		 * @return char* Datos.
+		 */
+		const char*		data() const { return fData; }
+
+		/**
+		 * Devuelve la longitud de la cadena.
+		 *
+		 * @return size_t Longitud.
+		 */
+		size_t			length() const { return fLength; }
+		size_t			size() const { return fLength; }
+
+		/**
+		 * Devuelve si la cadena está vacía.
+		 *
+		 * @return bool True si está vacía.
+		 */
+		bool			empty() const { return fLength == 0; }
+
+		/**
+		 * Devuelve el carácter en la posición indicada (sin comprobar límites).
+		 *
+		 * @param size_t index Posición.
+		 * @return char Carácter.
+		 */
+		char			operator [] (size_t index) const { return fData[index]; }
+
+		/**
+		 * Devuelve una subcadena sin copiar nada. Igual que "string::substr".
+		 *
+		 * @param size_t pos Posición inicial.
+		 * @param size_t count Número de caracteres (npos para el resto).
+		 * @return StringRef Subcadena.
+		 */
+		StringRef		substr(size_t pos, size_t count = npos) const {
+			if(pos > fLength) {
+				pos = fLength;
+			}
+			if(count > fLength - pos) {
+				count = fLength - pos;
+			}
+			return StringRef(fData + pos, count);
+		}
+
+		/**
+		 * Busca la primera aparición de un carácter.
+		 *
+		 * @param char c Carácter a buscar.
+		 * @return size_t Posición o npos si no se encuentra.
+		 */
+		size_t			find(char c) const {
+			const void* found = std::memchr(fData, c, fLength);
+			return found != NULL ? static_cast<const char*>(found) - fData : npos;
+		}
+
+		/**
+		 * Devuelve si la cadena empieza por el prefijo indicado.
+		 *
+		 * @param StringRef prefix Prefijo.
+		 * @return bool True si empieza por el prefijo.
+		 */
+		bool			startsWith(const StringRef& prefix) const {
+			return fLength >= prefix.fLength && std::memcmp(fData, prefix.fData, prefix.fLength) == 0;
+		}
+
+		/**
+		 * Copia la cadena referenciada en un "string".
+		 *
+		 * @return string Copia de la cadena.
+		 */
+		string			str() const { return string(fData, fLength); }
+
+		/**
+		 * Operadores de comparación.
+		 */
+		bool			operator == (const StringRef& sr) const {
+			return fLength == sr.fLength && std::memcmp(fData, sr.fData, fLength) == 0;
+		}
+		bool			operator != (const StringRef& sr) const {
+			return !(*this == sr);
+		}
+		bool			operator < (const StringRef& sr) const {
+			int result = std::memcmp(fData, sr.fData, fLength < sr.fLength ? fLength : sr.fLength);
+			return result != 0 ? result < 0 : fLength < sr.fLength;
+		}
+};
+
+/**
+ * Función hash (FNV-1a) para usar StringRef como clave en "unordered_map".
+ */
+struct StringRefHash {
+	size_t operator () (const StringRef& sr) const {
+		size_t hash = 2166136261u;
+		for(size_t i = 0; i < sr.length(); i++) {
+			hash = (hash ^ static_cast<unsigned char>(sr[i])) * 16777619u;
+		}
+		return hash;
+	}
+};
+
+/**
+ * Vector de referencias a cadenas.
+ */
+typedef std::vector<StringRef>	StringRefs;
+
+}	// namespace clipp
+
+#endif /* STRINGREF_HPP_ */
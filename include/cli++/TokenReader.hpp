@@ -0,0 +1,101 @@
+/*
+ * TokenReader.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef TOKENREADER_HPP_
+#define TOKENREADER_HPP_
+
+#include <cstddef>
+
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Lector de elementos de la línea de comandos de un descriptor (la entrada
+ * estándar, una tubería, un fichero...), separados por '\0' (como
+ * "find -print0" o "xargs -0") o por saltos de línea. Con saltos de línea,
+ * las líneas vacías no cuentan como elementos.
+ *
+ * Se lee por bloques en dos buffers que se alternan, así que la memoria no
+ * depende de cuánto se lea (sólo del elemento más largo). Cada elemento es
+ * una referencia al buffer y sigue siendo válido hasta que se vuelve a
+ * llenar ese buffer, es decir, al menos mientras se lee el siguiente
+ * elemento; lo que se quiera guardar más tiempo hay que copiarlo.
+ */
+class TokenReader {
+	private:
+
+		int					fFd;			/// Descriptor del que se lee (no se cierra).
+		char				fDelimiter;		/// Separador de los elementos.
+		char*				fBuffers[2];	/// Buffers que se alternan.
+		size_t				fSizes[2];		/// Tamaño de cada buffer.
+		int					fCurrent;		/// Buffer del que se están sacando elementos.
+		size_t				fStart;			/// Inicio de lo que queda por sacar del buffer actual.
+		size_t				fEnd;			/// Fin de lo leído en el buffer actual.
+		size_t				fChunkSize;		/// Bytes que se piden en cada lectura.
+		bool				fEof;			/// Si se ha llegado al final.
+
+		/**
+		 * Evitamos que esta clase se pueda clonar o asignar.
+		 */
+		TokenReader(const TokenReader&);
+		TokenReader& operator = (const TokenReader&);
+
+		/**
+		 * Lee el siguiente bloque en el otro buffer, pasando delante lo que
+		 * quedaba del actual (un elemento a medias).
+		 *
+		 * @throw clipp::error::Input Si falla la lectura.
+		 */
+		void				fill();
+
+	public:
+
+		/**
+		 * Bytes que se piden por defecto en cada lectura.
+		 */
+		static const size_t	DefaultChunkSize = 64 * 1024;
+
+		/**
+		 * Constructor de la clase.
+		 *
+		 * @param int fd Descriptor del que se lee.
+		 * @param char delimiter Separador de los elementos ('\0' o '\n').
+		 * @param size_t chunkSize Bytes que se piden en cada lectura.
+		 */
+		TokenReader(int fd, char delimiter = '\0', size_t chunkSize = DefaultChunkSize);
+
+		/**
+		 * Destructor de la clase. Libera los buffers (no cierra el
+		 * descriptor).
+		 */
+		virtual				~TokenReader();
+
+		/**
+		 * Obtiene el siguiente elemento, leyendo del descriptor si hace
+		 * falta.
+		 *
+		 * @param StringRef& token Dónde se deja el elemento.
+		 * @return bool True si hay elemento, false si se ha llegado al final.
+		 * @throw clipp::error::Input Si falla la lectura.
+		 */
+		bool				next(StringRef& token);
+
+		/**
+		 * Devuelve si un elemento está en los buffers de este lector (y por
+		 * tanto hay que copiarlo para guardarlo).
+		 *
+		 * @param StringRef token Elemento.
+		 * @return bool True si está en los buffers.
+		 */
+		bool				owns(const StringRef token) const;
+};
+
+}	// namespace clipp
+
+#endif /* TOKENREADER_HPP_ */
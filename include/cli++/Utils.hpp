@@ -10,11 +10,14 @@
 #define UTILS_HPP_
 
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 using std::stringstream;
 using std::ios_base;
 
+#include <cli++/ValueParser.hpp>
+
 namespace clipp {
 
 /**
@@ -36,6 +39,25 @@ StringFrom(const T value, ios_base& (*f)(ios_base&) = NULL) {
 	return result.str();
 }
 
+/**
+ * Devuelve la base numérica que corresponde a un manipulador de
+ * "ios_base" (dec, hex u oct), o cero si es otro manipulador.
+ *
+ * @param ios_base f Manipulador o NULL (base 10).
+ * @return int Base numérica o cero.
+ */
+inline int
+StreamBase(ios_base& (*f)(ios_base&)) {
+	if(f == NULL || f == std::dec) {
+		return 10;
+	} else if(f == std::hex) {
+		return 16;
+	} else if(f == std::oct) {
+		return 8;
+	}
+	return 0;
+}
+
 /**
  * Devuelve un valor (el de la plantilla) dada su cadena. Por ejemplo para
  * convertir cadenas en números:
@@ -43,6 +65,9 @@ StringFrom(const T value, ios_base& (*f)(ios_base&) = NULL) {
  * int i = StringTo<int>("42");
  * int j = StringTo<int>("0xBE05",hex);
  *
+ * Se convierte lo que se pueda del principio de la cadena, como con un
+ * "stringstream" ("42abc" es 42 y "3.5" como entero es 3).
+ *
  * @param string value El valor a convertir.
  * @param T defaultValue El valor por defecto si no se puede convertir.
  * @param ios_base f Una base en caso de usar números.
@@ -62,11 +87,8 @@ StringTo(const string value, T defaultValue, ios_base& (*f)(ios_base&) = NULL) {
 }
 
 /**
- * Comprueba si una cadena dada es del tipo de dato indicado en T. Por ejemplo,
- * para saber si una cadena contiene un número.
- *
- * bool isNumeric = StringIs<int>("42");	// true
- * bool isNumber = StringIs<int>("42a");	// false
+ * Comprueba con un "stringstream" si una cadena entera es del tipo de dato
+ * indicado en T.
  *
  * @param string value El valor a comprobar.
  * @param ios_base f Una base en caso de que sea numérico.
@@ -74,7 +96,7 @@ StringTo(const string value, T defaultValue, ios_base& (*f)(ios_base&) = NULL) {
  */
 template <typename T>
 bool
-StringIs(const string value, ios_base& (*f)(ios_base&) = NULL) {
+StreamIs(const string value, ios_base& (*f)(ios_base&) = NULL) {
 	stringstream iss(value);
 	T result;
 	if(f == NULL) {
@@ -85,6 +107,33 @@ StringIs(const string value, ios_base& (*f)(ios_base&) = NULL) {
 	return !iss.fail() && iss.rdbuf()->in_avail() <= 0;
 }
 
+/**
+ * Comprueba si una cadena dada es del tipo de dato indicado en T. Por ejemplo,
+ * para saber si una cadena contiene un número.
+ *
+ * bool isNumeric = StringIs<int>("42");	// true
+ * bool isNumber = StringIs<int>("42a");	// false
+ *
+ * Los enteros con signo y los reales se comprueban con ParseValue(), sin
+ * reservar memoria (acepta lo mismo que un "stringstream"). Los enteros sin
+ * signo y los booleanos ("0" y "1"), con un "stringstream", que acepta
+ * también los negativos en los sin signo ("-1").
+ *
+ * @param string value El valor a comprobar.
+ * @param ios_base f Una base en caso de que sea numérico.
+ * @return bool True si es correcto, false en otro caso.
+ */
+template <typename T>
+bool
+StringIs(const string value, ios_base& (*f)(ios_base&) = NULL) {
+	T result;
+	int base = StreamBase(f);
+	if(base != 0 && (std::numeric_limits<T>::is_signed || !std::numeric_limits<T>::is_integer)) {
+		return ParseValue(StringRef(value), result, base);
+	}
+	return StreamIs<T>(value, f);
+}
+
 /**
  * Clase rango. Esta clase representa un rango de dos valores: mínimo y máximo.
  */
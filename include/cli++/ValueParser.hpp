@@ -0,0 +1,129 @@
+/*
+ * ValueParser.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef VALUEPARSER_HPP_
+#define VALUEPARSER_HPP_
+
+#include <climits>
+#include <cfloat>
+#include <sstream>
+
+#include <cli++/StringRef.hpp>
+
+namespace clipp {
+
+/**
+ * Valor de un argumento ya convertido al tipo de su opción. Se guarda junto
+ * al texto para no tener que volver a convertirlo.
+ */
+struct TypedValue {
+	union {
+		long	integer;	/// Valor de las opciones TypeInteger.
+		double	real;		/// Valor de las opciones TypeFloat.
+		bool	boolean;	/// Valor de las opciones TypeBoolean.
+	};
+	int			index;		/// Posición en las cadenas válidas de la opción, o -1.
+};
+
+/**
+ * Funciones de conversión de cadenas a números. No reservan memoria, no
+ * dependen del "locale" (el separador decimal es siempre '.') y detectan el
+ * desbordamiento de forma exacta: un valor que no cabe en el tipo no es
+ * válido. Como con "stringstream", se permiten espacios al principio pero
+ * no al final.
+ *
+ * @param StringRef text Texto a convertir.
+ * @param long/ulong/double value Donde se deja el valor convertido (sólo si
+ * es correcto).
+ * @param long/ulong/double min, max Rango del tipo de destino.
+ * @param int base Base numérica (8, 10 ó 16; en base 16 se permite el
+ * prefijo "0x").
+ * @return bool True si el texto es un número válido, false en otro caso.
+ */
+bool	ParseInteger(const StringRef text, long& value, long min = LONG_MIN, long max = LONG_MAX, int base = 10);
+bool	ParseUnsigned(const StringRef text, unsigned long& value, unsigned long max = ULONG_MAX, int base = 10);
+bool	ParseReal(const StringRef text, double& value, double max = DBL_MAX);
+
+/**
+ * Convierte una cadena a booleano sin distinguir mayúsculas de minúsculas:
+ * "true", "yes", "on" y "1" son verdadero y "false", "no", "off" y "0" son
+ * falso.
+ *
+ * @param StringRef text Texto a convertir.
+ * @param bool value Donde se deja el valor convertido.
+ * @return bool True si el texto es un booleano válido, false en otro caso.
+ */
+bool	ParseBoolean(const StringRef text, bool& value);
+
+/**
+ * Convierte una cadena al tipo del segundo parámetro. Para los tipos
+ * numéricos y booleanos se usan las funciones anteriores; para el resto
+ * se usa un "stringstream".
+ *
+ * @param StringRef text Texto a convertir.
+ * @param T value Donde se deja el valor convertido.
+ * @param int base Base numérica.
+ * @return bool True si se ha podido convertir, false en otro caso.
+ */
+template <typename T>
+bool
+ParseValue(const StringRef text, T& value, int base = 10) {
+	std::stringstream iss(text.str());
+	if(base == 16) {
+		iss >> std::hex;
+	} else if(base == 8) {
+		iss >> std::oct;
+	}
+	iss >> value;
+	return !iss.fail() && iss.rdbuf()->in_avail() <= 0;
+}
+
+template <typename T>
+inline bool
+ParseSignedValue(const StringRef text, T& value, long min, long max, int base) {
+	long result;
+	if(!ParseInteger(text, result, min, max, base)) {
+		return false;
+	}
+	value = static_cast<T>(result);
+	return true;
+}
+
+template <typename T>
+inline bool
+ParseUnsignedValue(const StringRef text, T& value, unsigned long max, int base) {
+	unsigned long result;
+	if(!ParseUnsigned(text, result, max, base)) {
+		return false;
+	}
+	value = static_cast<T>(result);
+	return true;
+}
+
+inline bool ParseValue(const StringRef text, short& value, int base = 10) { return ParseSignedValue(text, value, SHRT_MIN, SHRT_MAX, base); }
+inline bool ParseValue(const StringRef text, int& value, int base = 10) { return ParseSignedValue(text, value, INT_MIN, INT_MAX, base); }
+inline bool ParseValue(const StringRef text, long& value, int base = 10) { return ParseInteger(text, value, LONG_MIN, LONG_MAX, base); }
+inline bool ParseValue(const StringRef text, unsigned short& value, int base = 10) { return ParseUnsignedValue(text, value, USHRT_MAX, base); }
+inline bool ParseValue(const StringRef text, unsigned int& value, int base = 10) { return ParseUnsignedValue(text, value, UINT_MAX, base); }
+inline bool ParseValue(const StringRef text, unsigned long& value, int base = 10) { return ParseUnsigned(text, value, ULONG_MAX, base); }
+inline bool ParseValue(const StringRef text, double& value, int = 10) { return ParseReal(text, value, DBL_MAX); }
+inline bool ParseValue(const StringRef text, bool& value, int = 10) { return ParseBoolean(text, value); }
+
+inline bool
+ParseValue(const StringRef text, float& value, int = 10) {
+	double result;
+	if(!ParseReal(text, result, FLT_MAX)) {
+		return false;
+	}
+	value = static_cast<float>(result);
+	return true;
+}
+
+}	// namespace clipp
+
+#endif /* VALUEPARSER_HPP_ */
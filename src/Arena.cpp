@@ -0,0 +1,146 @@
+/*
+ * Arena.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <cstdlib>
+
+#include "../include/cli++/Arena.hpp"
+
+namespace clipp {
+
+/**
+ * Tamaño de la cabecera de los bloques, redondeado a la alineación para que
+ * los datos empiecen alineados.
+ */
+static size_t
+header_size() {
+	return ((sizeof(void*) + sizeof(size_t) + Arena::Alignment - 1) / Arena::Alignment) * Arena::Alignment;
+}
+
+Arena::Arena(size_t blockSize)
+	: fBuffer(NULL),
+	  fBufferSize(0),
+	  fBlocks(NULL),
+	  fCurrent(NULL),
+	  fEnd(NULL),
+	  fBlockSize(blockSize),
+	  fUsed(0),
+	  fLarge(NULL)
+{
+}
+
+Arena::Arena(void* buffer, size_t size, size_t blockSize)
+	: fBuffer(static_cast<char*>(buffer)),
+	  fBufferSize(size),
+	  fBlocks(NULL),
+	  fCurrent(static_cast<char*>(buffer)),
+	  fEnd(static_cast<char*>(buffer) + size),
+	  fBlockSize(blockSize),
+	  fUsed(0),
+	  fLarge(NULL)
+{
+}
+
+Arena::~Arena() {
+	freeLarge();
+	freeBlocks();
+}
+
+void
+Arena::addBlock(size_t size) {
+	size_t dataSize = (size > fBlockSize ? size : fBlockSize);
+	void* memory = std::malloc(header_size() + dataSize);
+	if(memory == NULL) {
+		throw std::bad_alloc();
+	}
+	Block* block = static_cast<Block*>(memory);
+	block->next = fBlocks;
+	block->size = dataSize;
+	fBlocks = block;
+	fCurrent = static_cast<char*>(memory) + header_size();
+	fEnd = fCurrent + dataSize;
+}
+
+void
+Arena::freeBlocks() {
+	while(fBlocks != NULL) {
+		Block* next = fBlocks->next;
+		std::free(fBlocks);
+		fBlocks = next;
+	}
+}
+
+void*
+Arena::allocateLarge(size_t size) {
+	// La cabecera ocupa lo mismo que la alineación, así que los datos
+	// quedan alineados.
+	void* memory = std::malloc(sizeof(LargeBlock) + size);
+	if(memory == NULL) {
+		throw std::bad_alloc();
+	}
+	LargeBlock* block = static_cast<LargeBlock*>(memory);
+	block->prev = NULL;
+	block->next = fLarge;
+	if(fLarge != NULL) {
+		fLarge->prev = block;
+	}
+	fLarge = block;
+	return block + 1;
+}
+
+void
+Arena::deallocateLarge(void* memory) {
+	// Sólo se libera si es de un bloque propio (si cupo en el bloque actual,
+	// es de la zona). Hay pocos: los que se sustituyen se liberan.
+	for(LargeBlock* block = fLarge; block != NULL; block = block->next) {
+		if(block + 1 == memory) {
+			if(block->prev != NULL) {
+				block->prev->next = block->next;
+			} else {
+				fLarge = block->next;
+			}
+			if(block->next != NULL) {
+				block->next->prev = block->prev;
+			}
+			std::free(block);
+			return;
+		}
+	}
+}
+
+void
+Arena::freeLarge() {
+	while(fLarge != NULL) {
+		LargeBlock* next = fLarge->next;
+		std::free(fLarge);
+		fLarge = next;
+	}
+}
+
+void
+Arena::release() {
+	freeLarge();
+	size_t used = fUsed;
+	fUsed = 0;
+	if(fBuffer != NULL && used <= fBufferSize) {
+		// Todo cupo en el buffer del usuario.
+		freeBlocks();
+		fCurrent = fBuffer;
+		fEnd = fBuffer + fBufferSize;
+	} else if(fBlocks != NULL && fBlocks->next == NULL && fBlocks->size >= used) {
+		// Todo cupo en un solo bloque: se reutiliza.
+		fCurrent = reinterpret_cast<char*>(fBlocks) + header_size();
+		fEnd = fCurrent + fBlocks->size;
+	} else if(fBlocks != NULL) {
+		// Hizo falta más de un bloque: se cambian por uno con sitio para todo
+		// (más el relleno de alineación que pueda hacer falta).
+		freeBlocks();
+		addBlock(used + used / 4);
+	}
+}
+
+}	// namespace clipp
@@ -0,0 +1,747 @@
+/*
+ * CompiledSchema.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <algorithm>
+
+#include "../include/cli++/Exceptions.hpp"
+#include "../include/cli++/CompiledSchema.hpp"
+#include "../include/cli++/OptionManager.hpp"
+#include "../include/cli++/Utils.hpp"
+#include "Consts.hpp"
+
+namespace clipp {
+
+CompiledSchema::CompiledSchema(const OptionManager& om)
+	: fKeys(),
+	  fLongTable(),
+	  fSlots(om.fOrderedDefinitions.begin(), om.fOrderedDefinitions.end()),
+	  fVariables(),
+	  fSubcommands(),
+	  fAbbreviations(om.fAbbreviations),
+	  fPrefixes(),
+	  fSuggestions(om.fSuggestions),
+	  fApproximate(),
+	  fPatterns(),
+	  fArgumentsCount(&om.fArgumentsCount),
+	  fResponseFiles(om.fResponseFiles),
+	  fStreamArguments(om.fStreamArguments),
+	  fWords(SlotWords(fSlots.size())),
+	  fRequired(fWords, 0),
+	  fExclusive(fWords, 0),
+	  fMasks(),
+	  fConflicts(),
+	  fRequiredIf(),
+	  fRequiredIfNot()
+{
+	StringRefs longKeys;
+	DefinitionList longValues;
+	std::fill(fShortTable, fShortTable + ShortTableSize, static_cast<const OptionDefinition*>(NULL));
+	for(OptionManager::OptionDefinitionMap::const_iterator it = om.fDefinitions.begin(); it != om.fDefinitions.end(); ++it) {
+		if(it->second->isPattern() && it->first == StringRef(it->second->fName)) {
+			// Los patrones sólo se buscan cuando no hay otra (ver abajo).
+			continue;
+		}
+		fKeys.push_back(it->first.str());
+		if(fKeys.back().length() == 1) {
+			fShortTable[static_cast<unsigned char>(fKeys.back()[0])] = it->second;
+		} else {
+			longKeys.push_back(fKeys.back());
+			longValues.push_back(it->second);
+		}
+	}
+	fLongTable.build(longKeys, longValues);
+	if(fAbbreviations) {
+		fPrefixes.build(longKeys, longValues);
+	}
+	if(fSuggestions > 0) {
+		fApproximate.build(longKeys, longValues);
+	}
+
+	StringRefs patternKeys;
+	DefinitionList patternValues;
+	for(size_t slot = 0; slot < fSlots.size(); slot++) {
+		if(fSlots[slot]->isPattern()) {
+			fKeys.push_back(fSlots[slot]->fName);
+			patternKeys.push_back(fKeys.back());
+			patternValues.push_back(fSlots[slot]);
+		}
+	}
+	fPatterns.build(patternKeys, patternValues);
+
+	StringRefs subcommandKeys;
+	std::vector<int> subcommandValues;
+	for(size_t i = 0; i < om.fSubcommands.size(); i++) {
+		fKeys.push_back(om.fSubcommands[i].name);
+		subcommandKeys.push_back(fKeys.back());
+		subcommandValues.push_back(i);
+	}
+	fSubcommands.build(subcommandKeys, subcommandValues);
+
+	// Se compilan las restricciones entre opciones como conjuntos de bits.
+	std::vector<StringSet> requiredIf(fSlots.size());
+	for(DefinitionList::const_iterator it = fSlots.begin(); it != fSlots.end(); ++it) {
+		const OptionDefinition* optdef = *it;
+		if(optdef->fRequired) {
+			SetSlot(&fRequired[0], optdef->fSlot);
+		}
+		if(optdef->fExclusive) {
+			SetSlot(&fExclusive[0], optdef->fSlot);
+		}
+		if(optdef->hasVar()) {
+			fVariables.push_back(optdef);
+		}
+		compileMask(fConflicts, optdef->fSlot, optdef->fConflictsWith);
+		compileMask(fRequiredIfNot, optdef->fSlot, optdef->fRequiredIfNot);
+		// "requiredIfOption()" se guarda al revés: por cada opción, las que
+		// pasan a ser obligatorias si está.
+		for(StringSet::const_iterator sit = optdef->fRequiredIf.begin(); sit != optdef->fRequiredIf.end(); ++sit) {
+			const OptionDefinition* trigger = om.getOptionDefinition(StringRef(*sit));
+			if(trigger != NULL) {
+				requiredIf[trigger->fSlot].insert(optdef->fName);
+			}
+		}
+	}
+	for(size_t slot = 0; slot < fSlots.size(); slot++) {
+		compileMask(fRequiredIf, slot, requiredIf[slot]);
+	}
+}
+
+void
+CompiledSchema::compileMask(SlotMaskList& list, int slot, const StringSet& names) {
+	SlotSet mask(fWords, 0);
+	bool empty = true;
+	for(StringSet::const_iterator it = names.begin(); it != names.end(); ++it) {
+		const OptionDefinition* optdef = (it->length() == 1 ? fShortTable[static_cast<unsigned char>((*it)[0])] : fLongTable.find(StringRef(*it), NULL));
+		if(optdef != NULL) {
+			SetSlot(&mask[0], optdef->fSlot);
+			empty = false;
+		}
+	}
+	if(!empty) {
+		SlotMask slotMask;
+		slotMask.slot = slot;
+		slotMask.offset = fMasks.size();
+		fMasks.insert(fMasks.end(), mask.begin(), mask.end());
+		list.push_back(slotMask);
+	}
+}
+
+CompiledSchema::~CompiledSchema() {
+}
+
+const OptionDefinition*
+CompiledSchema::getOptionDefinition(const StringRef nameOrAlias) const {
+	ParseStats* stats = ParseStats::current();
+	if(stats != NULL) {
+		stats->fLookups++;
+	}
+	if(nameOrAlias.length() == 1) {
+		return fShortTable[static_cast<unsigned char>(nameOrAlias[0])];
+	} else {
+		return fLongTable.find(nameOrAlias, NULL);
+	}
+}
+
+int
+CompiledSchema::countDefinitions() const {
+	return fSlots.size();
+}
+
+bool
+CompiledSchema::isOption(const StringRef option) const {
+	return isShortOption(option) || isLongOption(option);
+}
+
+bool
+CompiledSchema::isShortOption(const StringRef option) const {
+	return option.length() > 1 && option[0] == consts::OptionIdentifier && option[1] != consts::OptionIdentifier;
+}
+
+bool
+CompiledSchema::isLongOption(const StringRef option) const {
+	return option.length() > 2 && option[0] == consts::OptionIdentifier && option[1] == consts::OptionIdentifier;
+}
+
+const StringRef
+CompiledSchema::normalizeOption(const StringRef option, bool isShort) const {
+	return option.substr(isShort ? 1 : 2);
+}
+
+void
+CompiledSchema::decodeShortOption(ParseResult& result, const StringRef option, bool normalize) const {
+	StringRef op = (normalize ? normalizeOption(option,true) : option);
+	if(op.length() == 1) {
+		// La opción es de un sólo caracter. Se procesa normalmente (option: -a -> op: a).
+		const OptionDefinition* optdef = getOptionDefinition(op);
+		if(optdef != NULL) {
+			postProcessOption(result, optdef, op);
+		} else if(normalize && (optdef = getPatternDefinition(op)) != NULL) {
+			postProcessOption(result, optdef, op, false, option);
+		} else {
+			fail(result, OptionManager::ERROR_INVALID_OPTION, ReasonPlain, -1, option);
+		}
+	} else {
+		// La opción tiene más de un carácter. Pueden pasar dos cosas: o que la opción lleve el parámetro junto a ella,
+		// o que la opción lleve junto a ella otra y otras opciones de un sólo caracter (option: -av -> op: -a -v || op: -a v).
+		StringRef singleoption = op.substr(0, 1);
+		const OptionDefinition* optdef = getOptionDefinition(singleoption);
+		if(optdef != NULL) {
+			// La opción existe. Se procesa.
+			if(optdef->hasArgument()) {
+				// La opción tiene un argumento, de momento opcional.
+				if(optdef->isArgumentRequired()) {
+					// La opción tiene argumento obligatorio. Se coge y se añade dicha opción.
+					addOption(result, optdef, op.substr(1));
+				} else {
+					// La opción tiene un argument opcional. Miramos a ver si el primer elemento de este argumento es una opción.
+					// Si lo es, es que es ambigua. Si no lo es, es que es el argumento.
+					StringRef secondSortOption = op.substr(1, 2);
+					if(getOptionDefinition(secondSortOption) != NULL) {
+						// La opción es ambigua.
+						fail(result, OptionManager::ERROR_AMBIGUOUS_OPTION, ReasonPlain, optdef->fSlot, option);
+					} else {
+						addOption(result, optdef, op.substr(1));
+					}
+				}
+			} else {
+				// La opción no tiene argumento por lo que se añade.
+				addOption(result, optdef);
+				// El resto de la parte de esta opción se procesa sólo como opciones cortas. Como esto es
+				// recursivo, si hay más de dos opciones seguidas, se procesará sin problemas.
+				if(!result.stopped()) {
+					decodeShortOption(result, op.substr(1),false);
+				}
+			}
+		} else if(normalize && (optdef = getPatternDefinition(op)) != NULL) {
+			// La opción encaja con un patrón ("-10" con "%n", por ejemplo).
+			postProcessOption(result, optdef, op, false, option);
+		} else if(normalize) {
+			// La opción no existe (puede que sea una larga con un solo guion).
+			fail(result, OptionManager::ERROR_INVALID_OPTION, ReasonSuggest, -1, option, op);
+		} else {
+			// La opción no existe.
+			fail(result, OptionManager::ERROR_INVALID_OPTION, ReasonPlain, -1, option);
+		}
+	}
+}
+
+const string
+CompiledSchema::suggest(const StringRef name, const string marker, std::vector<string>& suggestions) const {
+	StringRefs keys;
+	std::vector<const OptionDefinition*> values;
+	fApproximate.find(name, fSuggestions, keys, values);
+	if(keys.empty()) {
+		return string();
+	}
+	string text;
+	for(size_t i = 0; i < keys.size(); i++) {
+		suggestions.push_back(marker + keys[i].str());
+		text += (i == 0 ? "" : ", ") + suggestions.back();
+	}
+	return " (did you mean " + text + "?)";
+}
+
+void
+CompiledSchema::fail(ParseResult& result, int error, int reason, int slot, const StringRef text, const StringRef name, int other) const {
+	ParseResult::Failure failure = { error, reason, result.fToken, slot, other, text, name };
+	if(!result.fCollect) {
+		throwFailure(failure);
+	}
+	// Los elementos del lector del descriptor no siguen siendo válidos.
+	failure.text = result.keep(text);
+	failure.name = result.keep(name);
+	result.fFailures.push_back(failure);
+}
+
+void
+CompiledSchema::fail(ParseResult& result, const clipp::error::Exception& e) const {
+	int error = OptionManager::ERROR_OTHER;
+	if(dynamic_cast<const clipp::error::InvalidOption*>(&e) != NULL) {
+		error = OptionManager::ERROR_INVALID_OPTION;
+	} else if(dynamic_cast<const clipp::error::InvalidArgument*>(&e) != NULL) {
+		error = OptionManager::ERROR_INVALID_ARGUMENT;
+	} else if(dynamic_cast<const clipp::error::Length*>(&e) != NULL) {
+		error = OptionManager::ERROR_LENGTH;
+	} else if(dynamic_cast<const clipp::error::ResponseFile*>(&e) != NULL) {
+		error = OptionManager::ERROR_RESPONSE_FILE;
+	} else if(dynamic_cast<const clipp::error::Input*>(&e) != NULL) {
+		error = OptionManager::ERROR_INPUT;
+	}
+	ParseResult::Failure failure = { error, ReasonText, result.fToken, -1, 0, result.copy(e.what()), result.copy(e.getOptionName()) };
+	result.fFailures.push_back(failure);
+}
+
+void
+CompiledSchema::throwFailure(const ParseResult::Failure& failure) const {
+	string optionName;
+	std::vector<string> suggestions;
+	const string message = describe(failure, optionName, suggestions);
+	switch(failure.error) {
+		case OptionManager::ERROR_INVALID_OPTION:
+			throw clipp::error::InvalidOption(message, optionName, suggestions);
+		case OptionManager::ERROR_INVALID_ARGUMENT:
+			throw clipp::error::InvalidArgument(message, optionName);
+		case OptionManager::ERROR_REQUIRED_OPTION:
+			throw clipp::error::RequiredOption(message, optionName);
+		case OptionManager::ERROR_REQUIRED_ARGUMENT:
+			throw clipp::error::RequiredArgument(message, optionName);
+		case OptionManager::ERROR_EXCLUSIVE_OPTION:
+			throw clipp::error::ExclusiveOption(message, optionName);
+		case OptionManager::ERROR_MULTIPLE_OPTION:
+			throw clipp::error::MultipleOption(message, optionName);
+		case OptionManager::ERROR_AMBIGUOUS_OPTION:
+			throw clipp::error::AmbiguousOption(message, optionName);
+		case OptionManager::ERROR_CONFLICT:
+			throw clipp::error::Conflict(message, optionName);
+		case OptionManager::ERROR_LENGTH:
+			throw clipp::error::Length(message, optionName);
+		default:
+			throw clipp::error::Exception(message, optionName);
+	}
+}
+
+const string
+CompiledSchema::describe(const ParseResult::Failure& failure, string& optionName, std::vector<string>& suggestions) const {
+	const StringRef text = failure.text;
+	if(failure.reason == ReasonText) {
+		optionName = failure.name.str();
+		return text.str();
+	}
+	const OptionDefinition* optdef = (failure.slot >= 0 ? fSlots[failure.slot] : NULL);
+	const string indicator = (optdef != NULL && optdef->isShortOption() ? "-" : "--");
+	optionName = (optdef != NULL ? optdef->fName : string());
+	switch(failure.error) {
+		case OptionManager::ERROR_INVALID_OPTION:
+			if(failure.reason == ReasonPlain) {
+				optionName = text.str();
+				return "Invalid option: " + text.str();
+			}
+			optionName = (failure.reason == ReasonSuggest ? text : failure.name).str();
+			return "Invalid option: " + text.str() + suggest(failure.name, failure.reason == ReasonNegated ? consts::LongOptionMarker + consts::NegationPreffix : consts::LongOptionMarker, suggestions);
+		case OptionManager::ERROR_AMBIGUOUS_OPTION:
+			if(failure.reason == ReasonPrefix) {
+				// Los candidatos (uno por definición) se recorren ahora.
+				StringRefs keys;
+				std::vector<const OptionDefinition*> values;
+				fPrefixes.candidates(failure.name, keys, values);
+				string candidates;
+				for(size_t i = 0; i < keys.size(); i++) {
+					if(std::find(values.begin(), values.begin() + i, values[i]) == values.begin() + i) {
+						candidates += (candidates.empty() ? "--" : ", --") + values[i]->name();
+					}
+				}
+				optionName = failure.name.str();
+				return "Ambiguous option: " + text.str() + " (could be " + candidates + ")";
+			}
+			optionName = text.str();
+			return "Ambiguous option construction: " + text.str();
+		case OptionManager::ERROR_INVALID_ARGUMENT:
+			if(failure.reason == ReasonNoArgument) {
+				optionName = text.str();
+				return "Invalid argument for option: --" + text.str();
+			} else {
+				OptionDefinition::ArgumentProblem problem = static_cast<OptionDefinition::ArgumentProblem>(failure.reason - ReasonProblem);
+				// Como en OptionDefinition::throwArgumentProblem(): los errores de valor no llevan el nombre.
+				if(problem != OptionDefinition::ArgumentNotInteger && problem != OptionDefinition::ArgumentNotFloat && problem != OptionDefinition::ArgumentNotBoolean) {
+					optionName.clear();
+				}
+				return optdef->argumentMessage(problem, text);
+			}
+		case OptionManager::ERROR_REQUIRED_ARGUMENT:
+			optionName = text.str();
+			return "Argument required for option: " + string(text.length() == 1 ? "-" : "--") + text.str();
+		case OptionManager::ERROR_MULTIPLE_OPTION:
+			return "Multiple option not allowed: " + indicator + optdef->fName;
+		case OptionManager::ERROR_EXCLUSIVE_OPTION:
+			return "Option is exclusive: " + indicator + optdef->fName;
+		case OptionManager::ERROR_REQUIRED_OPTION:
+			if(failure.reason == ReasonRequiredIf) {
+				const OptionDefinition* trigger = fSlots[failure.other];
+				return "Option required: " + indicator + optdef->fName +
+						". Required if option '" + string(trigger->isShortOption() ? "-" : "--") + trigger->fName + "' is present.";
+			} else if(failure.reason == ReasonRequiredIfNot) {
+				string options;
+				for(size_t slot = 0; slot < fSlots.size(); slot++) {
+					if(HasSlot(&fMasks[failure.other], slot)) {
+						options += string(options.empty() ? "" : ", ") + "'" + (fSlots[slot]->isShortOption() ? "-" : "--") + fSlots[slot]->fName + "'";
+					}
+				}
+				return "Option required: " + indicator + optdef->fName +
+						". Required if none of these options is present: " + options + ".";
+			}
+			return "Option required: " + indicator + optdef->fName;
+		case OptionManager::ERROR_CONFLICT: {
+			const string& name = fSlots[failure.other]->fName;
+			optionName.clear();
+			return "Option '" + indicator + optdef->fName +
+					"' conflicts with option '" + string(name.length() > 1 ? "--" : "-") + name + "'.";
+		}
+		case OptionManager::ERROR_LENGTH:
+			if(failure.reason == ReasonAtLeast) {
+				return "Must have " + StringFrom<int>(fArgumentsCount->min) + " arguments at least and " + StringFrom<int>(failure.other) + " arguments have been supplied.";
+			}
+			return "Must have " + StringFrom<int>(fArgumentsCount->max) + " arguments or less and " + StringFrom<int>(failure.other) + " arguments have been supplied.";
+		default:
+			return text.str();
+	}
+}
+
+const string
+CompiledSchema::errorMessage(const ParseResult& result, int index) const {
+	if(index < 0 || index >= (int)result.fFailures.size()) {
+		throw clipp::error::OutOfBounds("Cannot get error at index " + StringFrom<int>(index) + ". Index out of bounds (0.." + StringFrom<int>(result.fFailures.size() - 1) + ").");
+	}
+	string optionName;
+	std::vector<string> suggestions;
+	return describe(result.fFailures[index], optionName, suggestions);
+}
+
+const OptionDefinition*
+CompiledSchema::getPatternDefinition(const StringRef name) const {
+	const OptionDefinition* optdef = NULL;
+	if(fPatterns.empty() || !fPatterns.find(name, optdef)) {
+		return NULL;
+	}
+	return optdef;
+}
+
+const OptionDefinition*
+CompiledSchema::getLongOptionDefinition(ParseResult& result, const StringRef name, const StringRef option, bool& failed) const {
+	const OptionDefinition* optdef = getOptionDefinition(name);
+	if(optdef != NULL || !fAbbreviations || name.length() < 2) {
+		return optdef;
+	}
+	switch(fPrefixes.find(name, optdef)) {
+		case PrefixTrie<const OptionDefinition*>::MatchUnique:
+			return optdef;
+		case PrefixTrie<const OptionDefinition*>::MatchAmbiguous:
+			// Sólo al componer el mensaje se recorren los candidatos.
+			fail(result, OptionManager::ERROR_AMBIGUOUS_OPTION, ReasonPrefix, -1, option, name);
+			failed = true;
+			return NULL;
+		case PrefixTrie<const OptionDefinition*>::MatchNone:
+		default:
+			return NULL;
+	}
+}
+
+void
+CompiledSchema::decodeLongOption(ParseResult& result, const StringRef option, bool normalize) const {
+	StringRef op = (normalize ? normalizeOption(option, false) : option);
+	const OptionDefinition* optdef = getOptionDefinition(op);
+	bool failed = false;
+	if(optdef == NULL && fAbbreviations && op.find(consts::OptionArgumentSeparator) == StringRef::npos) {
+		// Una abreviatura (o nada, y puede que sea una negada).
+		optdef = getLongOptionDefinition(result, op, option, failed);
+	}
+	if(failed) {
+		return;
+	} else if(optdef != NULL) {
+		// La opción existe.
+		postProcessOption(result, optdef, op);
+	} else {
+		// La opción no existe, pero puede que sea de la forma --option=argument o una negada: --no-option
+		size_t position = option.find(consts::OptionArgumentSeparator);
+		if(position != StringRef::npos) {
+			// La opción tiene el argumento de la forma --option=argument
+			StringRef processedOption = normalizeOption(option.substr(0, position));
+			StringRef argument = option.substr(position + 1);
+			optdef = getLongOptionDefinition(result, processedOption, option.substr(0, position), failed);
+			if(failed) {
+				return;
+			} else if(optdef == NULL && (optdef = getPatternDefinition(processedOption)) != NULL) {
+				// Encaja con un patrón: el argumento sólo se guarda si lo admite.
+				addOption(result, optdef, optdef->hasArgument() ? argument : StringRef(), false, option);
+			} else if(optdef != NULL) {
+				if(optdef->hasArgument()) {
+					addOption(result, optdef, argument);
+				} else {
+					// La opción tiene argumento pero en realidad no lo lleva.
+					fail(result, OptionManager::ERROR_INVALID_ARGUMENT, ReasonNoArgument, optdef->fSlot, processedOption);
+				}
+			} else {
+				// El mensaje lleva un solo guion ("-option").
+				fail(result, OptionManager::ERROR_INVALID_OPTION, ReasonAssigned, -1, option.substr(1, position - 1), processedOption);
+			}
+		} else if(op.startsWith(consts::NegationPreffix)) {	// Comprobamos si la opción es la negada y si existe.
+			// TODO: No se soportan negadas con argumento.
+			// Puede que sea una opción negada. Veamos si existe una normal...
+			op = op.substr(consts::NegationPreffix.size());
+			optdef = getLongOptionDefinition(result, op, option, failed);
+			if(failed) {
+				return;
+			} else if(optdef != NULL) {
+				postProcessOption(result, optdef, op, true);
+			} else if((optdef = getPatternDefinition(normalizeOption(option, false))) != NULL) {
+				postProcessOption(result, optdef, normalizeOption(option, false), false, option);
+			} else {
+				// La opción es una opción negada pero no hay ninguna normal válida para esa negación.
+				fail(result, OptionManager::ERROR_INVALID_OPTION, ReasonNegated, -1, option, op);
+			}
+		} else {
+			// La opción no existe ni tiene el argumento de la forma --option=argument ni es una negada como --no-option así que...
+			optdef = getPatternDefinition(op);
+			if(optdef != NULL) {
+				postProcessOption(result, optdef, op, false, option);
+				return;
+			}
+			fail(result, OptionManager::ERROR_INVALID_OPTION, ReasonSuggest, -1, option, op);
+		}
+	}
+}
+
+void
+CompiledSchema::postProcessOption(ParseResult& result, const OptionDefinition* optdef, const StringRef realOption, bool isNegated, const StringRef match) const {
+	if(optdef->hasArgument()) {
+		// Si tiene argumentos...
+		if(optdef->isArgumentRequired()) {
+			// Pueden ser obligatorios...
+			if(result.hasRawOptions() && !isOption(result.peekRawOption())) {
+				addOption(result, optdef, result.popRawOption(), isNegated, match);
+			} else {
+				fail(result, OptionManager::ERROR_REQUIRED_ARGUMENT, ReasonPlain, optdef->fSlot, realOption);
+			}
+		} else {
+			if(result.hasRawOptions()) {
+				// ...o pueden ser opcionales.
+				// Se añade la opción y el argumento en caso de que este no sea otra opción, ya que este argumento es opcional.
+				addOption(result, optdef, (isOption(result.peekRawOption()) ? StringRef() : result.popRawOption()), isNegated, match);
+			} else {
+				// No hay más argumentos en la línea de comandos, así que se añade opción normal.
+				addOption(result, optdef, StringRef(), isNegated, match);
+			}
+		}
+	} else {
+		// Si no tiene argumentos ni opcionales ni obligatorios, se añade directamente a las opciones.
+		addOption(result, optdef, StringRef(), isNegated, match);
+	}
+}
+
+void
+CompiledSchema::addOption(ParseResult& result, const OptionDefinition* optdef, const StringRef argument, bool isNegated, const StringRef match) const {
+	// La opción se busca directamente por la posición de su definición.
+	Option* existing = result.findOption(optdef);
+	if(existing != NULL && !optdef->isMultiple()) {
+		fail(result, OptionManager::ERROR_MULTIPLE_OPTION, ReasonPlain, optdef->fSlot);
+		return;
+	}
+	Option* option = result.addOccurrence(optdef, argument, match);
+	if(existing == NULL) {
+		ParseStats* stats = ParseStats::current();
+		if(stats != NULL) {
+			stats->fOptionsCreated++;
+		}
+		option->fIsNegated = isNegated;
+	}
+}
+
+void
+CompiledSchema::checkProcessedOptions(ParseResult& result) const {
+	const SlotWord* present = result.fPresent;
+
+	// Comprobamos si la opción es exclusiva y hay otras diferentes.
+	int exclusive = FirstCommonSlot(&fExclusive[0], present, fWords);
+	if(exclusive >= 0 && result.fOptions.size() > 1) {
+		fail(result, OptionManager::ERROR_EXCLUSIVE_OPTION, ReasonPlain, exclusive);
+	}
+
+	// Comprobamos si una opción es requerida y no está entre las opciones
+	// (si se guardan todos los errores, todas las que faltan).
+	if(exclusive < 0) {
+		for(int missing = FirstMissingSlot(&fRequired[0], present, fWords); missing >= 0 && !result.stopped(); missing = FirstMissingSlot(&fRequired[0], present, fWords, missing + 1)) {
+			fail(result, OptionManager::ERROR_REQUIRED_OPTION, ReasonPlain, missing);
+		}
+		// Las opciones obligatorias si está otra.
+		for(SlotMaskList::const_iterator it = fRequiredIf.begin(); it != fRequiredIf.end() && !result.stopped(); ++it) {
+			if(HasSlot(present, it->slot)) {
+				for(int missing = FirstMissingSlot(&fMasks[it->offset], present, fWords); missing >= 0 && !result.stopped(); missing = FirstMissingSlot(&fMasks[it->offset], present, fWords, missing + 1)) {
+					fail(result, OptionManager::ERROR_REQUIRED_OPTION, ReasonRequiredIf, missing, StringRef(), StringRef(), it->slot);
+				}
+			}
+		}
+		// Las opciones obligatorias si no está ninguna de otras.
+		for(SlotMaskList::const_iterator it = fRequiredIfNot.begin(); it != fRequiredIfNot.end() && !result.stopped(); ++it) {
+			if(!HasSlot(present, it->slot) && FirstCommonSlot(&fMasks[it->offset], present, fWords) < 0) {
+				fail(result, OptionManager::ERROR_REQUIRED_OPTION, ReasonRequiredIfNot, it->slot, StringRef(), StringRef(), it->offset);
+			}
+		}
+	}
+
+	// Comprobamos los parámetros de las opciones procesadas.
+	for(ParseResult::OptionList::const_iterator it = result.fOptions.begin(); it != result.fOptions.end() && !result.stopped(); ++it) {
+		size_t index = 0;
+		int problem = (*it)->checkArguments(index);
+		if(problem != OptionDefinition::ArgumentOk) {
+			fail(result, OptionManager::ERROR_INVALID_ARGUMENT, ReasonProblem + problem, (*it)->fOptdef->fSlot, (*it)->fValues[index]);
+		}
+	}
+}
+
+void
+CompiledSchema::checkConflicts(ParseResult& result) const {
+	for(SlotMaskList::const_iterator it = fConflicts.begin(); it != fConflicts.end() && !result.stopped(); ++it) {
+		if(HasSlot(result.fPresent, it->slot)) {
+			int conflict = FirstCommonSlot(&fMasks[it->offset], result.fPresent, fWords);
+			if(conflict >= 0) {
+				fail(result, OptionManager::ERROR_CONFLICT, ReasonPlain, it->slot, StringRef(), StringRef(), conflict);
+			}
+		}
+	}
+}
+
+void
+CompiledSchema::processArguments(ParseResult& result) const {
+	int count = result.fArgumentCount;
+	if(fArgumentsCount->min > 0 && count < fArgumentsCount->min) {
+		fail(result, OptionManager::ERROR_LENGTH, ReasonAtLeast, -1, StringRef(), StringRef(), count);
+	} else if(fArgumentsCount->max > 0 && count > fArgumentsCount->max) {
+		fail(result, OptionManager::ERROR_LENGTH, ReasonAtMost, -1, StringRef(), StringRef(), count);
+	}
+}
+
+void
+CompiledSchema::addArgument(ParseResult& result, const StringRef argument) const {
+	if(fStreamArguments == NULL) {
+		result.fArguments.push_back(result.keep(argument));
+		result.fArgumentCount++;
+		return;
+	}
+	// Sólo se cuenta: el máximo se comprueba ya y el mínimo al final. Con
+	// errores ya no se pasan a la función.
+	int count = ++result.fArgumentCount;
+	if(fArgumentsCount->max > 0 && count > fArgumentsCount->max) {
+		fail(result, OptionManager::ERROR_LENGTH, ReasonAtMost, -1, StringRef(), StringRef(), count);
+	}
+	if(result.fFailures.empty()) {
+		fStreamArguments(argument, count - 1);
+	}
+}
+
+bool
+CompiledSchema::selectSubcommand(ParseResult& result, const StringRef argument) const {
+	int subcommand = fSubcommands.find(argument, -1);
+	if(subcommand < 0 || result.fRawIndex == 0 || argument.data() != result.fArgv[result.fRawIndex - 1]) {
+		return false;
+	}
+	result.fSubcommand = subcommand;
+	result.fSubcommandIndex = result.fRawIndex - 1;
+	return true;
+}
+
+void
+CompiledSchema::decode(ParseResult& result) const {
+	bool lastArgument = false;
+
+	// El primer elemento es el nombre del programa, que metemos como el argumento posicional cero.
+	if(result.hasRawOptions()) {
+		result.fArguments.push_back(result.popRawOption());
+		result.fArgumentCount++;
+	}
+
+	// Procesamos todas las opciones (guardando los errores, hasta el primero
+	// o hasta el final).
+	while(!result.stopped() && result.hasRawOptions()) {
+		StringRef option = result.popRawOption();
+		result.fToken = static_cast<int>(result.fTokens) - 1;
+		if(lastArgument) {
+			addArgument(result, option);
+		} else {
+			if(isShortOption(option)) {
+				// Es una opción corta.
+				decodeShortOption(result, option);
+			} else if(isLongOption(option)) {
+				// Es una opción larga.
+				decodeLongOption(result, option);
+			} else if(option == consts::ShortOptionMarker) {
+				// Argumento de entrada estándar.
+				addArgument(result, option);
+			} else if(option == consts::LongOptionMarker) {
+				// Opción que indica que el resto de opciones son argumentos.
+				lastArgument = true;
+			} else {
+				// Si no es nada de lo anterior es que es un argumento, salvo que
+				// sea el primero y un subcomando: ahí termina este análisis.
+				if(result.fArgumentCount == 1 && selectSubcommand(result, option)) {
+					return;
+				}
+				addArgument(result, option);
+			}
+		}
+	}
+	result.fToken = -1;
+}
+
+void
+CompiledSchema::process(int argc, char** argv, ParseResult& result, ParseStats* stats) const {
+	process(argc, argv, -1, '\0', result, stats);
+}
+
+void
+CompiledSchema::process(int argc, char** argv, int fd, char delimiter, ParseResult& result, ParseStats* stats) const {
+	run(argc, argv, fd, delimiter, result, stats, false, false);
+}
+
+bool
+CompiledSchema::tryProcess(int argc, char** argv, int fd, char delimiter, ParseResult& result, bool collectAll, ParseStats* stats) const {
+	try {
+		run(argc, argv, fd, delimiter, result, stats, true, collectAll);
+	} catch(clipp::error::Exception& e) {
+		// Lo que no son comprobaciones (ficheros de respuestas, lectura,
+		// demasiados valores...) sigue lanzando excepciones.
+		fail(result, e);
+	}
+	return result.fFailures.empty();
+}
+
+void
+CompiledSchema::run(int argc, char** argv, int fd, char delimiter, ParseResult& result, ParseStats* stats, bool collect, bool collectAll) const {
+	if(stats != NULL) {
+		stats->reset();
+	}
+	ParseStats::Scope scope(stats);
+
+	result.reset(argc, argv, fResponseFiles);
+	result.fCollect = collect;
+	result.fCollectAll = collectAll;
+	if(fd >= 0) {
+		result.readFrom(fd, delimiter);
+	}
+	result.prepare(fSlots.size(), fStreamArguments == NULL);
+
+	// Procesamos todas las opciones.
+	{
+		ParseStats::Timer timer(stats, ParseStats::PhaseDecode);
+		decode(result);
+	}
+	if(stats != NULL) {
+		stats->fTokens = result.fTokens;
+	}
+
+	// Procesamos si están todas las opciones que tiene que estar.
+	if(!result.stopped()) {
+		ParseStats::Timer timer(stats, ParseStats::PhaseCheckOptions);
+		checkProcessedOptions(result);
+	}
+
+	// Procesamos si hay conflictos entre opciones.
+	if(!result.stopped()) {
+		ParseStats::Timer timer(stats, ParseStats::PhaseCheckConflicts);
+		checkConflicts(result);
+	}
+
+	// Procesamos los argumentos (el número correcto).
+	if(!result.stopped()) {
+		ParseStats::Timer timer(stats, ParseStats::PhaseProcessArguments);
+		processArguments(result);
+	}
+
+	// Ya se pueden recorrer las opciones por ID (si no hay errores).
+	result.fProcessed = result.fFailures.empty();
+}
+
+}	// namespace clipp
@@ -0,0 +1,59 @@
+/*
+ * Completion.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <cctype>
+
+#include "../include/cli++/Completion.hpp"
+
+namespace clipp {
+
+const char* const	Completion::Request = "--__complete";
+const char* const	Completion::ScriptRequest = "--__completion";
+
+const string
+Completion::script(Shell shell, const string program) {
+	string name = program.substr(program.rfind('/') == string::npos ? 0 : program.rfind('/') + 1);
+	// El nombre de la función de la shell sólo puede tener letras, números y '_'.
+	string function = "_clipp_";
+	for(string::size_type i = 0; i < name.length(); i++) {
+		function += (isalnum(static_cast<unsigned char>(name[i])) ? name[i] : '_');
+	}
+	if(shell == ShellZsh) {
+		return "#compdef " + name + "\n"
+			   + function + "() {\n"
+			   "\tlocal -a candidates\n"
+			   "\tcandidates=(\"${(@f)$(\"${words[1]}\" " + Request + " $((CURRENT - 1)) \"${words[@]}\" 2>/dev/null)}\")\n"
+			   "\tif (( ${#candidates} )) && [[ -n \"${candidates[1]}\" ]]; then\n"
+			   "\t\tcompadd -Q -- \"${candidates[@]}\"\n"
+			   "\telse\n"
+			   "\t\t_files\n"
+			   "\tfi\n"
+			   "}\n"
+			   "compdef " + function + " " + name + "\n";
+	}
+	// Sin candidatos, "-o default" completa nombres de fichero.
+	return function + "() {\n"
+		   "\tlocal IFS=$'\\n'\n"
+		   "\tCOMPREPLY=($(\"${COMP_WORDS[0]}\" " + Request + " \"$COMP_CWORD\" \"${COMP_WORDS[@]}\" 2>/dev/null))\n"
+		   "}\n"
+		   "complete -o default -F " + function + " " + name + "\n";
+}
+
+bool
+Completion::shell(const string name, Shell& shell) {
+	if(name == "bash") {
+		shell = ShellBash;
+		return true;
+	} else if(name == "zsh") {
+		shell = ShellZsh;
+		return true;
+	}
+	return false;
+}
+
+}	// namespace clipp
@@ -0,0 +1,170 @@
+/*
+ * Configuration.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+#include "../include/cli++/Configuration.hpp"
+#include "../include/cli++/Exceptions.hpp"
+#include "../include/cli++/Utils.hpp"
+
+namespace clipp {
+
+/**
+ * Quita los espacios del principio y del final.
+ */
+static const string
+trim(const string& text) {
+	string::size_type start = text.find_first_not_of(" \t\r");
+	if(start == string::npos) {
+		return "";
+	}
+	string::size_type end = text.find_last_not_of(" \t\r");
+	return text.substr(start, end - start + 1);
+}
+
+Configuration::Configuration()
+	: fFile(),
+	  fPrefix(),
+	  fLoaded(false),
+	  fValues()
+{
+}
+
+Configuration::~Configuration() {
+}
+
+void
+Configuration::load() {
+	// Sólo queda leído si no hay errores: si no, se vuelve a intentar (y a
+	// lanzar la excepción) en la siguiente consulta.
+	ValueMap values;
+	std::ifstream in(fFile.c_str());
+	if(!in) {
+		throw clipp::error::Configuration("Cannot read configuration file '" + fFile + "'.");
+	}
+	string section;
+	string line;
+	int number = 0;
+	while(std::getline(in, line)) {
+		number++;
+		line = trim(line);
+		if(line.empty() || line[0] == '#' || line[0] == ';') {
+			continue;
+		}
+		if(line[0] == '[') {
+			if(line[line.length() - 1] != ']') {
+				throw clipp::error::Configuration("Bad section in configuration file '" + fFile + "', line " + StringFrom<int>(number) + ": " + line);
+			}
+			section = trim(line.substr(1, line.length() - 2));
+			continue;
+		}
+		string::size_type equal = line.find('=');
+		string key = trim(line.substr(0, equal));
+		string value = (equal == string::npos ? "true" : trim(line.substr(equal + 1)));
+		if(key.empty()) {
+			throw clipp::error::Configuration("Missing key in configuration file '" + fFile + "', line " + StringFrom<int>(number) + ": " + line);
+		}
+		if(value.length() >= 2 && (value[0] == '"' || value[0] == '\'') && value[value.length() - 1] == value[0]) {
+			value = value.substr(1, value.length() - 2);
+		}
+		// Si una clave se repite, vale la última.
+		values[section.empty() ? key : section + "." + key] = value;
+	}
+	fValues.swap(values);
+	fLoaded = true;
+}
+
+void
+Configuration::file(const string path) {
+	fFile = path;
+	fLoaded = false;
+	fValues.clear();
+}
+
+const string&
+Configuration::file() const {
+	return fFile;
+}
+
+void
+Configuration::prefix(const string prefix) {
+	fPrefix = prefix;
+}
+
+const string&
+Configuration::prefix() const {
+	return fPrefix;
+}
+
+bool
+Configuration::loaded() const {
+	return fLoaded;
+}
+
+bool
+Configuration::fromFile(const string& key, string& value) {
+	if(fFile.empty()) {
+		return false;
+	}
+	if(!fLoaded) {
+		load();
+	}
+	ValueMap::const_iterator finder = fValues.find(key);
+	if(finder == fValues.end()) {
+		return false;
+	}
+	value = finder->second;
+	return true;
+}
+
+bool
+Configuration::fromEnvironment(const string& name, string& value) const {
+	if(fPrefix.empty()) {
+		return false;
+	}
+	const char* variable = getenv(environmentName(name).c_str());
+	if(variable == NULL) {
+		return false;
+	}
+	value = variable;
+	return true;
+}
+
+const string
+Configuration::environmentName(const string& name) const {
+	if(fPrefix.empty()) {
+		return "";
+	}
+	string result = fPrefix + "_";
+	for(string::size_type i = 0; i < name.length(); i++) {
+		char c = name[i];
+		result += (c == '-' || c == '.' ? '_' : static_cast<char>(toupper(static_cast<unsigned char>(c))));
+	}
+	return result;
+}
+
+const char*
+Configuration::sourceName(Source source) {
+	switch(source) {
+		case SourceDefault:
+			return "default";
+		case SourceFile:
+			return "file";
+		case SourceEnvironment:
+			return "environment";
+		case SourceCommandLine:
+			return "command line";
+		case SourceNone:
+		default:
+			return "none";
+	}
+}
+
+}	// namespace clipp
@@ -0,0 +1,36 @@
+/*
+ * Consts.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef CLIPP_CONSTS_HPP_
+#define CLIPP_CONSTS_HPP_
+
+#include <string>
+
+using std::string;
+
+namespace clipp {
+
+/**
+ * Constantes de la sintaxis de la línea de comandos (compartidas por el
+ * OptionManager y el CompiledSchema).
+ */
+namespace consts {
+
+const char		OptionIdentifier			= '-';
+
+const string	ShortOptionMarker			= "-";
+const string	LongOptionMarker			= "--";
+const char		OptionArgumentSeparator		= '=';
+const string	AliasSeparator				= "|";
+const string	NegationPreffix				= "no-";
+
+}	// namespace consts
+
+}	// namespace clipp
+
+#endif /* CLIPP_CONSTS_HPP_ */
@@ -15,18 +15,21 @@
 
 namespace clipp {
 
+/**
+ * Número máximo de valores que puede tener una opción. Es sólo un límite
+ * lógico; los valores se guardan según van llegando.
+ */
 static const size_t		MaxParameterCount	= 65536;
 
 static bool
-to_bool(string value) {
-	std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-	if (value == "true" || value == "yes" || value == "on" || value == "1") {
-		return true;
-	} else if (value == "false" || value == "no" || value == "off" || value == "0") {
-		return false;
-	} else {
-		throw clipp::error::InvalidArgument("Value is not a valid boolean: " + value);
+to_bool(const StringRef value) {
+	bool result;
+	if(!ParseBoolean(value, result)) {
+		string lower = value.str();
+		std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+		throw clipp::error::InvalidArgument("Value is not a valid boolean: " + lower);
 	}
+	return result;
 }
 
 Option::Option(const string name, const string value)
@@ -34,15 +37,28 @@ Option::Option(const string name, const string value)
 	  fName(name),
 	  fOccurrences(1),
 	  fValues(),
+	  fMatches(),
+	  fTypedValues(),
+	  fOwnedValues(),
 	  fOptdef(NULL)
 {
 	if(fName.empty()) {
 		throw length_error("Option: Option name cannot be empty.");
 	}
-	fValues.reserve(MaxParameterCount);
-	if(!value.empty()) {
-		fValues.push_back(value);
-	}
+	add(value);
+}
+
+Option::Option(const OptionDefinition* optdef, Arena* arena)
+	: fId(optdef->id()),
+	  fName(),
+	  fIsNegated(false),
+	  fOccurrences(1),
+	  fValues(arena),
+	  fMatches(arena),
+	  fTypedValues(arena),
+	  fOwnedValues(),
+	  fOptdef(const_cast<OptionDefinition*>(optdef))
+{
 }
 
 Option::~Option() {
@@ -51,22 +67,24 @@ Option::~Option() {
 void
 Option::updateVariable() {
 	if(fOptdef->hasVar()) {
+		// Si los argumentos ya están comprobados se usa el valor convertido; si no, se convierte ahora.
+		bool typed = !fTypedValues.empty();
 		switch(fOptdef->type()) {
 			case OptionDefinition::TypeString:
-				*(fOptdef->var<string>()) = fValues[0];
+				*(fOptdef->var<string>()) = fValues[0].str();
 				break;
 			case OptionDefinition::TypeInteger:
-				*(fOptdef->var<int>()) = StringTo<int>(fValues[0], 0);
+				*(fOptdef->var<int>()) = (typed ? fTypedValues[0].integer : StringTo<int>(fValues[0].str(), 0));
 				break;
 			case OptionDefinition::TypeFloat:
-				*(fOptdef->var<float>()) = StringTo<float>(fValues[0], 0.0);
+				*(fOptdef->var<float>()) = (typed ? fTypedValues[0].real : StringTo<float>(fValues[0].str(), 0.0));
 				break;
 			case OptionDefinition::TypeBoolean:
-				*(fOptdef->var<bool>()) = to_bool(fValues[0]);
+				*(fOptdef->var<bool>()) = (typed ? fTypedValues[0].boolean : to_bool(fValues[0]));
 				break;
 			case OptionDefinition::TypeNone:
 			default:
-				throw clipp::error::InvalidArgument("Cannot assign argument to variable: " + fValues[0]);
+				throw clipp::error::InvalidArgument("Cannot assign argument to variable: " + fValues[0].str());
 		}
 	}
 }
@@ -78,7 +96,7 @@ Option::id() const {
 
 const string
 Option::name() const {
-	return fName;
+	return (fName.empty() && fOptdef != NULL ? fOptdef->fName : fName);
 }
 
 bool
@@ -102,19 +120,33 @@ Option::occurrences() const {
 }
 
 void
-Option::add(const string value) {
+Option::append(const StringRef value) {
 	if(!value.empty()) {
+		if(fValues.size() >= MaxParameterCount) {
+			throw clipp::error::Length("Cannot add value " + value.str() + " to option '" + name() + "'. Too many values (" + StringFrom<size_t>(MaxParameterCount) + " max.).", name());
+		}
 		fValues.push_back(value);
 	}
 }
 
+void
+Option::add(const string value) {
+	if(!value.empty()) {
+		// El valor no viene de "argv", así que se guarda una copia (la lista no mueve sus elementos).
+		fOwnedValues.push_back(value);
+		append(fOwnedValues.back());
+	}
+}
+
 void
 Option::set(const string value, int index) {
 	if(!value.empty()) {
 		if(index >= 0 && index < (int)fValues.size()) {
-			fValues[index] = value;
+			fOwnedValues.push_back(value);
+			fValues[index] = fOwnedValues.back();
+			fTypedValues.clear();	// El valor convertido ya no es válido.
 		} else {
-			throw clipp::error::OutOfBounds("Cannot set value " + value + " at index " + StringFrom<int>(index) + " from option '" + fName + "'.", fName);
+			throw clipp::error::OutOfBounds("Cannot set value " + value + " at index " + StringFrom<int>(index) + " from option '" + name() + "'.", name());
 		}
 	}
 }
@@ -122,9 +154,9 @@ Option::set(const string value, int index) {
 const string
 Option::getAt(unsigned short index) const {
 	if(index < (int)fValues.size()) {
-		return fValues[index];
+		return fValues[index].str();
 	} else {
-		throw clipp::error::OutOfBounds("Cannot get value at index " + StringFrom<unsigned short>(index) + " from option '" + fName + "'.", fName);
+		throw clipp::error::OutOfBounds("Cannot get value at index " + StringFrom<unsigned short>(index) + " from option '" + name() + "'.", name());
 	}
 }
 
@@ -133,20 +165,101 @@ Option::get() const {
 	return getAt(0);
 }
 
+bool
+Option::typedAt(unsigned short index, int& value) const {
+	if(index < fTypedValues.size() && fOptdef->type() == OptionDefinition::TypeInteger) {
+		value = fTypedValues[index].integer;
+		return true;
+	}
+	return false;
+}
+
+bool
+Option::typedAt(unsigned short index, long& value) const {
+	if(index < fTypedValues.size() && fOptdef->type() == OptionDefinition::TypeInteger) {
+		value = fTypedValues[index].integer;
+		return true;
+	}
+	return false;
+}
+
+bool
+Option::typedAt(unsigned short index, float& value) const {
+	if(index < fTypedValues.size() && fOptdef->type() == OptionDefinition::TypeFloat) {
+		value = fTypedValues[index].real;
+		return true;
+	}
+	return false;
+}
+
+bool
+Option::typedAt(unsigned short index, double& value) const {
+	if(index < fTypedValues.size() && fOptdef->type() == OptionDefinition::TypeFloat) {
+		value = fTypedValues[index].real;
+		return true;
+	}
+	return false;
+}
+
+bool
+Option::typedAt(unsigned short index, bool& value) const {
+	if(index < fTypedValues.size() && fOptdef->type() == OptionDefinition::TypeBoolean) {
+		value = fTypedValues[index].boolean;
+		return true;
+	}
+	return false;
+}
+
+int
+Option::validStringIndex(unsigned short index) const {
+	return (index < fTypedValues.size() ? fTypedValues[index].index : -1);
+}
+
 int
 Option::countValues() const {
 	return fValues.size();
 }
 
+const string
+Option::matchAt(unsigned short index) const {
+	if(index < (int)fMatches.size()) {
+		return fMatches[index].str();
+	} else {
+		throw clipp::error::OutOfBounds("Cannot get match at index " + StringFrom<unsigned short>(index) + " from option '" + name() + "'.", name());
+	}
+}
+
+int
+Option::countMatches() const {
+	return fMatches.size();
+}
+
 void
 Option::checkArguments() {
 	if(fOptdef == NULL) {
 		throw clipp::error::OptionDefinition("FATAL: OptionDefinition pointer from Option (_optdef) is NULL. Contact developer.");
 	}
-	for(Strings::const_iterator it = fValues.begin(); it != fValues.end(); ++it) {
-		fOptdef->checkArgumentType(*it);
-		fOptdef->checkArgumentValue(*it);
+	size_t index = 0;
+	int problem = checkArguments(index);
+	if(problem != OptionDefinition::ArgumentOk) {
+		fOptdef->throwArgumentProblem(static_cast<OptionDefinition::ArgumentProblem>(problem), fValues[index]);
+	}
+}
+
+int
+Option::checkArguments(size_t& index) {
+	fTypedValues.clear();
+	for(index = 0; index < fValues.size(); index++) {
+		TypedValue typed;
+		typed.real = 0;
+		typed.index = -1;
+		OptionDefinition::ArgumentProblem problem = fOptdef->argumentProblem(fValues[index], typed);
+		if(problem != OptionDefinition::ArgumentOk) {
+			return problem;
+		}
+		fTypedValues.push_back(typed);
 	}
+	return OptionDefinition::ArgumentOk;
 }
 
 }	// namespace clipp
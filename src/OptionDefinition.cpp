@@ -12,12 +12,14 @@
 #include "../include/cli++/OptionDefinition.hpp"
 #include "../include/cli++/Utils.hpp"
 #include "../include/cli++/OptionManager.hpp"
+#include "../include/cli++/PatternTable.hpp"
 
 namespace clipp {
 
 OptionDefinition::OptionDefinition(const OptionDefinition& od)
 	: fOwner(od.fOwner),
 	  fId(od.fId),
+	  fSlot(od.fSlot),
 	  fName(od.fName),
 	  fType(od.fType),
 	  fDescription(od.fDescription),
@@ -30,6 +32,8 @@ OptionDefinition::OptionDefinition(const OptionDefinition& od)
 	  fAllowNoPreffix(od.fAllowNoPreffix),
 	  fAlias(od.fAlias),
 	  fValidStrings(od.fValidStrings),
+	  fRequiredIf(od.fRequiredIf),
+	  fRequiredIfNot(od.fRequiredIfNot),
 	  fHasMinValue(false),
 	  fMinValue(0),
 	  fHasMaxValue(false),
@@ -44,6 +48,7 @@ OptionDefinition::OptionDefinition(const OptionDefinition& od)
 OptionDefinition::OptionDefinition(const string name, OptionType type, const string description)
 	: fOwner(NULL),
 	  fId(0),
+	  fSlot(-1),
 	  fName(name),
 	  fType(type),
 	  fDescription(description),
@@ -56,6 +61,8 @@ OptionDefinition::OptionDefinition(const string name, OptionType type, const str
 	  fAllowNoPreffix(false),
 	  fAlias(),
 	  fValidStrings(),
+	  fRequiredIf(),
+	  fRequiredIfNot(),
 	  fHasMinValue(false),
 	  fMinValue(0),
 	  fHasMaxValue(false),
@@ -73,6 +80,7 @@ OptionDefinition::OptionDefinition(const string name, OptionType type, const str
 OptionDefinition::OptionDefinition(int id, const string name, OptionType type, const string description)
 	: fOwner(NULL),
 	  fId(id),
+	  fSlot(-1),
 	  fName(name),
 	  fType(type),
 	  fDescription(description),
@@ -85,6 +93,8 @@ OptionDefinition::OptionDefinition(int id, const string name, OptionType type, c
 	  fAllowNoPreffix(false),
 	  fAlias(),
 	  fValidStrings(),
+	  fRequiredIf(),
+	  fRequiredIfNot(),
 	  fHasMinValue(false),
 	  fMinValue(0),
 	  fHasMaxValue(false),
@@ -102,6 +112,13 @@ OptionDefinition::OptionDefinition(int id, const string name, OptionType type, c
 OptionDefinition::~OptionDefinition() {
 }
 
+void
+OptionDefinition::changed() {
+	if(fOwner != NULL) {
+		fOwner->invalidate();
+	}
+}
+
 void
 OptionDefinition::checkExclusivity() const {
 	if(fExclusive && (fRequired || fMultiple)) {
@@ -110,86 +127,131 @@ OptionDefinition::checkExclusivity() const {
 	}
 }
 
-static bool
-is_bool(string value) {
-	std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-	return value == "true" || value == "yes" || value == "on" || value == "1" || \
-		value == "false" || value == "no" || value == "off" || value == "0";
+static const string
+implode_string_set(const string glue, const StringSet& set, const string wrap = string()) {
+	stringstream out;
+	StringSet::const_iterator preend = set.end();
+	advance(preend, -1);
+	for(StringSet::const_iterator it = set.begin(); it != set.end(); ++it) {
+		out << (wrap.empty() ? "" : wrap) << *it << (wrap.empty() ? "" : wrap) << (it != preend ? glue : "");
+	}
+	return out.str();
 }
 
-void
-OptionDefinition::checkArgumentType(const string argument) const {
-	const string indicator = (isLongOption() ? "--" : "-");
+OptionDefinition::ArgumentProblem
+OptionDefinition::typeProblem(const StringRef argument, TypedValue& typed) const {
 	switch(fType) {
 		case OptionDefinition::TypeInteger:
-			if(!StringIs<int>(argument)) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be an integer: " + argument, fName);
-			}
-			break;
+			return ParseInteger(argument, typed.integer, INT_MIN, INT_MAX) ? ArgumentOk : ArgumentNotInteger;
 		case OptionDefinition::TypeFloat:
-			if(!StringIs<float>(argument)) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be a float: " + argument, fName);
-			}
-			break;
+			return ParseReal(argument, typed.real, FLT_MAX) ? ArgumentOk : ArgumentNotFloat;
 		case OptionDefinition::TypeBoolean:
-			if(!is_bool(argument)) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be a boolean: " + argument, fName);
-			}
-			break;
+			return ParseValue(argument, typed.boolean) ? ArgumentOk : ArgumentNotBoolean;
 		case OptionDefinition::TypeString:
+		case OptionDefinition::TypeNone:
 		default:
-			break;
+			// Las cadenas no necesitan comprobación (ni copia).
+			return ArgumentOk;
 	}
 }
 
-static const string
-implode_string_set(const string glue, const StringSet& set, const string wrap = string()) {
-	stringstream out;
-	StringSet::const_iterator preend = set.end();
-	advance(preend, -1);
-	for(StringSet::const_iterator it = set.begin(); it != set.end(); ++it) {
-		out << (wrap.empty() ? "" : wrap) << *it << (wrap.empty() ? "" : wrap) << (it != preend ? glue : "");
+OptionDefinition::ArgumentProblem
+OptionDefinition::valueProblem(const StringRef value, TypedValue& typed) const {
+	if(fValidStrings.empty() && !(fHasMaxValue && (fType == OptionDefinition::TypeInteger || fType == OptionDefinition::TypeFloat))) {
+		// No hay nada que comprobar, así que ni siquiera se copia el argumento.
+		return ArgumentOk;
 	}
-	return out.str();
-}
-
-void
-OptionDefinition::checkArgumentValue(const string argument) const {
-	const string indicator = (isLongOption() ? "--" : "-");
 
 	// Aunque el argumento no sea de tipo cadena, siempre se procesa que contenga cadenas válidas, porque,
 	// en realidad, todos los argumentos son cadenas hasta que se realiza la comprobación de tipos.
-	if(!fValidStrings.empty() && fValidStrings.find(argument) == fValidStrings.end()) {
-		throw clipp::error::InvalidArgument("Invalid argument '" + argument + "' for option '"  + indicator + fName + "'. Argument must be one of " +
-				implode_string_set(", ", fValidStrings, (fType == OptionDefinition::TypeString ? "\"" : "")) + ".");
+	StringSet::const_iterator found = fValidStrings.find(value.str());
+	if(!fValidStrings.empty() && found == fValidStrings.end()) {
+		return ArgumentNotValid;
+	}
+	if(found != fValidStrings.end()) {
+		typed.index = std::distance(fValidStrings.begin(), found);
 	}
 
-	// Luego se comprueba el argumento ya según su tipo.
+	// Luego se comprueba el argumento ya según su tipo (convertido por typeProblem()).
 	if(fType == OptionDefinition::TypeInteger) {
-		bool isint = StringIs<int>(argument);
-		if(isint && fHasMaxValue) {
-			if(StringTo<int>(argument, 0) > fMaxValue) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be less than " + StringFrom<float>(fMaxValue) + ": " + argument);
+		if(fHasMaxValue) {
+			if(typed.integer > fMaxValue) {
+				return ArgumentTooBig;
 			}
 		}
-		if(isint && fHasMaxValue) {
-			if(StringTo<int>(argument, 0) < fMinValue) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be greater than " + StringFrom<float>(fMinValue) + ": " + argument);
+		if(fHasMaxValue) {
+			if(typed.integer < fMinValue) {
+				return ArgumentTooSmall;
 			}
 		}
 	} else if(fType == OptionDefinition::TypeFloat) {
-		bool isfloat = StringIs<float>(argument);
-		if(isfloat && fHasMaxValue) {
-			if(StringTo<float>(argument, 0) > fMaxValue) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be less than " + StringFrom<float>(fMaxValue) + ": " + argument);
+		if(fHasMaxValue) {
+			if(typed.real > fMaxValue) {
+				return ArgumentTooBig;
 			}
 		}
-		if(isfloat && fHasMaxValue) {
-			if(StringTo<float>(argument, 0) < fMinValue) {
-				throw clipp::error::InvalidArgument("Argument for option '" + indicator + fName + "' must be greater than " + StringFrom<float>(fMinValue) + ": " + argument);
+		if(fHasMaxValue) {
+			if(typed.real < fMinValue) {
+				return ArgumentTooSmall;
 			}
 		}
 	}
+	return ArgumentOk;
+}
+
+OptionDefinition::ArgumentProblem
+OptionDefinition::argumentProblem(const StringRef argument, TypedValue& typed) const {
+	ArgumentProblem problem = typeProblem(argument, typed);
+	return problem != ArgumentOk ? problem : valueProblem(argument, typed);
+}
+
+const string
+OptionDefinition::argumentMessage(ArgumentProblem problem, const StringRef argument) const {
+	const string indicator = (isLongOption() ? "--" : "-");
+	switch(problem) {
+		case ArgumentNotInteger:
+			return "Argument for option '" + indicator + fName + "' must be an integer: " + argument.str();
+		case ArgumentNotFloat:
+			return "Argument for option '" + indicator + fName + "' must be a float: " + argument.str();
+		case ArgumentNotBoolean:
+			return "Argument for option '" + indicator + fName + "' must be a boolean: " + argument.str();
+		case ArgumentNotValid:
+			return "Invalid argument '" + argument.str() + "' for option '"  + indicator + fName + "'. Argument must be one of " +
+					implode_string_set(", ", fValidStrings, (fType == OptionDefinition::TypeString ? "\"" : "")) + ".";
+		case ArgumentTooBig:
+			return "Argument for option '" + indicator + fName + "' must be less than " + StringFrom<float>(fMaxValue) + ": " + argument.str();
+		case ArgumentTooSmall:
+			return "Argument for option '" + indicator + fName + "' must be greater than " + StringFrom<float>(fMinValue) + ": " + argument.str();
+		case ArgumentOk:
+		default:
+			return string();
+	}
+}
+
+void
+OptionDefinition::throwArgumentProblem(ArgumentProblem problem, const StringRef argument) const {
+	// Los errores de tipo llevan el nombre de la opción; los de valor, no.
+	if(problem == ArgumentNotInteger || problem == ArgumentNotFloat || problem == ArgumentNotBoolean) {
+		throw clipp::error::InvalidArgument(argumentMessage(problem, argument), fName);
+	}
+	throw clipp::error::InvalidArgument(argumentMessage(problem, argument));
+}
+
+void
+OptionDefinition::checkArgumentType(const StringRef argument, TypedValue& typed) const {
+	// Sólo se compone el mensaje si no es correcto.
+	ArgumentProblem problem = typeProblem(argument, typed);
+	if(problem != ArgumentOk) {
+		throwArgumentProblem(problem, argument);
+	}
+}
+
+void
+OptionDefinition::checkArgumentValue(const StringRef value, TypedValue& typed) const {
+	ArgumentProblem problem = valueProblem(value, typed);
+	if(problem != ArgumentOk) {
+		throwArgumentProblem(problem, value);
+	}
 }
 
 OptionDefinition&
@@ -221,7 +283,14 @@ OptionDefinition::operator != (const string on) const {
 
 OptionDefinition&
 OptionDefinition::id(int id) {
-	fId = id;
+	if(fOwner != NULL && fSlot >= 0) {
+		// Se cambia de lista en el índice por id del OptionManager.
+		fOwner->unlinkId(fSlot);
+		fId = id;
+		fOwner->linkId(fSlot);
+	} else {
+		fId = id;
+	}
 	return *this;
 }
 
@@ -236,6 +305,7 @@ OptionDefinition::name(const string name) {
 		throw clipp::error::Length("OptionDefinition: Name cannot be empty.");
 	}
 	fName = name;
+	changed();
 	return *this;
 }
 
@@ -247,6 +317,7 @@ OptionDefinition::name() const {
 OptionDefinition&
 OptionDefinition::type(OptionType ot) {
 	fType = ot;
+	changed();
 	return *this;
 }
 
@@ -268,24 +339,28 @@ OptionDefinition::isShortOption() const {
 OptionDefinition&
 OptionDefinition::typeString() {
 	fType = OptionDefinition::TypeString;
+	changed();
 	return *this;
 }
 
 OptionDefinition&
 OptionDefinition::typeInteger() {
 	fType = OptionDefinition::TypeInteger;
+	changed();
 	return *this;
 }
 
 OptionDefinition&
 OptionDefinition::typeFloat() {
 	fType = OptionDefinition::TypeFloat;
+	changed();
 	return *this;
 }
 
 OptionDefinition&
 OptionDefinition::typeBool() {
 	fType = OptionDefinition::TypeBoolean;
+	changed();
 	return *this;
 }
 
@@ -353,6 +428,7 @@ OptionDefinition::alias() const {
 OptionDefinition&
 OptionDefinition::description(const string description) {
 	fDescription = description;
+	changed();
 	return *this;
 }
 
@@ -374,6 +450,7 @@ OptionDefinition::hidden() const {
 OptionDefinition&
 OptionDefinition::required(bool required) {
 	fRequired = required;
+	changed();
 	return *this;
 }
 
@@ -384,32 +461,33 @@ OptionDefinition::isRequired() const {
 
 OptionDefinition&
 OptionDefinition::requiredIfOption(const string option) {
-	// TODO: Implement this method.
+	fRequiredIf.insert(option);
+	changed();
 	return *this;
 }
 
 bool
 OptionDefinition::isRequiredIfOption(const string option) const {
-	// TODO: Implement this method.
-	return false;
+	return fRequiredIf.find(option) != fRequiredIf.end();
 }
 
 OptionDefinition&
 OptionDefinition::requiredIfNotOption(const string option) {
-	// TODO: Implement this method.
+	fRequiredIfNot.insert(option);
+	changed();
 	return *this;
 }
 
 bool
 OptionDefinition::isRequiredIfNotOption(const string option) const {
-	// TODO: Implement this method.
-	return false;
+	return fRequiredIfNot.find(option) != fRequiredIfNot.end();
 }
 
 OptionDefinition&
 OptionDefinition::conflictsWith(const string conflicts) {
 	fConflictsWith.clear();
 	fConflictsWith.insert(conflicts);
+	changed();
 	return *this;
 }
 
@@ -417,6 +495,7 @@ OptionDefinition&
 OptionDefinition::conflictsWith(StringSet conflicts) {
 	fConflictsWith.clear();
 	fConflictsWith.insert(conflicts.begin(), conflicts.end());
+	changed();
 	return *this;
 }
 
@@ -429,6 +508,7 @@ OptionDefinition&
 OptionDefinition::argument(bool has, bool required) {
 	fHasArgument = has;
 	fArgumentRequired = required;
+	changed();
 	return *this;
 }
 
@@ -445,6 +525,7 @@ OptionDefinition::argumentRequired(bool required) {
 		// tener argumento, así no es necesario llamar a la función "argument()".
 		fHasArgument = true;
 	}
+	changed();
 	return *this;
 }
 
@@ -465,10 +546,16 @@ OptionDefinition::isMultiple() const {
 	return fMultiple;
 }
 
+bool
+OptionDefinition::isPattern() const {
+	return PatternTable<const OptionDefinition*>::isPattern(fName);
+}
+
 OptionDefinition&
 OptionDefinition::exclusive(bool exclusive) {
 	fExclusive = exclusive;
 	checkExclusivity();
+	changed();
 	return *this;
 }
 
@@ -492,6 +579,7 @@ void
 OptionDefinition::defaultValue(const string defaultValue) {
 	fHasDefaultValue = true;
 	fDefaultValue = defaultValue;
+	changed();
 }
 
 const string
@@ -503,6 +591,7 @@ void
 OptionDefinition::removeDefaultValue() {
 	fHasDefaultValue = false;
 	fDefaultValue = "";
+	changed();
 }
 
 bool
@@ -6,10 +6,14 @@
  *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
  */
 
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <sys/ioctl.h>
 using namespace std;
 
 using std::stringstream;
@@ -17,68 +21,86 @@ using std::stringstream;
 #include "../include/cli++/Exceptions.hpp"
 #include "../include/cli++/OptionManager.hpp"
 #include "../include/cli++/Utils.hpp"
+#include "Consts.hpp"
 
 namespace clipp {
 
-namespace consts {
-
-const char		OptionIdentifier			= '-';
-
-const string	ShortOptionMarker			= "-";
-const string	LongOptionMarker			= "--";
-const char		OptionArgumentSeparator		= '=';
-const string	AliasSeparator				= "|";
-const string	NegationPreffix				= "no-";
-
-}	// namespace consts
+OptionManager::OptionManager()
+	: fDefinitionKeys(),
+	  fDefinitions(),
+	  fOrderedDefinitions(),
+	  fIdSlots(),
+	  fSparseIdSlots(),
+	  fNextSameId(),
+	  fHelpLayouts(),
+	  fConfiguration(),
+	  fLayeredValues(),
+	  fSubcommands(),
+	  fCompletionIndex(),
+	  fSchema(NULL),
+	  fResult(),
+	  fStats(NULL),
+	  fArgumentsCount(-1,-1),
+	  fExecute(NULL),
+	  fResponseFiles(false),
+	  fAbbreviations(false),
+	  fSuggestions(3),
+	  fStreamArguments(NULL),
+	  fCredits(),
+	  fUsage(),
+	  fArgc(0),
+	  fArgv(NULL)
+{
+}
 
 OptionManager::OptionManager(int argc, char** argv)
-	: fRawOptions(),
+	: fDefinitionKeys(),
 	  fDefinitions(),
 	  fOrderedDefinitions(),
-	  fOptions(),
-	  fOptionsIterator(),
-	  fArguments(),
+	  fIdSlots(),
+	  fSparseIdSlots(),
+	  fNextSameId(),
+	  fHelpLayouts(),
+	  fConfiguration(),
+	  fLayeredValues(),
+	  fSubcommands(),
+	  fCompletionIndex(),
+	  fSchema(NULL),
+	  fResult(),
+	  fStats(NULL),
 	  fArgumentsCount(-1,-1),
 	  fExecute(NULL),
+	  fResponseFiles(false),
+	  fAbbreviations(false),
+	  fSuggestions(3),
+	  fStreamArguments(NULL),
 	  fCredits(),
 	  fUsage(),
 	  fArgc(argc),
 	  fArgv(argv)
 {
-	// Metemos los argumentos en una cola
-	for(int i = 0; i < argc; i++) {
-		fRawOptions.push_back(argv[i]);
-	}
+	fResult.reset(argc, argv);
 }
 
 OptionManager::~OptionManager() {
-	// Limpiamos la lista de definiciones de opciones ordenada, pero no
-	// las borramos aquí, las borramos en el siguiente bucle.
-	fOrderedDefinitions.clear();
+	// Las opciones procesadas se borran antes que sus definiciones.
+	fResult.reset(0, NULL);
 
-	// Borramos las definiciones de las opciones (ahora sí).
-	for(OptionDefinitionMap::iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
-		if(it->first == it->second->name()) {
-			delete it->second;
-		} else {
-			it->second->fAlias = "";
-		}
+	// El esquema compilado sólo tiene referencias a las definiciones.
+	invalidate();
+
+	// Borramos las definiciones de las opciones desde la lista ordenada, donde
+	// cada una está una sola vez (en el mapa también están los alias, y al
+	// recorrerlo se podía acceder a una definición ya borrada).
+	for(OptionDefinitionList::iterator it = fOrderedDefinitions.begin(); it != fOrderedDefinitions.end(); ++it) {
+		delete *it;
 	}
+	fOrderedDefinitions.clear();
 	fDefinitions.clear();
 
-	// Borramos la lista de opciones (en esta lista están repetidas, pero como son punteros pues
-	// no ocupa más memoria; eso sí, aquí no las borramos, las borramos en el siguiente bucle).
-	fOptionsList.clear();
-
-	// Borramos las opciones, esta vez sí, liberando la memoria.
-	for(OptionMap::iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
-		if(it->second != NULL) {
-			delete it->second;
-			it->second = NULL;
-		}
+	for(SubcommandList::iterator it = fSubcommands.begin(); it != fSubcommands.end(); ++it) {
+		delete it->manager;
 	}
-	fOptions.clear();
 }
 
 const string
@@ -106,12 +128,12 @@ OptionManager::argumentHelpDescription(const OptionDefinition* optdef) const {
 }
 
 bool
-OptionManager::hasOptionDefinition(const string name) const {
+OptionManager::hasOptionDefinition(const StringRef name) const {
 	return fDefinitions.find(name) != fDefinitions.end();
 }
 
 OptionDefinition*
-OptionManager::getOptionDefinition(const string nameOrAlias) const {
+OptionManager::getOptionDefinition(const StringRef nameOrAlias) const {
 	OptionDefinitionMap::const_iterator finder = fDefinitions.find(nameOrAlias);
 	if(finder != fDefinitions.end()) {
 		return finder->second;
@@ -120,325 +142,471 @@ OptionManager::getOptionDefinition(const string nameOrAlias) const {
 	}
 }
 
-const string
-OptionManager::popRawOption() {
-	string result = fRawOptions.front();
-	fRawOptions.pop_front();
-	return result;
+void
+OptionManager::checkLayeredValue(const OptionDefinition* optdef, LayeredValue& layered, const string& origin) const {
+	layered.typed.real = 0;
+	layered.typed.index = -1;
+	try {
+		if(!optdef->hasArgument()) {
+			// Las opciones sin argumento sólo pueden estar o no estar.
+			if(!ParseBoolean(StringRef(layered.value), layered.typed.boolean)) {
+				throw clipp::error::InvalidArgument("Value for option '" + string(optdef->isLongOption() ? "--" : "-") + optdef->name() + "' must be a boolean: " + layered.value, optdef->name());
+			}
+			return;
+		}
+		optdef->checkArgumentType(StringRef(layered.value), layered.typed);
+		optdef->checkArgumentValue(StringRef(layered.value), layered.typed);
+	} catch(clipp::error::InvalidArgument& e) {
+		throw clipp::error::InvalidArgument(string(e.what()) + " (" + origin + ")", optdef->name());
+	}
 }
 
-const string
-OptionManager::peekRawOption() const {
-	return fRawOptions.front();
+const OptionManager::LayeredValue&
+OptionManager::layeredValue(const OptionDefinition* optdef) {
+	if(fLayeredValues.size() < fOrderedDefinitions.size()) {
+		LayeredValue empty;
+		empty.resolved = false;
+		empty.source = Configuration::SourceNone;
+		fLayeredValues.resize(fOrderedDefinitions.size(), empty);
+	}
+	LayeredValue& layered = fLayeredValues[optdef->fSlot];
+	if(layered.resolved) {
+		return layered;
+	}
+	// De mayor a menor prioridad; el fichero sólo se lee si hace falta.
+	if(fConfiguration.fromEnvironment(optdef->name(), layered.value)) {
+		layered.source = Configuration::SourceEnvironment;
+		checkLayeredValue(optdef, layered, "from environment variable " + fConfiguration.environmentName(optdef->name()));
+	} else if(fConfiguration.fromFile(optdef->name(), layered.value)) {
+		layered.source = Configuration::SourceFile;
+		checkLayeredValue(optdef, layered, "from configuration file '" + fConfiguration.file() + "'");
+	} else if(optdef->hasDefaultValue()) {
+		layered.value = optdef->defaultValue();
+		layered.source = Configuration::SourceDefault;
+		checkLayeredValue(optdef, layered, "default value");
+	} else {
+		layered.source = Configuration::SourceNone;
+	}
+	// Si el valor no es válido no se llega aquí y se vuelve a comprobar la
+	// próxima vez.
+	layered.resolved = true;
+	return layered;
 }
 
-unsigned int
-OptionManager::remainRawOptions() const {
-	return fRawOptions.size();
+Configuration::Source
+OptionManager::lookupValue(const string& name, string& value) {
+	const OptionDefinition* optdef = getOptionDefinition(StringRef(name));
+	if(optdef == NULL || optdef->name() != name) {
+		// Como getOption(), sólo vale el nombre.
+		return Configuration::SourceNone;
+	}
+	const Option* option = fResult.findOption(optdef);
+	if(option != NULL) {
+		if(option->countValues() > 0) {
+			value = option->fValues[0].str();
+		} else {
+			value = (option->isNegated() ? "false" : "true");
+		}
+		return Configuration::SourceCommandLine;
+	}
+	const LayeredValue& layered = layeredValue(optdef);
+	if(layered.source != Configuration::SourceNone) {
+		value = layered.value;
+	}
+	return layered.source;
 }
 
-bool
-OptionManager::isOption(const string option) const {
-	return isShortOption(option) || isLongOption(option);
+void
+OptionManager::updateVariables(const ParseResult& result) {
+	for(ParseResult::OptionList::const_iterator it = result.fOptions.begin(); it != result.fOptions.end(); ++it) {
+		(*it)->updateVariable();
+	}	
+	// Las variables de las opciones que no están toman el valor de las capas.
+	for(CompiledSchema::DefinitionList::const_iterator it = fSchema->fVariables.begin(); it != fSchema->fVariables.end(); ++it) {
+		const OptionDefinition* optdef = *it;
+		if(result.findOption(optdef) != NULL) {
+			continue;
+		}
+		const LayeredValue& layered = layeredValue(optdef);
+		if(layered.source == Configuration::SourceNone) {
+			continue;
+		}
+		switch(optdef->type()) {
+			case OptionDefinition::TypeString:
+				*(optdef->var<string>()) = layered.value;
+				break;
+			case OptionDefinition::TypeInteger:
+				*(optdef->var<int>()) = layered.typed.integer;
+				break;
+			case OptionDefinition::TypeFloat:
+				*(optdef->var<float>()) = layered.typed.real;
+				break;
+			case OptionDefinition::TypeBoolean:
+				*(optdef->var<bool>()) = layered.typed.boolean;
+				break;
+			case OptionDefinition::TypeNone:
+			default:
+				break;
+		}
+	}
 }
 
-bool
-OptionManager::isShortOption(const string option) const {
-	return option.length() > 1 && option[0] == consts::OptionIdentifier && option[1] != consts::OptionIdentifier;
+void
+OptionManager::executeFunctionsForOptions(const ParseResult& result) const {
+	for(ParseResult::OptionList::const_iterator it = result.fOptions.begin(); it != result.fOptions.end(); ++it) {
+		const OptionDefinition* od = (*it)->optionDefinition();
+		if(od->execute() != NULL) {
+			od->execute()(*it);
+		}
+	}
 }
 
-bool
-OptionManager::isLongOption(const string option) const {
-	return option.length() > 2 && option[0] == consts::OptionIdentifier && option[1] == consts::OptionIdentifier;
+void
+OptionManager::executeFunctionForArguments(const ParseResult& result) const {
+	if(fExecute != NULL) {
+		int i = 0;
+		for(ParseResult::ArgumentList::const_iterator it = result.fArguments.begin(); it != result.fArguments.end(); ++it, i++) {
+			fExecute(it->str(),i);
+		}
+	}
 }
 
-const string
-OptionManager::normalizeOption(const string option, bool isShort) const {
-	return option.substr(isShort ? 1 : 2);
+void
+OptionManager::invalidate() {
+	delete fSchema;
+	fSchema = NULL;
+	fHelpLayouts.clear();
+	fLayeredValues.clear();
+	fCompletionIndex.clear();
+}
+
+int
+OptionManager::firstSlot(int id) const {
+	if(id >= 0 && id < DenseIdLimit) {
+		return id < static_cast<int>(fIdSlots.size()) ? fIdSlots[id] : -1;
+	}
+	SlotMap::const_iterator finder = fSparseIdSlots.find(id);
+	return finder != fSparseIdSlots.end() ? finder->second : -1;
 }
 
 void
-OptionManager::decodeShortOption(const string option, bool normalize) {
-	string op = (normalize ? normalizeOption(option,true) : option);
-	if(op.length() == 1) {
-		// La opción es de un sólo caracter. Se procesa normalmente (option: -a -> op: a).
-		OptionDefinition* optdef = getOptionDefinition(op);
-		if(optdef != NULL) {
-			postProcessOption(optdef, op);
-		} else {
-			throw clipp::error::InvalidOption("Invalid option: " + option, option);
+OptionManager::linkId(int slot) {
+	int id = fOrderedDefinitions[slot]->fId;
+	int* link;
+	if(id >= 0 && id < DenseIdLimit) {
+		if(id >= static_cast<int>(fIdSlots.size())) {
+			fIdSlots.resize(id + 1, -1);
 		}
+		link = &fIdSlots[id];
 	} else {
-		// La opción tiene más de un carácter. Pueden pasar dos cosas: o que la opción lleve el parámetro junto a ella,
-		// o que la opción lleve junto a ella otra y otras opciones de un sólo caracter (option: -av -> op: -a -v || op: -a v).
-		string singleoption = op.substr(0, 1);
-		const OptionDefinition* optdef = getOptionDefinition(singleoption);
-		if(optdef != NULL) {
-			// La opción existe. Se procesa.
-			if(optdef->hasArgument()) {
-				// La opción tiene un argumento, de momento opcional.
-				if(optdef->isArgumentRequired()) {
-					// La opción tiene argumento obligatorio. Se coge y se añade dicha opción.
-					addOption(optdef, op.substr(1));
-				} else {
-					// La opción tiene un argument opcional. Miramos a ver si el primer elemento de este argumento es una opción.
-					// Si lo es, es que es ambigua. Si no lo es, es que es el argumento.
-					string secondSortOption = op.substr(1, 2);
-					if(hasOptionDefinition(secondSortOption)) {
-						// La opción es ambigua.
-						throw clipp::error::AmbiguousOption("Ambiguous option construction: " + option, option);
-					} else {
-						addOption(optdef, op.substr(1));
-					}
-				}
-			} else {
-				// La opción no tiene argumento por lo que se añade.
-				addOption(optdef);
-				// El resto de la parte de esta opción se procesa sólo como opciones cortas. Como esto es
-				// recursivo, si hay más de dos opciones seguidas, se procesará sin problemas.
-				decodeShortOption(op.substr(1),false);
-			}
-		} else {
-			// La opción no existe. Se lanza excepción.
-			throw clipp::error::InvalidOption("Invalid option: " + option, option);
-		}
+		link = &fSparseIdSlots.insert(std::make_pair(id, -1)).first->second;
+	}
+	// La lista de cada id se mantiene en orden de definición.
+	while(*link >= 0 && *link < slot) {
+		link = &fNextSameId[*link];
 	}
+	fNextSameId[slot] = *link;
+	*link = slot;
 }
 
 void
-OptionManager::decodeLongOption(const string option, bool normalize) {
-	string op = (normalize ? normalizeOption(option, false) : option);
-	OptionDefinition* optdef = getOptionDefinition(op);
-	if(optdef != NULL) {
-		// La opción existe.
-		postProcessOption(optdef, op);
+OptionManager::unlinkId(int slot) {
+	int id = fOrderedDefinitions[slot]->fId;
+	int* link;
+	if(id >= 0 && id < DenseIdLimit) {
+		link = &fIdSlots[id];
 	} else {
-		// La opción no existe, pero puede que sea de la forma --option=argument o una negada: --no-option
-		size_t position = option.find_first_of(consts::OptionArgumentSeparator);
-		if(position != string::npos) {
-			// La opción tiene el argumento de la forma --option=argument
-			string processedOption = normalizeOption(option.substr(0, position));
-			string argument = option.substr(position + 1);
-			optdef = getOptionDefinition(processedOption);
-			if(optdef != NULL) {
-				if(optdef->hasArgument()) {
-					addOption(optdef, argument);
-				} else {
-					// La opción tiene argumento pero en realidad no lo lleva.
-					throw clipp::error::InvalidArgument("Invalid argument for option: --" + processedOption, processedOption);
-				}
-			} else {
-				throw clipp::error::InvalidOption("Invalid option: -" + processedOption, processedOption);
-			}
-		} else if(op.substr(0, consts::NegationPreffix.size()) == consts::NegationPreffix) {	// Comprobamos si la opción es la negada y si existe.
-			// TODO: No se soportan negadas con argumento.
-			// Puede que sea una opción negada. Veamos si existe una normal...
-			op = op.substr(consts::NegationPreffix.size(), -1);
-			optdef = getOptionDefinition(op);
-			if(optdef != NULL) {
-				postProcessOption(optdef, op, true);
-			} else {
-				// La opción es una opción negada pero no hay ninguna normal válida para esa negación.
-				throw clipp::error::InvalidOption("Invalid option: --" + consts::NegationPreffix + op, op);
-			}
-		} else {
-			// La opción no existe ni tiene el argumento de la forma --option=argument ni es una negada como --no-option así que...
-			throw clipp::error::InvalidOption("Invalid option: " + option, option);
-		}
+		link = &fSparseIdSlots[id];
+	}
+	while(*link != slot) {
+		link = &fNextSameId[*link];
 	}
+	*link = fNextSameId[slot];
+	fNextSameId[slot] = -1;
 }
 
-void
-OptionManager::postProcessOption(const OptionDefinition* optdef, const string realOption, bool isNegated) {
-	if(optdef->hasArgument()) {
-		// Si tiene argumentos...
-		if(optdef->isArgumentRequired()) {
-			if(remainRawOptions() > 0) {
-				// Pueden ser obligatorios...
-				if(!isOption(peekRawOption())) {
-					addOption(optdef, popRawOption(), isNegated);
-				} else {
-					//throw clipp::error::RequiredArgument("Argument required for option: " + string(optdef->isShortOption() ? "-" : "--") + optdef->name() + " (" + realOption + ")", optdef->name());
-					throw clipp::error::RequiredArgument("Argument required for option: " + string(realOption.length() == 1 ? "-" : "--") + realOption, realOption);
-				}
-			} else {
-				//throw clipp::error::RequiredArgument("Argument required for option: " + string(optdef->isShortOption() ? "-" : "--") + optdef->name() + " (" + realOption + ")", optdef->name());
-				throw clipp::error::RequiredArgument("Argument required for option: " + string(realOption.length() == 1 ? "-" : "--") + realOption, realOption);
-			}
-		} else {
-			if(remainRawOptions() > 0) {
-				// ...o pueden ser opcionales.
-				// Se añade la opción y el argumento en caso de que este no sea otra opción, ya que este argumento es opcional.
-				addOption(optdef, (isOption(peekRawOption()) ? "" : popRawOption()), isNegated);
-			} else {
-				// No hay más argumentos en la línea de comandos, así que se añade opción normal.
-				addOption(optdef, "", isNegated);
-			}
-		}
-	} else {
-		// Si no tiene argumentos ni opcionales ni obligatorios, se añade directamente a las opciones.
-		addOption(optdef, "", isNegated);
+const CompiledSchema&
+OptionManager::compile() {
+	if(fSchema == NULL) {
+		fSchema = new CompiledSchema(*this);
 	}
+	return *fSchema;
 }
 
 void
-OptionManager::addOption(const OptionDefinition* optdef, const string argument, bool isNegated) {
-	string name = optdef->name();
-	if(hasOption(name)) {
-		if(optdef->isMultiple()) {
-			fOptions[name]->incOccurrenceCount();
-			if(!argument.empty()) {
-				fOptions[name]->add(argument);
-			}
-			fOptionsList.push_back(fOptions[name]);	// En esta lista están ordenadas según la línea de comandos y duplicadas (son punteros).
-		} else {
-			throw clipp::error::MultipleOption("Multiple option not allowed: " + string(optdef->isShortOption() ? "-" : "--") + name, name);
-		}
-	} else {
-		Option* option = new Option(name, argument);
-		option->fOptdef = const_cast<OptionDefinition*>(optdef);
-		option->fIsNegated = isNegated;
-		fOptions[name] = option;
-		fOptionsList.push_back(option);	// en esta lista están ordenadas según la línea de comandos y duplicadas (son punteros).
-	}
-	fOptions[name]->fId = optdef->id();
+OptionManager::process() {
+	process(fArgc, fArgv, fResult);
+}
+
+const ParseResult&
+OptionManager::process(int argc, char** argv) {
+	process(argc, argv, fResult);
+	return fResult;
 }
 
 void
-OptionManager::checkProcessedOptions() const {
-	bool exclusivity = false;
-	string exclusiveOption = "";
-	bool isShortOption = false;
-	// Comprobamos si la opción es exclusiva y hay otras diferentes.
-	for(OptionDefinitionMap::const_iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
-		if(hasOption(it->first) && it->second->isExclusive()) {
-			exclusivity = true;
-			exclusiveOption = it->first;
-			isShortOption = it->second->isShortOption();
-			break;
-		}
-	}
+OptionManager::process(int argc, char** argv, ParseResult& result) {
+	process(argc, argv, -1, '\0', result);
+}
+
+const ParseResult&
+OptionManager::process(int argc, char** argv, int fd, char delimiter) {
+	process(argc, argv, fd, delimiter, fResult);
+	return fResult;
+}
+
+void
+OptionManager::process(int argc, char** argv, int fd, char delimiter, ParseResult& result) {
+	const CompiledSchema& schema = compile();
+	ParseStats::Scope scope(fStats);
 
-	if(exclusivity && fOptions.size() > 1) {
-		throw clipp::error::ExclusiveOption("Option is exclusive: " + string(isShortOption ? "-" : "--") + exclusiveOption, exclusiveOption);
+	// Análisis y comprobaciones (sin efectos fuera del resultado).
+	schema.process(argc, argv, fd, delimiter, result, fStats);
+
+	// Actualiza las variables (en caso de que haya).
+	{
+		ParseStats::Timer timer(fStats, ParseStats::PhaseUpdateVariables);
+		updateVariables(result);
 	}
 
-	// Comprobamos si una opción es requerida y no está entre las opciones.
-	if(!exclusivity) {
-		for(OptionDefinitionMap::const_iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
-			if(it->second->isRequired() && !hasOption(it->second->name())) {
-				throw clipp::error::RequiredOption("Option required: " + string(it->second->isShortOption() ? "-" : "--") + it->second->name(), it->second->name());
-			}
-		}
+	{
+		ParseStats::Timer timer(fStats, ParseStats::PhaseCallbacks);
+
+		// Ejectua las funciones definidas para las opciones.
+		executeFunctionsForOptions(result);
+
+		// Ejecuta la función para los argumentos.
+		executeFunctionForArguments(result);
 	}
 
-	// Comprobamos los parámetros de las opciones procesadas.
-	for(OptionMap::const_iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
-		it->second->checkArguments();
+	// El resto de la línea de comandos es del subcomando.
+	if(result.fSubcommand >= 0) {
+		subcommandManager(result.fSubcommand).process(result.fArgc - result.fSubcommandIndex, result.fArgv + result.fSubcommandIndex, fd, delimiter);
 	}
 }
 
-void
-OptionManager::checkConflicts() const {
-	for(OptionMap::const_iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
-		StringSet conflicts = it->second->optionDefinition()->conflictsWith();
-		for(StringSet::const_iterator sit = conflicts.begin(); sit != conflicts.end(); ++sit) {
-			if(hasOption(*sit)) {
-				throw clipp::error::Conflict("Option '" + string(it->second->optionDefinition()->isShortOption() ? "-" : "--") + it->second->name() +
-						"' conflicts with option '" + string((*sit).length() > 1 ? "--" : "-") + (*sit) + "'.");
-			}
+OptionManager::Status
+OptionManager::tryProcess(int argc, char** argv, bool collectAll) {
+	return tryProcess(argc, argv, fResult, collectAll);
+}
+
+OptionManager::Status
+OptionManager::tryProcess(int argc, char** argv, ParseResult& result, bool collectAll) {
+	const CompiledSchema& schema = compile();
+	ParseStats::Scope scope(fStats);
+
+	// Análisis y comprobaciones; sólo si no hay errores se sigue.
+	if(!schema.tryProcess(argc, argv, -1, '\0', result, collectAll, fStats)) {
+		return parseError(result, 0);
+	}
+	try {
+		{
+			ParseStats::Timer timer(fStats, ParseStats::PhaseUpdateVariables);
+			updateVariables(result);
+		}
+		{
+			ParseStats::Timer timer(fStats, ParseStats::PhaseCallbacks);
+			executeFunctionsForOptions(result);
+			executeFunctionForArguments(result);
 		}
+	} catch(clipp::error::Exception& e) {
+		schema.fail(result, e);
+		return parseError(result, 0);
 	}
+
+	// El resto de la línea de comandos es del subcomando.
+	if(result.fSubcommand >= 0) {
+		return subcommandManager(result.fSubcommand).tryProcess(result.fArgc - result.fSubcommandIndex, result.fArgv + result.fSubcommandIndex, collectAll);
+	}
+	Status status = { ERROR_NONE, -1, -1 };
+	return status;
 }
 
-void
-OptionManager::processArguments() const {
-	if(fArgumentsCount.min > 0 && (int)fArguments.size() < fArgumentsCount.min) {
-		throw clipp::error::Length("Must have " + StringFrom<int>(fArgumentsCount.min) + " arguments at least and " + StringFrom<int>(fArguments.size()) + " arguments have been supplied.");
-	} else if(fArgumentsCount.max > 0 && (int)fArguments.size() > fArgumentsCount.max) {
-		throw clipp::error::Length("Must have " + StringFrom<int>(fArgumentsCount.max) + " arguments or less and " + StringFrom<int>(fArguments.size()) + " arguments have been supplied.");
+int
+OptionManager::countErrors() const {
+	return fResult.countErrors();
+}
+
+OptionManager::Status
+OptionManager::parseError(int index) const {
+	return parseError(fResult, index);
+}
+
+OptionManager::Status
+OptionManager::parseError(const ParseResult& result, int index) const {
+	if(index < 0 || index >= result.countErrors()) {
+		throw clipp::error::OutOfBounds("Cannot get error at index " + StringFrom<int>(index) + ". Index out of bounds (0.." + StringFrom<int>(result.countErrors() - 1) + ").");
 	}
+	const ParseResult::Failure& failure = result.fFailures[index];
+	Status status = { static_cast<Error>(failure.error), failure.token, failure.slot };
+	return status;
 }
 
-void
-OptionManager::updateVariables() {
-	for(OptionMap::const_iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
-		it->second->updateVariable();
-	}	
+const string
+OptionManager::errorMessage(int index) const {
+	return errorMessage(fResult, index);
 }
 
-void
-OptionManager::executeFunctionsForOptions() const {
-	for(OptionMap::const_iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
-		const OptionDefinition* od = it->second->optionDefinition();
-		if(od->execute() != NULL) {
-			od->execute()(it->second);
-		}
+const string
+OptionManager::errorMessage(const ParseResult& result, int index) const {
+	if(fSchema == NULL) {
+		throw clipp::error::OutOfBounds("Cannot get error at index " + StringFrom<int>(index) + ". There are no errors.");
 	}
+	return fSchema->errorMessage(result, index);
 }
 
-void
-OptionManager::executeFunctionForArguments() const {
-	if(fExecute != NULL) {
-		int i = 0;
-		for(Strings::const_iterator it = fArguments.begin(); it != fArguments.end(); ++it, i++) {
-			fExecute(*it,i);
-		}
+/**
+ * Escribe las cadenas de un conjunto ordenado que empiezan por un prefijo
+ * (cada una precedida de "before").
+ */
+template <typename Iterator>
+static void
+writePrefixed(ostream& os, Iterator begin, Iterator end, const string& prefix, const string& before) {
+	for(Iterator it = std::lower_bound(begin, end, prefix); it != end && it->compare(0, prefix.length(), prefix) == 0; ++it) {
+		os << before << *it << '\n';
 	}
 }
 
 void
-OptionManager::process() {
-	bool lastArgument = false;
-
-	// El primer elemento es el nombre del programa, que metemos como el argumento posicional cero.
-	fArguments.push_back(popRawOption());
-
-	// Procesamos todas las opciones.
-	while(remainRawOptions() > 0) {
-		string option = popRawOption();
-		if(lastArgument) {
-			fArguments.push_back(option);
-		} else {
-			if(isShortOption(option)) {
-				// Es una opción corta.
-				decodeShortOption(option);
-			} else if(isLongOption(option)) {
-				// Es una opción larga.
-				decodeLongOption(option);
-			} else if(option == consts::ShortOptionMarker) {
-				// Argumento de entrada estándar.
-				fArguments.push_back(option);
-			} else if(option == consts::LongOptionMarker) {
-				// Opción que indica que el resto de opciones son argumentos.
-				lastArgument = true;
+OptionManager::completeWords(int count, char** words, int current, ostream& os) {
+	// La posición viene de la shell (o de quien la llame) sin comprobar.
+	if(current < 0) {
+		return;
+	}
+	const string word = (current < count ? words[current] : "");
+
+	// Lo que hay antes de la palabra: opciones (alguna puede estar esperando
+	// su argumento) y, quizá, el subcomando.
+	const OptionDefinition* expecting = NULL;	// Opción cuyo argumento es la palabra siguiente.
+	const OptionDefinition* last = NULL;		// Última opción con argumento (para "--option" "=" "valor" de bash).
+	bool positional = false;
+	bool onlyArguments = false;
+	for(int i = 1; i < current && i < count; i++) {
+		StringRef item(words[i]);
+		bool isOption = item.length() > 1 && item[0] == consts::OptionIdentifier && !onlyArguments;
+		if(item == StringRef("=") && last != NULL) {
+			// Bash separa "--option=valor" en tres palabras.
+			expecting = last;
+			continue;
+		}
+		if(expecting != NULL) {
+			const OptionDefinition* optdef = expecting;
+			expecting = NULL;
+			// Los argumentos opcionales no se toman si parecen una opción.
+			if(optdef->isArgumentRequired() || !isOption) {
+				last = NULL;
+				continue;
+			}
+		}
+		if(onlyArguments || !isOption) {
+			if(!onlyArguments && !positional && !fSubcommands.empty()) {
+				for(size_t s = 0; s < fSubcommands.size(); s++) {
+					if(item == StringRef(fSubcommands[s].name)) {
+						subcommandManager(s).completeWords(count - i, words + i, current - i, os);
+						return;
+					}
+				}
+				positional = true;
 			} else {
-				// Si no es nada de lo anterior es que es un argumento.
-				fArguments.push_back(option);
+				positional = true;
 			}
+			last = NULL;
+			continue;
+		}
+		if(item == StringRef(consts::LongOptionMarker)) {
+			onlyArguments = true;
+			continue;
 		}
+		// "--option", "-o" o "-abc" (el argumento de la última puede ir pegado).
+		bool isLong = item[1] == consts::OptionIdentifier;
+		StringRef name = item.substr(isLong ? 2 : 1);
+		const OptionDefinition* optdef = NULL;
+		if(isLong) {
+			if(name.find(consts::OptionArgumentSeparator) == StringRef::npos) {
+				optdef = getOptionDefinition(name);
+			}
+		} else if(name.length() == 1) {
+			optdef = getOptionDefinition(name);
+		}
+		last = expecting = (optdef != NULL && optdef->hasArgument() ? optdef : NULL);
 	}
 
-	// Procesamos si están todas las opciones que tiene que estar.
-	checkProcessedOptions();
-
-	// Procesamos si hay conflictos entre opciones.
-	checkConflicts();
+	// Valores: después de una opción con argumento o en "--option=valor".
+	if(word == "=" && last != NULL && last == expecting) {
+		writePrefixed(os, expecting->fValidStrings.begin(), expecting->fValidStrings.end(), "", "");
+		return;
+	}
+	if(expecting != NULL && (expecting->isArgumentRequired() || word.empty() || word[0] != consts::OptionIdentifier)) {
+		writePrefixed(os, expecting->fValidStrings.begin(), expecting->fValidStrings.end(), word, "");
+		return;
+	}
+	if(!onlyArguments && word.length() > 2 && word.compare(0, 2, consts::LongOptionMarker) == 0 && word.find(consts::OptionArgumentSeparator) != string::npos) {
+		string::size_type separator = word.find(consts::OptionArgumentSeparator);
+		const OptionDefinition* optdef = getOptionDefinition(StringRef(word).substr(2, separator - 2));
+		if(optdef != NULL && optdef->hasArgument()) {
+			writePrefixed(os, optdef->fValidStrings.begin(), optdef->fValidStrings.end(), word.substr(separator + 1), word.substr(0, separator + 1));
+		}
+		return;
+	}
 
-	// Procesamos los argumentos (el número correcto).
-	processArguments();
+	// Opciones.
+	if(!onlyArguments && !word.empty() && word[0] == consts::OptionIdentifier) {
+		if(fCompletionIndex.empty()) {
+			fCompletionIndex.reserve(fDefinitions.size());
+			for(OptionDefinitionMap::const_iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
+				if(it->second->isPattern() && it->first == StringRef(it->second->fName)) {
+					continue;
+				}
+				fCompletionIndex.push_back((it->first.length() == 1 ? consts::ShortOptionMarker : consts::LongOptionMarker) + it->first.str());
+			}
+			std::sort(fCompletionIndex.begin(), fCompletionIndex.end());
+		}
+		writePrefixed(os, fCompletionIndex.begin(), fCompletionIndex.end(), word, "");
+		return;
+	}
 
-	// Actualiza las variables (en caso de que haya).
-	updateVariables();
+	// Subcomandos (sólo en la posición del primer argumento).
+	if(!onlyArguments && !positional) {
+		for(SubcommandList::const_iterator it = fSubcommands.begin(); it != fSubcommands.end(); ++it) {
+			if(it->name.compare(0, word.length(), word) == 0) {
+				os << it->name << '\n';
+			}
+		}
+	}
+}
 
-	// Ejectua las funciones definidas para las opciones.
-	executeFunctionsForOptions();
+bool
+OptionManager::complete(int argc, char** argv, ostream& os) {
+	if(argc < 2) {
+		return false;
+	}
+	if(strcmp(argv[1], Completion::ScriptRequest) == 0) {
+		Completion::Shell shell = Completion::ShellBash;
+		if(argc > 2 && !Completion::shell(argv[2], shell)) {
+			throw clipp::error::InvalidArgument("Unknown shell for completion: " + string(argv[2]));
+		}
+		os << Completion::script(shell, argv[0]);
+		return true;
+	}
+	if(strcmp(argv[1], Completion::Request) != 0) {
+		return false;
+	}
+	// "programa --__complete <cword> <palabras...>"
+	if(argc > 3) {
+		completeWords(argc - 3, argv + 3, atoi(argv[2]), os);
+	}
+	os.flush();
+	return true;
+}
 
-	// Ejecuta la función para los argumentos.
-	executeFunctionForArguments();
+void
+OptionManager::stats(ParseStats* stats) {
+	fStats = stats;
+}
 
-	// Actualizamos el iterador de opciones por si se procesan por ID.
-	fOptionsIterator = fOptionsList.begin();
+ParseStats*
+OptionManager::stats() const {
+	return fStats;
 }
 
 int
@@ -448,7 +616,7 @@ OptionManager::countDefinedOptions() const {
 
 int
 OptionManager::countProcessedOptions() const {
-	return fOptions.size();
+	return fResult.countProcessedOptions();
 }
 
 void
@@ -472,44 +640,233 @@ OptionManager::usage() const {
 }
 
 const string
-OptionManager::description(const string title, unsigned int padding) const {
+OptionManager::optionHelp(const OptionDefinition* optdef) const {
+	return (optdef->isShortOption() ? consts::ShortOptionMarker : consts::LongOptionMarker) +	// El separador ("-" o "--").
+		   optdef->name() +	// El nombre de la opción.
+		   (optdef->hasAlias() ? (consts::AliasSeparator + (optdef->alias().length() == 1 ? consts::ShortOptionMarker : consts::LongOptionMarker) + optdef->alias()) : "") +	// El alias (con todo_ lo que lleva).
+		   (optdef->hasArgument() ? " " + argumentHelpDescription(optdef) : "");	// El argumento.
+}
+
+/**
+ * Devuelve el número de caracteres que ocupa un texto en UTF-8 (no se
+ * cuentan los bytes de continuación).
+ */
+static size_t
+displayLength(const char* text, size_t length) {
+	size_t count = 0;
+	for(size_t i = 0; i < length; i++) {
+		if((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) {
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+ * Devuelve cuántos bytes de un texto en UTF-8 ocupan como mucho "columns"
+ * caracteres.
+ */
+static size_t
+displayPrefix(const char* text, size_t length, size_t columns) {
+	size_t count = 0;
+	for(size_t i = 0; i < length; i++) {
+		if((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80) {
+			if(count == columns) {
+				return i;
+			}
+			count++;
+		}
+	}
+	return length;
+}
+
+/**
+ * Añade una descripción partida en líneas de "columns" caracteres como
+ * mucho. Se parte por los espacios, se respetan los saltos de línea y las
+ * palabras que no caben en una línea se cortan. Cada línea después de la
+ * primera empieza con "indent" espacios.
+ */
+static void
+appendWrapped(string& text, const string& description, size_t columns, size_t indent) {
+	const char* data = description.data();
+	size_t length = description.length();
+	size_t position = 0;
+	bool first = true;
+	do {
+		// Una línea del texto original.
+		size_t lineEnd = description.find('\n', position);
+		if(lineEnd == string::npos) {
+			lineEnd = length;
+		}
+		do {
+			if(!first) {
+				text += '\n';
+				text.append(indent, ' ');
+			}
+			first = false;
+			// Lo que queda de la línea cabe entero.
+			if(displayLength(data + position, lineEnd - position) <= columns) {
+				text.append(data + position, lineEnd - position);
+				position = lineEnd;
+				break;
+			}
+			// Se corta en el último espacio que cabe o, si no hay, a la fuerza.
+			size_t fit = position + displayPrefix(data + position, lineEnd - position, columns);
+			size_t cut = fit;
+			while(cut > position && data[cut] != ' ') {
+				cut--;
+			}
+			if(cut == position) {
+				text.append(data + position, fit - position);
+				position = fit;
+			} else {
+				text.append(data + position, cut - position);
+				position = cut;
+			}
+			while(position < lineEnd && data[position] == ' ') {
+				position++;
+			}
+		} while(position < lineEnd);
+		position = lineEnd + 1;
+	} while(position <= length);
+}
+
+void
+OptionManager::renderHelp(string& text, unsigned int width, unsigned int padding) const {
 	if(padding > 32) {
 		// No nos pasemos con el padding... :)
 		padding = 2;
 	}
-	int option_padding = 0;
-	// Hacemos cálculos...
-	for(OptionDefinitionMap::const_iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
-		int calculated = (it->second->isShortOption() ? consts::ShortOptionMarker.length() : consts::LongOptionMarker.length()) +	// Longitud de "-" o "--" dependiendo de si es opción corta o larga.
-						 it->second->name().length() +	// Longitud del nombre de la opción.
-						 (it->second->hasAlias() ? (it->second->alias().length() == 1 ? consts::ShortOptionMarker.length() : consts::LongOptionMarker.length()) : 0) +	// Longitud del alias más "-" o "--" dependiendo de si es corto o largo.
-						 (it->second->hasArgument() ? 2 : 0) +	// Longitud de "[%a]" (lleva argumento opcional).
-						 (it->second->isArgumentRequired() ? 2 : 0);	// Si es requerido, se suma 2.
-		if(calculated > option_padding) {
-			option_padding = calculated;
+	text.clear();
+	if(width == 0) {
+		// Formato de siempre: la columna de las opciones se calcula a partir
+		// de las longitudes de nombres y alias y no se parten las líneas.
+		size_t option_padding = 0;
+		// Hacemos cálculos...
+		for(OptionDefinitionMap::const_iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
+			size_t calculated = (it->second->isShortOption() ? consts::ShortOptionMarker.length() : consts::LongOptionMarker.length()) +	// Longitud de "-" o "--" dependiendo de si es opción corta o larga.
+								it->second->name().length() +	// Longitud del nombre de la opción.
+								(it->second->hasAlias() ? (it->second->alias().length() == 1 ? consts::ShortOptionMarker.length() : consts::LongOptionMarker.length()) : 0) +	// Longitud del alias más "-" o "--" dependiendo de si es corto o largo.
+								(it->second->hasArgument() ? 2 : 0) +	// Longitud de "[%a]" (lleva argumento opcional).
+								(it->second->isArgumentRequired() ? 2 : 0);	// Si es requerido, se suma 2.
+			if(calculated > option_padding) {
+				option_padding = calculated;
+			}
+		}
+		const OptionDefinition* optdef = NULL;
+		for(OptionDefinitionList::const_iterator it = fOrderedDefinitions.begin(); it != fOrderedDefinitions.end(); ++it) {
+			optdef = *it;
+			if(optdef->name() != optdef->alias()) {	// Si la opción del mapa es diferente al alias de la definición, se imprime.
+				string option = optionHelp(optdef);
+				text.append(padding, ' ');
+				text += option;
+				if(option.length() < option_padding) {
+					text.append(option_padding - option.length(), ' ');
+				}
+				text += ' ';
+				text += optdef->description();
+				text += '\n';
+			}
 		}
+		return;
 	}
 
-	stringstream result;
-	string padding_string;
-	padding_string.insert(0,padding,' ');
-	// Imprimimos las opciones. Primero el título, si hay.
-	if(!title.empty()) {
-		result << title << "\n";
-	}
-	// Luego el resto de opciones.
-	const OptionDefinition* optdef = NULL;
+	// Con ancho: la columna de las descripciones se ajusta a la opción más
+	// larga, pero sin pasar de la mitad del ancho. Las opciones más largas
+	// que la columna llevan la descripción en la línea siguiente.
+	size_t limit = width / 2 > padding + 1 ? width / 2 - padding - 1 : 1;
+	std::vector<string> options;
+	options.reserve(fOrderedDefinitions.size());
+	size_t column = 0;
 	for(OptionDefinitionList::const_iterator it = fOrderedDefinitions.begin(); it != fOrderedDefinitions.end(); ++it) {
-		optdef = *it;
-		if(optdef->name() != optdef->alias()) {	// Si la opción del mapa es diferente al alias de la definición, se imprime.
-			string option = (optdef->isShortOption() ? consts::ShortOptionMarker : consts::LongOptionMarker) +	// El separador ("-" o "--").
-							optdef->name() +	// El nombre de la opción.
-							(optdef->hasAlias() ? (consts::AliasSeparator + (optdef->alias().length() == 1 ? consts::ShortOptionMarker : consts::LongOptionMarker) + optdef->alias()) : "") +	// El alias (con todo_ lo que lleva).
-							(optdef->hasArgument() ? " " + argumentHelpDescription(optdef) : "");	// El argumento.
-			result << padding_string << std::setw(option_padding) << std::left << option << " " << optdef->description() << "\n";	// Componemos la ayuda con la opción y la descripción.
+		options.push_back((*it)->name() != (*it)->alias() ? optionHelp(*it) : string());
+		size_t length = displayLength(options.back().data(), options.back().length());
+		if(length > column && length <= limit) {
+			column = length;
 		}
 	}
-	return result.str();
+	size_t indent = padding + column + 1;
+	size_t columns = width > indent + 10 ? width - indent : 10;	// Siempre dejamos algo de sitio para la descripción.
+	for(size_t i = 0; i < options.size(); i++) {
+		const OptionDefinition* optdef = fOrderedDefinitions[i];
+		const string& option = options[i];
+		if(option.empty()) {
+			continue;
+		}
+		size_t length = displayLength(option.data(), option.length());
+		text.append(padding, ' ');
+		text += option;
+		if(length > column) {
+			text += '\n';
+			text.append(indent, ' ');
+		} else {
+			text.append(column - length + 1, ' ');
+		}
+		appendWrapped(text, optdef->description(), columns, indent);
+		text += '\n';
+	}
+}
+
+const string&
+OptionManager::helpLayout(unsigned int width, unsigned int padding) {
+	for(HelpLayoutList::const_iterator it = fHelpLayouts.begin(); it != fHelpLayouts.end(); ++it) {
+		if(it->width == width && it->padding == padding) {
+			return it->text;
+		}
+	}
+	if(fHelpLayouts.size() >= MaxHelpLayouts) {
+		// Descartamos la más antigua.
+		fHelpLayouts.erase(fHelpLayouts.begin());
+	}
+	HelpLayout layout;
+	layout.width = width;
+	layout.padding = padding;
+	fHelpLayouts.push_back(layout);
+	renderHelp(fHelpLayouts.back().text, width, padding);
+	return fHelpLayouts.back().text;
+}
+
+const string
+OptionManager::description(const string title, unsigned int padding) const {
+	// No usa las ayudas guardadas (ver help()): así no modifica nada.
+	string help;
+	renderHelp(help, 0, padding);
+	// Primero el título, si hay.
+	return title.empty() ? help : title + "\n" + help;
+}
+
+void
+OptionManager::help(ostream& os, unsigned int width, unsigned int padding) {
+	const string& text = helpLayout(width, padding);
+	os.write(text.data(), text.length());
+}
+
+size_t
+OptionManager::help(char* buffer, size_t size, unsigned int width, unsigned int padding) {
+	const string& text = helpLayout(width, padding);
+	if(buffer != NULL && size > 0) {
+		size_t copied = text.length() < size ? text.length() : size - 1;
+		memcpy(buffer, text.data(), copied);
+		buffer[copied] = '\0';
+	}
+	return text.length();
+}
+
+unsigned int
+OptionManager::terminalWidth(int fd) {
+	const char* columns = getenv("COLUMNS");
+	if(columns != NULL && atoi(columns) > 0) {
+		return atoi(columns);
+	}
+#ifdef TIOCGWINSZ
+	struct winsize size;
+	if(ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) {
+		return size.ws_col;
+	}
+#else
+	(void)fd;
+#endif
+	return 0;
 }
 
 const string
@@ -522,6 +879,175 @@ OptionManager::argumentCountRange() {
 	return fArgumentsCount;
 }
 
+void
+OptionManager::responseFiles(bool expand) {
+	fResponseFiles = expand;
+	invalidate();
+}
+
+bool
+OptionManager::responseFiles() const {
+	return fResponseFiles;
+}
+
+void
+OptionManager::abbreviations(bool allow) {
+	fAbbreviations = allow;
+	invalidate();
+}
+
+bool
+OptionManager::abbreviations() const {
+	return fAbbreviations;
+}
+
+void
+OptionManager::suggestions(unsigned int count) {
+	fSuggestions = count;
+	invalidate();
+}
+
+unsigned int
+OptionManager::suggestions() const {
+	return fSuggestions;
+}
+
+void
+OptionManager::streamArguments(OnArgumentStreamed streamThis) {
+	fStreamArguments = streamThis;
+	invalidate();
+}
+
+OnArgumentStreamed
+OptionManager::streamArguments() const {
+	return fStreamArguments;
+}
+
+void
+OptionManager::configFile(const string path) {
+	fConfiguration.file(path);
+	fLayeredValues.clear();
+}
+
+const string
+OptionManager::configFile() const {
+	return fConfiguration.file();
+}
+
+void
+OptionManager::environmentPrefix(const string prefix) {
+	fConfiguration.prefix(prefix);
+	fLayeredValues.clear();
+}
+
+const string
+OptionManager::environmentPrefix() const {
+	return fConfiguration.prefix();
+}
+
+bool
+OptionManager::hasValue(const string name) {
+	string text;
+	Configuration::Source source = lookupValue(name, text);
+	if(source == Configuration::SourceNone) {
+		return false;
+	}
+	const OptionDefinition* optdef = getOptionDefinition(StringRef(name));
+	bool set = true;
+	// Las opciones sin argumento sólo están fijadas si valen verdadero.
+	return optdef->hasArgument() || (ParseBoolean(StringRef(text), set) && set);
+}
+
+const string
+OptionManager::value(const string name) {
+	string text;
+	lookupValue(name, text);
+	return text;
+}
+
+Configuration::Source
+OptionManager::valueSource(const string name) {
+	string text;
+	return lookupValue(name, text);
+}
+
+OptionManager&
+OptionManager::subcommandManager(int index) {
+	Subcommand& subcommand = fSubcommands[index];
+	if(subcommand.manager == NULL) {
+		OptionManager* om = new OptionManager();
+		try {
+			subcommand.factory(*om);
+		} catch(...) {
+			delete om;
+			throw;
+		}
+		subcommand.manager = om;
+	}
+	return *subcommand.manager;
+}
+
+void
+OptionManager::subcommand(const string name, SubcommandFactory factory, const string description) {
+	if(name.empty() || name[0] == consts::OptionIdentifier || factory == NULL) {
+		throw clipp::error::OptionDefinition("OptionManager: Cannot add subcommand '" + name + "'. It needs a name not starting with '-' and a factory.");
+	}
+	for(SubcommandList::const_iterator it = fSubcommands.begin(); it != fSubcommands.end(); ++it) {
+		if(it->name == name) {
+			throw clipp::error::AlreadyExists("OptionManager: Cannot add subcommand '" + name + "'. Subcommand already exists.");
+		}
+	}
+	Subcommand subcommand;
+	subcommand.name = name;
+	subcommand.description = description;
+	subcommand.factory = factory;
+	subcommand.manager = NULL;
+	fSubcommands.push_back(subcommand);
+	invalidate();
+}
+
+OptionManager&
+OptionManager::subcommand(const string name) {
+	for(size_t i = 0; i < fSubcommands.size(); i++) {
+		if(fSubcommands[i].name == name) {
+			return subcommandManager(i);
+		}
+	}
+	throw clipp::error::InvalidOption("Invalid subcommand: " + name, name);
+}
+
+int
+OptionManager::countSubcommands() const {
+	return fSubcommands.size();
+}
+
+const string
+OptionManager::selectedSubcommand() const {
+	return fResult.subcommand();
+}
+
+const string
+OptionManager::commands(unsigned int padding) const {
+	if(padding > 32) {
+		padding = 2;
+	}
+	size_t column = 0;
+	for(SubcommandList::const_iterator it = fSubcommands.begin(); it != fSubcommands.end(); ++it) {
+		if(it->name.length() > column) {
+			column = it->name.length();
+		}
+	}
+	string text;
+	for(SubcommandList::const_iterator it = fSubcommands.begin(); it != fSubcommands.end(); ++it) {
+		text.append(padding, ' ');
+		text += it->name;
+		text.append(column - it->name.length() + 1, ' ');
+		text += it->description;
+		text += '\n';
+	}
+	return text;
+}
+
 OptionDefinition&
 OptionManager::option(const string option, int id) {
 	if(option.empty()) {
@@ -531,8 +1057,17 @@ OptionManager::option(const string option, int id) {
 	if(od == NULL) {
 		od = new OptionDefinition(id, option);
 		od->fOwner = this;
-		fDefinitions[option] = od;
+		if(od->isPattern()) {
+			// Un patrón puede encajar con varias opciones distintas.
+			od->fMultiple = true;
+		}
+		od->fSlot = fOrderedDefinitions.size();
+		fDefinitionKeys.push_back(option);
+		fDefinitions[fDefinitionKeys.back()] = od;
 		fOrderedDefinitions.push_back(od);
+		fNextSameId.push_back(-1);
+		linkId(od->fSlot);
+		invalidate();
 	} else {
 		throw clipp::error::AlreadyExists("OptionManager: Cannot add option '" + option + "'. " + (option.length() == 1 ? "Short" : "Long") + " option already exists.");
 	}
@@ -551,8 +1086,11 @@ OptionManager::alias(const string option, const string alias, bool callOptionDef
 		// para que pueda tener un número indeterminado de alias? Mejor lo segundo, digo yo...
 		if(callOptionDefinitionAliasFunction) {
 			od->alias(alias);
+		} else {
+			fDefinitionKeys.push_back(alias);
+			fDefinitions[fDefinitionKeys.back()] = od;
+			invalidate();
 		}
-		fDefinitions[alias] = od;
 	}
 }
 
@@ -563,80 +1101,57 @@ OptionManager::alias(const string option, const string alias) {
 
 bool
 OptionManager::hasOption(const string name) const {
-	return fOptions.find(name) != fOptions.end();
+	return fResult.hasOption(name);
 }
 
 bool
 OptionManager::hasOption(const int id) const {
-	// No hay mapa de opciones por id, así que la búsqueda es secuencial.
-	for(OptionList::const_iterator it = fOptionsList.begin(); it != fOptionsList.end(); ++it) {
-		if((*it)->id() == id) {
-			return true;
-		}
-	}
-	return false;
+	return fResult.hasOption(id);
 }
 
 const Option*
 OptionManager::getOption(const string name) const {
-	OptionMap::const_iterator finder = fOptions.find(name);
-	if(finder != fOptions.end()) {
-		return finder->second;
-	} else {
-		return NULL;
-	}
+	return fResult.getOption(name);
+}
+
+const Option*
+OptionManager::getOption(const int id) const {
+	return fResult.getOption(id);
+}
+
+int
+OptionManager::occurrences(const int id) const {
+	return fResult.occurrences(id);
 }
 
 int
 OptionManager::countArguments() const {
-	return fArguments.size();
+	return fResult.countArguments();
 }
 
 const string
 OptionManager::getArgument(int index) const {
-	if(index >= 0 && index < (int)fArguments.size()) {
-		return fArguments[index];
-	} else {
-		throw clipp::error::OutOfBounds("OptionManager: Cannot get argument at index " + StringFrom<int>(index) + ". Index out of bounds (0.." + StringFrom<int>(fArguments.size() - 1) + ").");
-	}
+	return fResult.getArgument(index);
 }
 
 const string
 OptionManager::firstArgument() const {
-	if(fArguments.size() > 0) {
-		return fArguments[0];
-	} else {
-		throw clipp::error::OutOfBounds("OptionManager: Cannot get first argument. There is no arguments.");
-	}
+	return fResult.firstArgument();
 }
 
 const string
 OptionManager::lastArgument() const {
-	if(fArguments.size() > 0) {
-		return fArguments[fArguments.size()-1];
-	} else {
-		throw clipp::error::OutOfBounds("OptionManager: Cannot get last argument. There is no arguments.");
-	}
+	return fResult.lastArgument();
 }
 
 const Option*
 OptionManager::next() {
-	if(fRawOptions.size() > 0) {
-		// Si hay opciones es que no han sido procesadas, así que no se pueden obtener los ID sin procesar primero.
-		throw clipp::error::Unprocessed("OptionManager: Options are unprocessed. Use 'process()' first.");
-	}
-	if(fOptionsIterator == fOptionsList.end()) {
-		// Si el iterador está al final, devolvemos NULL.
-		return NULL;
-	}
-	Option* option = (*fOptionsIterator);
-	++fOptionsIterator;
-	return option;
+	return fResult.next();
 }
 
 void
 OptionManager::rewind() {
-	fOptionsIterator = fOptionsList.begin();
+	fResult.rewind();
 }
 
 void
@@ -662,21 +1177,21 @@ OptionManager::dump() const {
 
 	stringstream result;
 	result << "OptionManager {\n";
-	result << "     Command line arguments {\n        argc: " << fArgc << "\n";
+	result << "     Command line arguments {\n        argc: " << fResult.fArgc << "\n";
 	result << "        argv:";
 	stringstream lineargv;
 	stringstream itemsargv;
-	for(int i = 0; i < fArgc; i++) {
-		lineargv << " " << fArgv[i];
-		itemsargv << "        argv[" << i << "]=" << fArgv[i] << "\n";
+	for(int i = 0; i < fResult.fArgc; i++) {
+		lineargv << " " << fResult.fArgv[i];
+		itemsargv << "        argv[" << i << "]=" << fResult.fArgv[i] << "\n";
 	}
 	result << lineargv.str() << "\n" << itemsargv.str();
 	result << "\n    }\n";
 	result << "    Options definitions (" << fDefinitions.size() << ") {\n";
 	for(OptionDefinitionMap::const_iterator it = fDefinitions.begin(); it != fDefinitions.end(); ++it) {
-		result << "        Option '" << it->first << "' (id:" << it->second->id() << ")";
+		result << "        Option '" << it->first.str() << "' (id:" << it->second->id() << ")";
 		Strings items;
-		items.push_back(!it->second->alias().empty() && it->first != it->second->alias() ? ("with alias '" + it->second->alias() + "'") : "");
+		items.push_back(!it->second->alias().empty() && it->first != StringRef(it->second->fAlias) ? ("with alias '" + it->second->alias() + "'") : "");
 		items.push_back(it->second->isRequired() ? "is required" : "");
 		items.push_back(it->second->hasArgument() ? (it->second->isArgumentRequired() ? "has required argument" : "has argument") : "");
 		items.push_back(it->second->isMultiple() ? "is multiple" : "");
@@ -684,25 +1199,7 @@ OptionManager::dump() const {
 		result << " " << implode(", ",items) << ".\n";
 	}
 	result << "    }\n";
-	result << "    Options processed (" << fOptions.size() << ") {\n";
-	for(OptionMap::const_iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
-		result << "        Option '" << it->second->name() << "' {\n";
-		result << "              Real name: " << it->second->name() << "\n";
-		result << "            Occurrences: " << it->second->occurrences() << "\n";
-		result << "             Arg. count: " << it->second->countValues() << "\n";
-		result << "              Arguments:";
-		for(int i = 0; i < it->second->countValues(); i++) {
-			result << " " << it->second->getAt(i);
-		}
-		result << "\n        }\n";
-	}
-	result << "    }\n";
-	result << "    Positional arguments(" << fArguments.size() << ") {\n";
-	int i = 0;
-	for(Strings::const_iterator it = fArguments.begin(); it != fArguments.end(); ++it, i++) {
-		result << "        [" << i << "]: " << *it << "\n";
-	}
-	result << "    }\n";
+	result << fResult.dump();
 	result << "}";
 	return result.str();
 }
@@ -714,6 +1211,9 @@ operator << (ostream& os, const OptionManager& om) {
 	string usage = om.usage();
 	os << (usage.empty() ? "" : "Usage: " + usage + "\n");
 	os << om.description("Options:",2);
+	if(om.countSubcommands() > 0) {
+		os << "Commands:\n" << om.commands(2);
+	}
 	return os;
 }
 
@@ -0,0 +1,398 @@
+/*
+ * ParseResult.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+using std::stringstream;
+
+#include "../include/cli++/Exceptions.hpp"
+#include "../include/cli++/OptionDefinition.hpp"
+#include "../include/cli++/OptionManager.hpp"
+#include "../include/cli++/ParseResult.hpp"
+#include "../include/cli++/Utils.hpp"
+
+namespace clipp {
+
+ParseResult::ParseResult()
+	: fOwnArena(),
+	  fArena(&fOwnArena),
+	  fArgc(0),
+	  fArgv(NULL),
+	  fRawIndex(0),
+	  fTokens(0),
+	  fExpandFiles(false),
+	  fPending(),
+	  fHasPending(false),
+	  fResponseFiles(ArenaAllocator<ResponseFile*>(fArena)),
+	  fOpenFiles(ArenaAllocator<ResponseFile*>(fArena)),
+	  fReader(NULL),
+	  fProcessed(false),
+	  fTable(),
+	  fOptions(ArenaAllocator<Option*>(fArena)),
+	  fPresent(NULL),
+	  fOccurrences(ArenaAllocator<Occurrence>(fArena)),
+	  fOptionsIterator(0),
+	  fArguments(ArenaAllocator<StringRef>(fArena)),
+	  fArgumentCount(0),
+	  fSubcommand(-1),
+	  fSubcommandIndex(0),
+	  fFailures(ArenaAllocator<Failure>(fArena)),
+	  fCollect(false),
+	  fCollectAll(false),
+	  fToken(-1)
+{
+}
+
+ParseResult::ParseResult(Arena& arena)
+	: fOwnArena(),
+	  fArena(&arena),
+	  fArgc(0),
+	  fArgv(NULL),
+	  fRawIndex(0),
+	  fTokens(0),
+	  fExpandFiles(false),
+	  fPending(),
+	  fHasPending(false),
+	  fResponseFiles(ArenaAllocator<ResponseFile*>(fArena)),
+	  fOpenFiles(ArenaAllocator<ResponseFile*>(fArena)),
+	  fReader(NULL),
+	  fProcessed(false),
+	  fTable(),
+	  fOptions(ArenaAllocator<Option*>(fArena)),
+	  fPresent(NULL),
+	  fOccurrences(ArenaAllocator<Occurrence>(fArena)),
+	  fOptionsIterator(0),
+	  fArguments(ArenaAllocator<StringRef>(fArena)),
+	  fArgumentCount(0),
+	  fSubcommand(-1),
+	  fSubcommandIndex(0),
+	  fFailures(ArenaAllocator<Failure>(fArena)),
+	  fCollect(false),
+	  fCollectAll(false),
+	  fToken(-1)
+{
+}
+
+ParseResult::~ParseResult() {
+	reset(0, NULL);
+}
+
+void
+ParseResult::reset(int argc, char** argv, bool expandFiles) {
+	// La memoria es de la zona: se destruyen las opciones, los contenedores
+	// se cambian por otros vacíos (sin liberar nada) y luego se libera la
+	// zona de una vez. En la tabla sólo hay que borrar las que estaban, por
+	// las posiciones de sus apariciones: las definiciones pueden estar ya
+	// borradas (el resultado puede durar más que su OptionManager).
+	for(OccurrenceList::const_iterator it = fOccurrences.begin(); it != fOccurrences.end(); ++it) {
+		fTable[it->slot] = NULL;
+	}
+	for(OptionList::iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
+		(*it)->~Option();
+	}
+	// Las opciones ya no referencian los ficheros de respuestas.
+	for(ResponseFileList::iterator it = fResponseFiles.begin(); it != fResponseFiles.end(); ++it) {
+		(*it)->~ResponseFile();
+	}
+	if(fReader != NULL) {
+		fReader->~TokenReader();
+		fReader = NULL;
+	}
+	OptionList options(fOptions.get_allocator());
+	fOptions.swap(options);
+	OccurrenceList occurrences(fOccurrences.get_allocator());
+	fOccurrences.swap(occurrences);
+	ArgumentList arguments(fArguments.get_allocator());
+	fArguments.swap(arguments);
+	ResponseFileList responseFiles(fResponseFiles.get_allocator());
+	fResponseFiles.swap(responseFiles);
+	ResponseFileList openFiles(fOpenFiles.get_allocator());
+	fOpenFiles.swap(openFiles);
+	FailureList failures(fFailures.get_allocator());
+	fFailures.swap(failures);
+	fArena->release();
+	fPresent = NULL;
+	fArgumentCount = 0;
+	fSubcommand = -1;
+	fSubcommandIndex = 0;
+	fOptionsIterator = 0;
+	fProcessed = false;
+	fCollect = false;
+	fCollectAll = false;
+	fToken = -1;
+	fRawIndex = 0;
+	fTokens = 0;
+	fExpandFiles = expandFiles;
+	fHasPending = false;
+	fArgc = (argv != NULL ? argc : 0);
+	fArgv = argv;
+}
+
+bool
+ParseResult::fetchRawOption() {
+	for(;;) {
+		StringRef token;
+		if(!fOpenFiles.empty()) {
+			// Los elementos del fichero que se está leyendo.
+			if(!fOpenFiles.back()->next(token, *fArena)) {
+				// Se deja de leer, pero sigue abierto hasta reset().
+				fOpenFiles.pop_back();
+				continue;
+			}
+		} else if(fRawIndex < fArgc) {
+			token = StringRef(fArgv[fRawIndex++]);
+			if(fRawIndex == 1) {
+				// El nombre del programa no se expande.
+				fPending = token;
+				fHasPending = true;
+				return true;
+			}
+		} else if(fReader == NULL || !fReader->next(token)) {
+			return false;
+		}
+		if(fExpandFiles && ResponseFile::isResponseFile(token)) {
+			openResponseFile(token.substr(1));
+			continue;
+		}
+		fPending = token;
+		fHasPending = true;
+		return true;
+	}
+}
+
+void
+ParseResult::readFrom(int fd, char delimiter) {
+	fReader = new(fArena->allocate(sizeof(TokenReader))) TokenReader(fd, delimiter);
+}
+
+const StringRef
+ParseResult::copy(const StringRef token) {
+	char* data = static_cast<char*>(fArena->allocate(token.length()));
+	memcpy(data, token.data(), token.length());
+	return StringRef(data, token.length());
+}
+
+void
+ParseResult::openResponseFile(const StringRef path) {
+	if(fOpenFiles.size() >= static_cast<ResponseFileList::size_type>(ResponseFile::MaxDepth)) {
+		throw clipp::error::ResponseFile("Too many nested response files: '" + path.str() + "'.", path.str());
+	}
+	ResponseFile* file = new(fArena->allocate(sizeof(ResponseFile))) ResponseFile(path);
+	fResponseFiles.push_back(file);
+	// Un fichero que se incluye a sí mismo (directa o indirectamente)
+	// nunca terminaría.
+	for(ResponseFileList::const_iterator it = fOpenFiles.begin(); it != fOpenFiles.end(); ++it) {
+		if(file->isSameFile(**it)) {
+			throw clipp::error::ResponseFile("Response file '" + path.str() + "' includes itself (through '" + fOpenFiles.back()->path() + "').", path.str());
+		}
+	}
+	fOpenFiles.push_back(file);
+}
+
+void
+ParseResult::prepare(int slots, bool storeArguments) {
+	if(fArgc > 0 && storeArguments) {
+		// Si no se guardan los argumentos, la línea de comandos puede ser
+		// enorme y casi todo argumentos: no se reserva según su tamaño.
+		fOccurrences.reserve(fArgc);
+		fArguments.reserve(fArgc);
+	}
+	if(fTable.size() != static_cast<OptionTable::size_type>(slots)) {
+		fTable.assign(slots, NULL);
+	}
+	// El conjunto de presentes va en la zona, ya liberada por reset().
+	int words = SlotWords(slots);
+	fPresent = static_cast<SlotWord*>(fArena->allocate(words * sizeof(SlotWord)));
+	std::fill(fPresent, fPresent + words, static_cast<SlotWord>(0));
+}
+
+Option*
+ParseResult::findOption(const StringRef name) const {
+	if(fOptions.empty()) {
+		return NULL;
+	}
+	// El nombre se busca en las definiciones del OptionManager de las
+	// opciones; sólo vale el nombre, no los alias.
+	const OptionDefinition* optdef = fOptions.front()->fOptdef->fOwner->getOptionDefinition(name);
+	return optdef != NULL && StringRef(optdef->fName) == name ? findOption(optdef) : NULL;
+}
+
+Option*
+ParseResult::findOption(const OptionDefinition* optdef) const {
+	size_t slot = static_cast<size_t>(optdef->fSlot);
+	return slot < fTable.size() ? fTable[slot] : NULL;
+}
+
+Option*
+ParseResult::findOption(const int id) const {
+	if(fOptions.empty()) {
+		return NULL;
+	}
+	// El OptionManager tiene las posiciones de las definiciones de cada id.
+	const OptionManager* om = fOptions.front()->fOptdef->fOwner;
+	for(int slot = om->firstSlot(id); slot >= 0; slot = om->fNextSameId[slot]) {
+		if(static_cast<size_t>(slot) < fTable.size() && fTable[slot] != NULL) {
+			return fTable[slot];
+		}
+	}
+	return NULL;
+}
+
+Option*
+ParseResult::addOccurrence(const OptionDefinition* optdef, const StringRef argument, const StringRef match) {
+	Option*& option = fTable[optdef->fSlot];
+	if(option == NULL) {
+		option = new(fArena->allocate(sizeof(Option))) Option(optdef, fArena);
+		fOptions.push_back(option);
+		SetSlot(fPresent, optdef->fSlot);
+	} else {
+		option->incOccurrenceCount();
+	}
+	// La aparición se guarda antes de añadir el valor (que puede lanzar una
+	// excepción): reset() borra la tabla por las posiciones de las apariciones.
+	Occurrence occurrence;
+	occurrence.slot = optdef->fSlot;
+	occurrence.first = option->fValues.size();
+	occurrence.count = 0;
+	fOccurrences.push_back(occurrence);
+	option->append(keep(argument));
+	fOccurrences.back().count = option->fValues.size() - occurrence.first;
+	if(!match.empty()) {
+		option->fMatches.push_back(keep(match));
+	}
+	return option;
+}
+
+int
+ParseResult::countProcessedOptions() const {
+	return fOptions.size();
+}
+
+bool
+ParseResult::hasOption(const string name) const {
+	return findOption(StringRef(name)) != NULL;
+}
+
+bool
+ParseResult::hasOption(const int id) const {
+	return findOption(id) != NULL;
+}
+
+const Option*
+ParseResult::getOption(const string name) const {
+	return findOption(StringRef(name));
+}
+
+const Option*
+ParseResult::getOption(const int id) const {
+	return findOption(id);
+}
+
+int
+ParseResult::occurrences(const int id) const {
+	if(fOptions.empty()) {
+		return 0;
+	}
+	const OptionManager* om = fOptions.front()->fOptdef->fOwner;
+	int count = 0;
+	for(int slot = om->firstSlot(id); slot >= 0; slot = om->fNextSameId[slot]) {
+		if(static_cast<size_t>(slot) < fTable.size() && fTable[slot] != NULL) {
+			count += fTable[slot]->occurrences();
+		}
+	}
+	return count;
+}
+
+int
+ParseResult::countArguments() const {
+	return fArgumentCount;
+}
+
+int
+ParseResult::countErrors() const {
+	return fFailures.size();
+}
+
+const string
+ParseResult::subcommand() const {
+	return (fSubcommand >= 0 ? string(fArgv[fSubcommandIndex]) : string());
+}
+
+const string
+ParseResult::getArgument(int index) const {
+	if(index >= 0 && index < (int)fArguments.size()) {
+		return fArguments[index].str();
+	} else {
+		throw clipp::error::OutOfBounds("OptionManager: Cannot get argument at index " + StringFrom<int>(index) + ". Index out of bounds (0.." + StringFrom<int>(fArguments.size() - 1) + ").");
+	}
+}
+
+const string
+ParseResult::firstArgument() const {
+	if(fArguments.size() > 0) {
+		return fArguments[0].str();
+	} else {
+		throw clipp::error::OutOfBounds("OptionManager: Cannot get first argument. There is no arguments.");
+	}
+}
+
+const string
+ParseResult::lastArgument() const {
+	if(fArguments.size() > 0) {
+		return fArguments[fArguments.size()-1].str();
+	} else {
+		throw clipp::error::OutOfBounds("OptionManager: Cannot get last argument. There is no arguments.");
+	}
+}
+
+const Option*
+ParseResult::next() {
+	if(!fProcessed) {
+		// No se pueden obtener los ID sin procesar primero.
+		throw clipp::error::Unprocessed("OptionManager: Options are unprocessed. Use 'process()' first.");
+	}
+	if(fOptionsIterator >= fOccurrences.size()) {
+		// Si el iterador está al final, devolvemos NULL.
+		return NULL;
+	}
+	return fTable[fOccurrences[fOptionsIterator++].slot];
+}
+
+void
+ParseResult::rewind() {
+	fOptionsIterator = 0;
+}
+
+const string
+ParseResult::dump() const {
+	stringstream result;
+	result << "    Options processed (" << fOptions.size() << ") {\n";
+	for(OptionList::const_iterator it = fOptions.begin(); it != fOptions.end(); ++it) {
+		result << "        Option '" << (*it)->name() << "' {\n";
+		result << "              Real name: " << (*it)->name() << "\n";
+		result << "            Occurrences: " << (*it)->occurrences() << "\n";
+		result << "             Arg. count: " << (*it)->countValues() << "\n";
+		result << "              Arguments:";
+		for(int i = 0; i < (*it)->countValues(); i++) {
+			result << " " << (*it)->getAt(i);
+		}
+		result << "\n        }\n";
+	}
+	result << "    }\n";
+	result << "    Positional arguments(" << fArguments.size() << ") {\n";
+	int i = 0;
+	for(ArgumentList::const_iterator it = fArguments.begin(); it != fArguments.end(); ++it, i++) {
+		result << "        [" << i << "]: " << it->str() << "\n";
+	}
+	result << "    }\n";
+	return result.str();
+}
+
+}	// namespace clipp
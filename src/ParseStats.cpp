@@ -0,0 +1,146 @@
+/*
+ * ParseStats.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <sstream>
+#include <ctime>
+
+#include "../include/cli++/ParseStats.hpp"
+
+namespace clipp {
+
+/**
+ * Estadísticas del análisis en curso en cada hilo.
+ */
+#if __cplusplus >= 201103L
+static thread_local ParseStats*	gCurrentStats = NULL;
+#else
+static __thread ParseStats*		gCurrentStats = NULL;
+#endif
+
+/**
+ * Nombres de las fases para dump().
+ */
+static const char*	PhaseNames[ParseStats::PhaseCount] = {
+	"time.decode",
+	"time.checkProcessedOptions",
+	"time.checkConflicts",
+	"time.processArguments",
+	"time.updateVariables",
+	"time.callbacks"
+};
+
+ParseStats::Scope::Scope(ParseStats* stats)
+	: fPrevious(gCurrentStats)
+{
+	gCurrentStats = stats;
+}
+
+ParseStats::Scope::~Scope() {
+	gCurrentStats = fPrevious;
+}
+
+ParseStats::Timer::Timer(ParseStats* stats, Phase phase)
+	: fStats(stats),
+	  fPhase(phase),
+	  fStart(stats != NULL ? ParseStats::now() : 0)
+{
+}
+
+ParseStats::Timer::~Timer() {
+	if(fStats != NULL) {
+		fStats->fTimes[fPhase] += ParseStats::now() - fStart;
+	}
+}
+
+ParseStats::ParseStats() {
+	reset();
+}
+
+ParseStats::~ParseStats() {
+}
+
+ParseStats*
+ParseStats::current() {
+	return gCurrentStats;
+}
+
+unsigned long
+ParseStats::now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ul + ts.tv_nsec;
+}
+
+void
+ParseStats::reset() {
+	fTokens = 0;
+	fLookups = 0;
+	fOptionsCreated = 0;
+	fAllocations = 0;
+	fAllocatedBytes = 0;
+	for(int i = 0; i < PhaseCount; i++) {
+		fTimes[i] = 0;
+	}
+}
+
+void
+ParseStats::allocation(size_t bytes) {
+	ParseStats* stats = gCurrentStats;
+	if(stats != NULL) {
+		stats->fAllocations++;
+		stats->fAllocatedBytes += bytes;
+	}
+}
+
+unsigned long
+ParseStats::tokens() const {
+	return fTokens;
+}
+
+unsigned long
+ParseStats::lookups() const {
+	return fLookups;
+}
+
+unsigned long
+ParseStats::optionsCreated() const {
+	return fOptionsCreated;
+}
+
+unsigned long
+ParseStats::allocations() const {
+	return fAllocations;
+}
+
+unsigned long
+ParseStats::allocatedBytes() const {
+	return fAllocatedBytes;
+}
+
+unsigned long
+ParseStats::time(Phase phase) const {
+	return (phase >= 0 && phase < PhaseCount ? fTimes[phase] : 0);
+}
+
+const string
+ParseStats::dump() const {
+	// Se deshabilitan las estadísticas actuales para no contar las reservas de este método.
+	Scope scope(NULL);
+	std::stringstream out;
+	out << "tokens=" << fTokens << std::endl;
+	out << "lookups=" << fLookups << std::endl;
+	out << "optionsCreated=" << fOptionsCreated << std::endl;
+	out << "allocations=" << fAllocations << std::endl;
+	out << "allocatedBytes=" << fAllocatedBytes << std::endl;
+	for(int i = 0; i < PhaseCount; i++) {
+		out << PhaseNames[i] << "=" << fTimes[i] << std::endl;
+	}
+	return out.str();
+}
+
+}	// namespace clipp
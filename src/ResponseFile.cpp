@@ -0,0 +1,169 @@
+/*
+ * ResponseFile.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/cli++/Exceptions.hpp"
+#include "../include/cli++/ResponseFile.hpp"
+
+namespace clipp {
+
+/**
+ * Devuelve si un carácter separa elementos.
+ */
+static inline bool
+isSeparator(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Devuelve si un carácter obliga a reescribir el elemento (comillas o "\").
+ */
+static inline bool
+isSpecial(char c) {
+	return c == '\'' || c == '"' || c == '\\';
+}
+
+ResponseFile::ResponseFile(const StringRef path)
+	: fData(NULL),
+	  fSize(0),
+	  fCursor(0),
+	  fDevice(0),
+	  fInode(0),
+	  fPath(path.str())
+{
+	int fd = open(fPath.c_str(), O_RDONLY);
+	if(fd < 0) {
+		throw clipp::error::ResponseFile("Cannot open response file '" + fPath + "': " + strerror(errno) + ".", fPath);
+	}
+	struct stat st;
+	if(fstat(fd, &st) != 0) {
+		int error = errno;
+		close(fd);
+		throw clipp::error::ResponseFile("Cannot read response file '" + fPath + "': " + strerror(error) + ".", fPath);
+	}
+	fDevice = st.st_dev;
+	fInode = st.st_ino;
+	fSize = static_cast<size_t>(st.st_size);
+	if(fSize > 0) {
+		// Sólo lectura: las páginas se comparten con la caché del sistema.
+		void* data = mmap(NULL, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED) {
+			int error = errno;
+			close(fd);
+			throw clipp::error::ResponseFile("Cannot map response file '" + fPath + "': " + strerror(error) + ".", fPath);
+		}
+		fData = static_cast<const char*>(data);
+#ifdef MADV_SEQUENTIAL
+		madvise(data, fSize, MADV_SEQUENTIAL);
+#endif
+	}
+	close(fd);	// La proyección sigue siendo válida.
+}
+
+ResponseFile::~ResponseFile() {
+	if(fData != NULL) {
+		munmap(const_cast<char*>(fData), fSize);
+	}
+}
+
+bool
+ResponseFile::next(StringRef& token, Arena& arena) {
+	// Saltamos los separadores.
+	while(fCursor < fSize && isSeparator(fData[fCursor])) {
+		fCursor++;
+	}
+	if(fCursor >= fSize) {
+		return false;
+	}
+
+	// Caso normal: el elemento no tiene nada especial y se referencia tal cual.
+	size_t start = fCursor;
+	while(fCursor < fSize && !isSeparator(fData[fCursor]) && !isSpecial(fData[fCursor])) {
+		fCursor++;
+	}
+	if(fCursor >= fSize || isSeparator(fData[fCursor])) {
+		token = StringRef(fData + start, fCursor - start);
+		return true;
+	}
+
+	// Tiene comillas o "": primero se busca el final del elemento y luego
+	// se copia sin ellas a la zona de memoria del análisis (escribir en la
+	// proyección copiaría la página entera).
+	size_t end = fCursor;
+	char quote = '\0';
+	while(end < fSize && (quote != '\0' || !isSeparator(fData[end]))) {
+		char c = fData[end];
+		if(quote == '\0' && (c == '\'' || c == '"')) {
+			quote = c;
+		} else if(c == quote) {
+			quote = '\0';
+		} else if(c == '\\' && quote != '\'' && end + 1 < fSize) {
+			end++;
+		}
+		end++;
+	}
+	if(quote != '\0') {
+		throw clipp::error::ResponseFile("Unterminated quote in response file '" + fPath + "'.", fPath);
+	}
+	char* copy = static_cast<char*>(arena.allocate(end - start));
+	size_t length = fCursor - start;
+	memcpy(copy, fData + start, length);
+	while(fCursor < end) {
+		char c = fData[fCursor];
+		if(quote == '\'') {
+			if(c == '\'') {
+				quote = '\0';
+			} else {
+				copy[length++] = c;
+			}
+		} else if(quote == '"') {
+			if(c == '"') {
+				quote = '\0';
+			} else if(c == '\\' && fCursor + 1 < end && (fData[fCursor + 1] == '"' || fData[fCursor + 1] == '\\')) {
+				copy[length++] = fData[++fCursor];
+			} else {
+				copy[length++] = c;
+			}
+		} else if(c == '\'' || c == '"') {
+			quote = c;
+		} else if(c == '\\') {
+			if(fCursor + 1 < end) {
+				copy[length++] = fData[++fCursor];
+			}
+		} else {
+			copy[length++] = c;
+		}
+		fCursor++;
+	}
+	token = StringRef(copy, length);
+	return true;
+}
+
+bool
+ResponseFile::isSameFile(const ResponseFile& rf) const {
+	return fDevice == rf.fDevice && fInode == rf.fInode;
+}
+
+const string&
+ResponseFile::path() const {
+	return fPath;
+}
+
+bool
+ResponseFile::isResponseFile(const StringRef token) {
+	return token.length() > 1 && token[0] == Marker;
+}
+
+}	// namespace clipp
@@ -0,0 +1,112 @@
+/*
+ * TokenReader.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <unistd.h>
+
+#include "../include/cli++/Exceptions.hpp"
+#include "../include/cli++/TokenReader.hpp"
+#include "../include/cli++/Utils.hpp"
+
+namespace clipp {
+
+TokenReader::TokenReader(int fd, char delimiter, size_t chunkSize)
+	: fFd(fd),
+	  fDelimiter(delimiter),
+	  fCurrent(0),
+	  fStart(0),
+	  fEnd(0),
+	  fChunkSize(chunkSize > 0 ? chunkSize : DefaultChunkSize),
+	  fEof(false)
+{
+	fBuffers[0] = fBuffers[1] = NULL;
+	fSizes[0] = fSizes[1] = 0;
+}
+
+TokenReader::~TokenReader() {
+	std::free(fBuffers[0]);
+	std::free(fBuffers[1]);
+}
+
+void
+TokenReader::fill() {
+	// Se llena el otro buffer, así que los elementos del actual siguen
+	// siendo válidos mientras se saca el siguiente.
+	int other = 1 - fCurrent;
+	size_t partial = fEnd - fStart;
+	if(fSizes[other] < partial + fChunkSize) {
+		// Sólo crece si hay un elemento más largo que un bloque.
+		char* buffer = static_cast<char*>(std::realloc(fBuffers[other], partial + fChunkSize));
+		if(buffer == NULL) {
+			throw std::bad_alloc();
+		}
+		fBuffers[other] = buffer;
+		fSizes[other] = partial + fChunkSize;
+	}
+	if(partial > 0) {
+		std::memcpy(fBuffers[other], fBuffers[fCurrent] + fStart, partial);
+	}
+	fCurrent = other;
+	fStart = 0;
+	fEnd = partial;
+
+	ssize_t bytes;
+	do {
+		bytes = read(fFd, fBuffers[fCurrent] + fEnd, fSizes[fCurrent] - fEnd);
+	} while(bytes < 0 && errno == EINTR);
+	if(bytes < 0) {
+		throw clipp::error::Input("Cannot read command line elements from descriptor " + StringFrom<int>(fFd) + ": " + strerror(errno) + ".");
+	}
+	if(bytes == 0) {
+		fEof = true;
+	}
+	fEnd += bytes;
+}
+
+bool
+TokenReader::next(StringRef& token) {
+	for(;;) {
+		if(fStart < fEnd) {
+			char* start = fBuffers[fCurrent] + fStart;
+			char* found = static_cast<char*>(std::memchr(start, fDelimiter, fEnd - fStart));
+			if(found != NULL) {
+				fStart += found - start + 1;
+				if(found == start && fDelimiter != '\0') {
+					continue;	// Línea vacía.
+				}
+				token = StringRef(start, found - start);
+				return true;
+			}
+			if(fEof) {
+				// El último elemento no tiene por qué terminar en separador.
+				token = StringRef(start, fEnd - fStart);
+				fStart = fEnd;
+				return true;
+			}
+		} else if(fEof) {
+			return false;
+		}
+		fill();
+	}
+}
+
+bool
+TokenReader::owns(const StringRef token) const {
+	for(int i = 0; i < 2; i++) {
+		if(fBuffers[i] != NULL && token.data() >= fBuffers[i] && token.data() < fBuffers[i] + fSizes[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+}	// namespace clipp
@@ -0,0 +1,227 @@
+/*
+ * ValueParser.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "../include/cli++/ValueParser.hpp"
+
+namespace clipp {
+
+/**
+ * Longitud máxima de un número real que se convierte sin reservar memoria.
+ */
+static const size_t		MaxRealLength	= 128;
+
+static bool
+is_space(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static bool
+is_digit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static int
+digit_value(char c) {
+	if(c >= '0' && c <= '9') {
+		return c - '0';
+	} else if(c >= 'a' && c <= 'z') {
+		return c - 'a' + 10;
+	} else if(c >= 'A' && c <= 'Z') {
+		return c - 'A' + 10;
+	}
+	return 99;
+}
+
+/**
+ * Lee el signo y los dígitos de un entero y acumula su valor absoluto,
+ * comprobando que no supere "limit".
+ *
+ * @return bool True si es correcto, false en otro caso.
+ */
+static bool
+parse_magnitude(const StringRef text, unsigned long limit, int base, bool& negative, unsigned long& magnitude) {
+	size_t i = 0;
+	size_t length = text.length();
+	while(i < length && is_space(text[i])) {
+		i++;
+	}
+	negative = false;
+	if(i < length && (text[i] == '+' || text[i] == '-')) {
+		negative = (text[i] == '-');
+		i++;
+	}
+	if(base == 16 && i + 1 < length && text[i] == '0' && (text[i + 1] == 'x' || text[i + 1] == 'X')) {
+		i += 2;
+	}
+	if(i == length) {
+		return false;
+	}
+	unsigned long result = 0;
+	for(; i < length; i++) {
+		unsigned long digit = digit_value(text[i]);
+		if(digit >= static_cast<unsigned long>(base)) {
+			return false;
+		}
+		if(digit > limit || result > (limit - digit) / base) {
+			// Desbordamiento.
+			return false;
+		}
+		result = result * base + digit;
+	}
+	magnitude = result;
+	return true;
+}
+
+bool
+ParseInteger(const StringRef text, long& value, long min, long max, int base) {
+	bool negative;
+	unsigned long magnitude;
+	// El límite de los negativos es uno más que el de los positivos (en complemento a dos).
+	unsigned long negativeLimit = static_cast<unsigned long>(-(min + 1)) + 1;
+	unsigned long limit = (negativeLimit > static_cast<unsigned long>(max) ? negativeLimit : static_cast<unsigned long>(max));
+	if(!parse_magnitude(text, limit, base, negative, magnitude)) {
+		return false;
+	}
+	if(negative) {
+		if(magnitude > negativeLimit) {
+			return false;
+		}
+		value = (magnitude == 0 ? 0 : -static_cast<long>(magnitude - 1) - 1);
+	} else {
+		if(magnitude > static_cast<unsigned long>(max)) {
+			return false;
+		}
+		value = static_cast<long>(magnitude);
+	}
+	return true;
+}
+
+bool
+ParseUnsigned(const StringRef text, unsigned long& value, unsigned long max, int base) {
+	bool negative;
+	unsigned long magnitude;
+	if(!parse_magnitude(text, max, base, negative, magnitude)) {
+		return false;
+	}
+	if(negative && magnitude != 0) {
+		return false;
+	}
+	value = magnitude;
+	return true;
+}
+
+bool
+ParseReal(const StringRef text, double& value, double max) {
+	size_t length = text.length();
+	size_t i = 0;
+	while(i < length && is_space(text[i])) {
+		i++;
+	}
+	size_t start = i;
+
+	// Se comprueba la sintaxis: [signo] dígitos [. dígitos] [(e|E) [signo] dígitos]
+	if(i < length && (text[i] == '+' || text[i] == '-')) {
+		i++;
+	}
+	size_t digits = 0;
+	while(i < length && is_digit(text[i])) {
+		i++;
+		digits++;
+	}
+	size_t point = StringRef::npos;
+	if(i < length && text[i] == '.') {
+		point = i - start;
+		i++;
+		while(i < length && is_digit(text[i])) {
+			i++;
+			digits++;
+		}
+	}
+	if(digits == 0) {
+		return false;
+	}
+	if(i < length && (text[i] == 'e' || text[i] == 'E')) {
+		i++;
+		if(i < length && (text[i] == '+' || text[i] == '-')) {
+			i++;
+		}
+		size_t exponent = 0;
+		while(i < length && is_digit(text[i])) {
+			i++;
+			exponent++;
+		}
+		if(exponent == 0) {
+			return false;
+		}
+	}
+	if(i != length) {
+		return false;
+	}
+
+	// La sintaxis es correcta; se convierte con "strtod" usando el separador decimal del "locale" actual.
+	size_t size = length - start;
+	char buffer[MaxRealLength + 1];
+	std::string copy;
+	char* number = buffer;
+	if(size > MaxRealLength) {
+		copy.assign(text.data() + start, size);
+		number = &copy[0];
+	} else {
+		std::copy(text.data() + start, text.data() + length, buffer);
+		buffer[size] = '\0';
+	}
+	if(point != StringRef::npos) {
+		number[point] = *std::localeconv()->decimal_point;
+	}
+	errno = 0;
+	double result = std::strtod(number, NULL);
+	if((errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL)) || std::fabs(result) > max) {
+		return false;
+	}
+	value = result;
+	return true;
+}
+
+/**
+ * Compara sin distinguir mayúsculas de minúsculas.
+ */
+static bool
+equals_lower(const StringRef text, const char* lower) {
+	size_t i = 0;
+	for(; i < text.length() && lower[i] != '\0'; i++) {
+		char c = text[i];
+		if(c >= 'A' && c <= 'Z') {
+			c = c - 'A' + 'a';
+		}
+		if(c != lower[i]) {
+			return false;
+		}
+	}
+	return i == text.length() && lower[i] == '\0';
+}
+
+bool
+ParseBoolean(const StringRef text, bool& value) {
+	if(equals_lower(text, "true") || equals_lower(text, "yes") || equals_lower(text, "on") || equals_lower(text, "1")) {
+		value = true;
+		return true;
+	} else if(equals_lower(text, "false") || equals_lower(text, "no") || equals_lower(text, "off") || equals_lower(text, "0")) {
+		value = false;
+		return true;
+	}
+	return false;
+}
+
+}	// namespace clipp
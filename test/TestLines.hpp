@@ -0,0 +1,101 @@
+/*
+ * TestLines.hpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#ifndef TEST_TESTLINES_HPP_
+#define TEST_TESTLINES_HPP_
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Utilidades de las pruebas que procesan líneas de comandos escritas en una
+ * cadena y comparan el resultado con el esperado. Sólo debe incluirse desde
+ * un único fichero por programa, ya que tiene el contador de errores.
+ */
+namespace test {
+
+static int	gErrors = 0;	/// Comprobaciones que han fallado.
+
+/**
+ * Línea de comandos ("argc" y "argv") a partir de una cadena con las
+ * palabras separadas por espacios. El elemento cero es el programa.
+ */
+class Line {
+	public:
+		Line(const char* program, const std::string& text) {
+			std::istringstream in(text);
+			std::string word;
+			while(in >> word) {
+				fWords.push_back(word);
+			}
+			fArgv.push_back(const_cast<char*>(program));
+			for(size_t i = 0; i < fWords.size(); i++) {
+				fArgv.push_back(const_cast<char*>(fWords[i].c_str()));
+			}
+		}
+
+		int argc() const { return static_cast<int>(fArgv.size()); }
+		char** argv() { return &fArgv[0]; }
+
+	private:
+		std::vector<std::string>	fWords;		/// Palabras (fArgv apunta a ellas).
+		std::vector<char*>			fArgv;		/// Programa y palabras.
+
+		/**
+		 * Evitamos que esta clase se pueda clonar o asignar.
+		 */
+		Line(const Line&);
+		Line& operator = (const Line&);
+};
+
+/**
+ * Escribe el resultado de una línea y cuenta un error si no es correcto.
+ *
+ * @param string line Línea procesada.
+ * @param string got Resultado.
+ * @param bool ok Si el resultado es correcto.
+ * @return bool El mismo "ok" (para añadir detalles si ha fallado).
+ */
+inline bool
+check(const std::string& line, const std::string& got, bool ok) {
+	std::cout << "  " << (ok ? "ok    " : "ERROR ") << "'" << line << "' -> " << got << std::endl;
+	if(!ok) {
+		gErrors++;
+	}
+	return ok;
+}
+
+/**
+ * Igual que check(), comparando el resultado con el esperado (que se
+ * escribe si no coinciden).
+ */
+inline bool
+check(const std::string& line, const std::string& got, const std::string& expected) {
+	if(!check(line, got, got == expected)) {
+		std::cout << "        expected: " << expected << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Escribe el resumen y devuelve el código de salida del programa.
+ *
+ * @return int 0 si no ha fallado nada, 1 en otro caso.
+ */
+inline int
+result() {
+	std::cout << (gErrors == 0 ? "OK" : "FAILED") << std::endl;
+	return gErrors == 0 ? 0 : 1;
+}
+
+}	// namespace test
+
+#endif /* TEST_TESTLINES_HPP_ */
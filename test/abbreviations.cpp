@@ -0,0 +1,90 @@
+/*
+ * abbreviations.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "TestLines.hpp"
+
+using namespace clipp;
+
+/**
+ * Abreviaturas de las opciones largas. Sin argumentos se comprueban varias
+ * líneas; con argumentos se procesan como las de un programa normal.
+ */
+
+static void
+define(OptionManager& om) {
+	om.option("verbose").alias("loud").description("Verbose output.");
+	om.option("version").description("Show version.");
+	om.option("output").argumentRequired().description("Output file.");
+	om.option("color").alias("colour").description("Colored output.");
+	om.option("col").argumentRequired().description("Column.");
+}
+
+/**
+ * Procesa una línea (palabras separadas por espacios) y comprueba el
+ * resultado: las opciones procesadas con su valor o el mensaje del error.
+ */
+static void
+expect(OptionManager& om, const string line, const string expected) {
+	test::Line argv("abbreviations", line);
+	string got;
+	try {
+		om.process(argv.argc(), argv.argv());
+		const string names[] = { "verbose", "version", "output", "color", "col" };
+		for(size_t i = 0; i < 5; i++) {
+			const Option* option = om.getOption(names[i]);
+			if(option != NULL) {
+				got += names[i] + (option->isNegated() ? "(no)" : "") + (option->countValues() > 0 ? "=" + option->get() : string()) + " ";
+			}
+		}
+	} catch(clipp::error::Exception& e) {
+		got = e.what();
+	}
+	test::check(line, got, expected);
+}
+
+int
+main(int argc, char** argv) {
+	OptionManager om;
+	define(om);
+	om.abbreviations(true);
+	if(argc > 1) {
+		om.process(argc, argv);
+		cout << "Processed " << om.countProcessedOptions() << " options." << endl;
+		return 0;
+	}
+
+	cout << "Unique prefixes:" << endl;
+	expect(om, "--verb", "verbose ");
+	expect(om, "--out file", "output=file ");
+	expect(om, "--lo", "verbose ");
+	expect(om, "--colo", "color ");
+	cout << "Exact names win:" << endl;
+	expect(om, "--col 3", "col=3 ");
+	cout << "Ambiguous prefixes:" << endl;
+	expect(om, "--ver", "Ambiguous option: --ver (could be --verbose, --version)");
+	expect(om, "--co", "Ambiguous option: --co (could be --col, --color)");
+	cout << "Arguments and negations:" << endl;
+	expect(om, "--out=file", "output=file ");
+	expect(om, "--verb=x", "Invalid argument for option: --verb");
+	expect(om, "--ver=x", "Ambiguous option: --ver (could be --verbose, --version)");
+	expect(om, "--no-verb", "verbose(no) ");
+	expect(om, "--no-ver", "Ambiguous option: --no-ver (could be --verbose, --version)");
+	expect(om, "--x", "Invalid option: --x");
+	cout << "Disabled:" << endl;
+	om.abbreviations(false);
+	expect(om, "--verb", "Invalid option: --verb");
+	expect(om, "--verbose", "verbose ");
+
+	return test::result();
+}
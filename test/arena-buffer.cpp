@@ -0,0 +1,48 @@
+/*
+ * arena-buffer.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Analiza la línea de comandos varias veces con un ParseResult cuya zona de
+ * memoria empieza en un buffer de la pila, y muestra los bytes que ha usado
+ * cada análisis.
+ */
+int
+main(int argc, char** argv) {
+
+	OptionManager om;
+
+	om.option("verbose", 'v').alias("v").multiple().description("More verbose.");
+	om.option("input", 'i').alias("i").argumentRequired().description("Input file.");
+	om.option("define", 'D').alias("D").multiple().argumentRequired().description("Defines a macro.");
+
+	char buffer[2048];
+	Arena arena(buffer, sizeof(buffer));
+	ParseResult result(arena);
+
+	for(int i = 0; i < 3; i++) {
+		try {
+			om.process(argc, argv, result);
+			cout << "Pass " << i + 1 << ": " << result.countProcessedOptions() << " options, "
+				 << result.countArguments() << " arguments, " << arena.used() << " bytes." << endl;
+		} catch(clipp::error::Exception& e) {
+			cerr << "Pass " << i + 1 << ": ERROR: " << e.what() << endl;
+		}
+	}
+
+	cout << result.dump();
+
+	return 0;
+}
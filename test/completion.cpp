@@ -0,0 +1,118 @@
+/*
+ * completion.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Autocompletado de la línea de comandos. Sin argumentos se comprueban los
+ * candidatos de varias líneas a medio escribir; con argumentos se comporta
+ * como un programa normal, así que se puede probar en la shell:
+ *
+ *   source <(./completion --__completion bash)
+ *   ./completion --fo<TAB>
+ */
+
+static int	gErrors = 0;
+
+static void
+remote(OptionManager& om) {
+	om.option("force", 'f').alias("f").description("Force the update.");
+	om.option("url").argumentRequired().description("Remote URL.");
+}
+
+static void
+define(OptionManager& om) {
+	const string formats[] = { "json", "text", "xml" };
+	om.option("format", 'F').alias("F").argumentRequired().validStrings(formats, 3).description("Output format.");
+	om.option("follow").description("Follow links.");
+	om.option("verbose", 'v').alias("v").description("Verbose output.");
+	om.option("level").typeInteger().description("Level.");
+	om.subcommand("remote", remote, "Manages remotes.");
+	om.subcommand("rename", remote, "Renames things.");
+}
+
+/**
+ * Comprueba los candidatos de una línea (las palabras separadas por
+ * espacios; la que se completa es la última).
+ */
+static void
+expect(OptionManager& om, const string line, const string expected) {
+	vector<string> words;
+	words.push_back("completion");
+	istringstream in(line);
+	string word;
+	while(in >> word) {
+		words.push_back(word == "''" ? "" : word);
+	}
+	vector<char*> argv;
+	argv.push_back(const_cast<char*>("completion"));
+	argv.push_back(const_cast<char*>(Completion::Request));
+	string cword = StringFrom<size_t>(words.size() - 1);
+	argv.push_back(const_cast<char*>(cword.c_str()));
+	for(size_t i = 0; i < words.size(); i++) {
+		argv.push_back(const_cast<char*>(words[i].c_str()));
+	}
+	ostringstream out;
+	om.complete(argv.size(), &argv[0], out);
+	string got = out.str();
+	for(string::size_type i = 0; i < got.length(); i++) {
+		if(got[i] == '\n') {
+			got[i] = ' ';
+		}
+	}
+	bool ok = (got == expected);
+	cout << "  " << (ok ? "ok    " : "ERROR ") << "'" << line << "' -> " << got << endl;
+	if(!ok) {
+		cout << "        expected: " << expected << endl;
+		gErrors++;
+	}
+}
+
+int
+main(int argc, char** argv) {
+	OptionManager om;
+	define(om);
+	if(om.complete(argc, argv)) {
+		return 0;
+	}
+	if(argc > 1) {
+		om.process(argc, argv);
+		cout << "Processed " << om.countProcessedOptions() << " options." << endl;
+		return 0;
+	}
+
+	cout << "Options:" << endl;
+	expect(om, "--fo", "--follow --format ");
+	expect(om, "-", "--follow --format --level --verbose -F -v ");
+	expect(om, "--x", "");
+	cout << "Values:" << endl;
+	expect(om, "--format ''", "json text xml ");
+	expect(om, "-F t", "text ");
+	expect(om, "--format=x", "--format=xml ");
+	expect(om, "--format = j", "json ");
+	expect(om, "--format =", "json text xml ");
+	expect(om, "--format json --f", "--follow --format ");
+	cout << "Subcommands:" << endl;
+	expect(om, "re", "remote rename ");
+	expect(om, "-v re", "remote rename ");
+	expect(om, "remote --", "--force --url ");
+	expect(om, "file re", "");
+	expect(om, "-- --f", "");
+	cout << "Script:" << endl << Completion::script(Completion::ShellBash, "/usr/bin/my-tool");
+
+	cout << (gErrors == 0 ? "OK" : "FAILED") << endl;
+	return gErrors == 0 ? 0 : 1;
+}
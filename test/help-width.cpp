@@ -0,0 +1,52 @@
+/*
+ * help-width.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Ayuda ajustada al ancho de la terminal (o al que se pase como primer
+ * argumento). Las descripciones largas se parten por palabras y las
+ * opciones muy largas llevan la descripción en la línea siguiente.
+ */
+int
+main(int argc, char** argv) {
+
+	OptionManager om;
+
+	om.option("help", 'h').alias("h").exclusive().description("Shows this help.");
+	om.option("input", 'i').alias("i").argumentRequired().description("Input file. If it is not given, the input is read from the standard input, so the program can be used in a pipe.");
+	om.option("threads", 't').alias("t").argumentRequired().typeInteger().description("Number of threads.\nBy default, one per processor.");
+	om.option("a-very-long-option-name-that-does-not-fit").argument().description("Its description goes in the next line.");
+	om.option("hash").argumentRequired().description("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef");
+
+	unsigned int width = argc > 1 ? atoi(argv[1]) : OptionManager::terminalWidth();
+	if(width == 0) {
+		width = 80;
+	}
+
+	cout << "Width " << width << ":" << endl;
+	om.help(cout, width);
+
+	// La segunda vez ya está compuesta.
+	char buffer[4096];
+	size_t length = om.help(buffer, sizeof(buffer), width);
+	cout << "Length: " << length << " (cached)" << endl;
+
+	// Sin ancho, el formato de siempre.
+	cout << "Without width:" << endl;
+	om.help(cout);
+
+	return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * layered-config.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Valores de las opciones por capas: valor por defecto < fichero de
+ * configuración < variables de entorno (LAYERED_*) < línea de comandos.
+ * Se muestra de dónde viene cada valor, que los valores se comprueban como
+ * los de la línea de comandos, que las variables de las opciones toman el
+ * valor de las capas y que el fichero no se lee si no hace falta.
+ */
+
+static int	gErrors = 0;
+
+static void
+expect(OptionManager& om, const string name, const string value, Configuration::Source source) {
+	string got = om.value(name);
+	Configuration::Source from = om.valueSource(name);
+	cout << "  " << name << " = '" << got << "' (" << Configuration::sourceName(from) << ")" << endl;
+	if(got != value || from != source) {
+		cout << "    ERROR: expected '" << value << "' (" << Configuration::sourceName(source) << ")" << endl;
+		gErrors++;
+	}
+}
+
+int
+main(int argc, char** argv) {
+	const char* path = "/tmp/clipp-layered.ini";
+	FILE* out = fopen(path, "w");
+	fprintf(out, "# Configuración de prueba\n"
+				 "level = 3\n"
+				 "output = \"from file.txt\"\n"
+				 "mode = fast\n"
+				 "verbose\n"
+				 "\n"
+				 "[network]\n"
+				 "port = 8080\n");
+	fclose(out);
+
+	int level = 0;
+	string output;
+
+	OptionManager om;
+	om.option("level", 'l').alias("l").var(&level).defaultValue("1");
+	om.option("output", 'o').alias("o").var(&output).defaultValue("a.out");
+	const string modes[] = { "fast", "safe" };
+	om.option("mode").argumentRequired().validStrings(modes, 2);
+	om.option("network.port").type(OptionDefinition::TypeInteger).argumentRequired();
+	om.option("verbose", 'v').alias("v");
+	om.option("dry-run");
+	om.option("color").type(OptionDefinition::TypeString).argumentRequired().defaultValue("auto");
+	om.configFile(path);
+	om.environmentPrefix("LAYERED");
+
+	setenv("LAYERED_LEVEL", "5", 1);
+	setenv("LAYERED_DRY_RUN", "yes", 1);
+	unsetenv("LAYERED_OUTPUT");
+
+	char* line[] = { const_cast<char*>("layered-config"), const_cast<char*>("--color"), const_cast<char*>("never") };
+	om.process(3, line);
+
+	cout << "Layers:" << endl;
+	expect(om, "color", "never", Configuration::SourceCommandLine);
+	expect(om, "level", "5", Configuration::SourceEnvironment);
+	expect(om, "output", "from file.txt", Configuration::SourceFile);
+	expect(om, "network.port", "8080", Configuration::SourceFile);
+	expect(om, "dry-run", "yes", Configuration::SourceEnvironment);
+	expect(om, "verbose", "true", Configuration::SourceFile);
+	expect(om, "unknown", "", Configuration::SourceNone);
+	if(om.value<int>("network.port", 0) != 8080 || !om.value<bool>("dry-run", false) || !om.hasValue("verbose")) {
+		cout << "  ERROR: typed values" << endl;
+		gErrors++;
+	}
+
+	cout << "Variables: level = " << level << ", output = '" << output << "'" << endl;
+	if(level != 5 || output != "from file.txt") {
+		gErrors++;
+	}
+
+	cout << "Validation:" << endl;
+	setenv("LAYERED_LEVEL", "high", 1);
+	om.environmentPrefix("LAYERED");	// Se olvidan los valores ya resueltos.
+	try {
+		om.value("level");
+		cout << "  ERROR: no exception" << endl;
+		gErrors++;
+	} catch(clipp::error::InvalidArgument& e) {
+		cout << "  " << e.what() << endl;
+	}
+	setenv("LAYERED_DRY_RUN", "maybe", 1);
+	try {
+		om.hasValue("dry-run");
+		cout << "  ERROR: no exception" << endl;
+		gErrors++;
+	} catch(clipp::error::InvalidArgument& e) {
+		cout << "  " << e.what() << endl;
+	}
+	setenv("LAYERED_MODE", "turbo", 1);
+	try {
+		om.value("mode");
+		cout << "  ERROR: no exception" << endl;
+		gErrors++;
+	} catch(clipp::error::InvalidArgument& e) {
+		cout << "  " << e.what() << endl;
+	}
+	unsetenv("LAYERED_LEVEL");
+	unsetenv("LAYERED_DRY_RUN");
+	unsetenv("LAYERED_MODE");
+
+	cout << "Lazy loading:" << endl;
+	om.configFile("/tmp/clipp-layered-missing.ini");
+	om.environmentPrefix("");
+	expect(om, "color", "never", Configuration::SourceCommandLine);
+	try {
+		om.value("output");
+		cout << "  ERROR: no exception" << endl;
+		gErrors++;
+	} catch(clipp::error::Configuration& e) {
+		cout << "  " << e.what() << endl;
+	}
+	om.configFile("");
+	expect(om, "output", "a.out", Configuration::SourceDefault);
+	expect(om, "level", "1", Configuration::SourceDefault);
+
+	remove(path);
+	cout << (gErrors == 0 ? "OK" : "FAILED") << endl;
+	return gErrors == 0 ? 0 : 1;
+}
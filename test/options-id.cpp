@@ -47,5 +47,11 @@ main(int argc, char** argv) {
 		}
 	}
 
+	// Las mismas opciones consultadas directamente por id.
+	for(int id = 1; id <= 3; id++) {
+		const clipp::Option* option = om.getOption(id);
+		cout << "Id " << id << ": " << (option != NULL ? "'" + option->name() + "'" : string("absent")) << ", " << om.occurrences(id) << " occurrence(s)." << endl;
+	}
+
 	return 0;
 }
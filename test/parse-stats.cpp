@@ -0,0 +1,45 @@
+/*
+ * parse-stats.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+#include <cli++/CountingNew.hpp>
+
+using namespace clipp;
+
+/**
+ * Analiza la línea de comandos tomando estadísticas y las muestra como
+ * "clave=valor". Las reservas de memoria se cuentan gracias a
+ * <cli++/CountingNew.hpp>.
+ */
+int
+main(int argc, char** argv) {
+
+	OptionManager om(argc, argv);
+	ParseStats stats;
+
+	int count = 0;
+
+	om.option("verbose", 'v').alias("v").multiple().description("More verbose.");
+	om.option("input", 'i').alias("i").argumentRequired().description("Input file.");
+	om.option("count", 'c').alias("c").var(&count).description("Count.");
+	om.stats(&stats);
+
+	try {
+		om.process();
+	} catch(clipp::error::Exception& e) {
+		cerr << "ERROR: " << e.what() << endl;
+	}
+
+	cout << stats.dump();
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * patterns.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "TestLines.hpp"
+
+using namespace clipp;
+
+/**
+ * Opciones con un patrón como nombre: un envoltorio que entiende algunas
+ * opciones y reenvía las demás al programa que ejecuta. Sin argumentos se
+ * comprueban varias líneas; con argumentos se escribe lo que se reenviaría.
+ */
+
+static string	gForwarded;
+
+static int
+forward(const Option* option) {
+	for(int i = 0; i < option->countMatches(); i++) {
+		gForwarded += option->matchAt(i) + " ";
+	}
+	return 0;
+}
+
+static void
+define(OptionManager& om) {
+	om.option("verbose", 'v').alias("v").description("Verbose output.");
+	om.option("jobs", 'j').alias("j").argumentRequired().description("Parallel jobs.");
+	om.option("*").description("Passed to the child tool.").execute(forward);
+	om.option("%n").description("Numeric level, like -2.");
+	om.option("W*").argumentRequired().description("Warnings, like -Wall or --Werror=x.");
+}
+
+/**
+ * Procesa una línea (palabras separadas por espacios) y comprueba qué
+ * elementos ha recogido cada patrón (o el mensaje del error).
+ */
+static void
+expect(OptionManager& om, const string line, const string expected) {
+	test::Line argv("patterns", line);
+	string got;
+	gForwarded.clear();
+	try {
+		om.process(argv.argc(), argv.argv());
+		const string patterns[] = { "%n", "W*" };
+		for(size_t p = 0; p < 2; p++) {
+			const Option* option = om.getOption(patterns[p]);
+			for(int i = 0; option != NULL && i < option->countMatches(); i++) {
+				got += patterns[p] + ":" + option->matchAt(i) + (i < option->countValues() ? "=" + option->getAt(i) : string()) + " ";
+			}
+		}
+		got += "*:" + gForwarded;
+		if(om.getOption("verbose") != NULL) {
+			got += "verbose";
+		}
+	} catch(clipp::error::Exception& e) {
+		got = e.what();
+	}
+	test::check(line, got, expected);
+}
+
+int
+main(int argc, char** argv) {
+	OptionManager om;
+	define(om);
+	if(argc > 1) {
+		om.process(argc, argv);
+		cout << "Forwarded: " << gForwarded << endl;
+		return 0;
+	}
+
+	cout << "Exact names first:" << endl;
+	expect(om, "-v --jobs 4", "*:verbose");
+	cout << "Catch-all:" << endl;
+	expect(om, "--color -x --depth=3 -v", "*:--color -x --depth=3 verbose");
+	expect(om, "--no-color", "*:--no-color ");
+	expect(om, "--no-verbose", "*:verbose");
+	cout << "More specific patterns first:" << endl;
+	expect(om, "-2 -10 --3", "%n:-2 %n:-10 %n:--3 *:");
+	expect(om, "-2x", "*:-2x ");
+	expect(om, "-Wall x --Werror=format", "W*:-Wall=x W*:--Werror=format=format *:");
+	expect(om, "-Wall", "Argument required for option: --Wall");
+	cout << "Operands:" << endl;
+	expect(om, "-- --color", "*:");
+
+	cout << "Long names:" << endl;
+	OptionManager many;
+	many.option("*x*x*x*x*x*x*y").description("Many pieces.");
+	const string names[] = { "--" + string(5000, 'x'), "--" + string(5000, 'x') + "y" };
+	for(size_t i = 0; i < 2; i++) {
+		test::Line argv("patterns", names[i]);
+		bool matched = (many.tryProcess(argv.argc(), argv.argv()).error == OptionManager::ERROR_NONE);
+		test::check(names[i].substr(0, 4) + "..." + names[i].substr(names[i].length() - 2), matched ? "matched" : "invalid", i == 1 ? "matched" : "invalid");
+	}
+
+	return test::result();
+}
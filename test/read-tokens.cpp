@@ -0,0 +1,115 @@
+/*
+ * read-tokens.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Elementos de la línea de comandos leídos de un descriptor después de
+ * "argv": separados por '\0' (como "find -print0") y por saltos de línea.
+ * El fichero tiene varios bloques de lectura, así que hay elementos y
+ * opciones con su valor partidos entre dos bloques; los valores de las
+ * opciones se guardan y los argumentos se cuentan sin guardarlos.
+ *
+ * También se puede usar con la entrada estándar:
+ *
+ *   find . -print0 | ./read-tokens -0
+ */
+
+static long	gArguments = 0;
+static long	gBad = 0;
+
+static int
+onArgument(const StringRef argument, int position) {
+	// Los argumentos son "file-N.txt", con N = posición - 1 (salvo los de "argv").
+	ostringstream expected;
+	expected << "file-" << (position - 2) << ".txt";
+	if(position > 1 && argument.str() != expected.str()) {
+		gBad++;
+	}
+	gArguments++;
+	return 0;
+}
+
+static bool
+check(OptionManager& om, const char* path, char delimiter, long count) {
+	FILE* out = fopen(path, "w");
+	for(long i = 0; i < count; i++) {
+		fprintf(out, "file-%ld.txt%c", i, delimiter);
+		if(i % 1000 == 0) {
+			fprintf(out, "-D%cvalue-%ld%c", delimiter, i, delimiter);
+			if(delimiter == '\n') {
+				fprintf(out, "\n");	// Las líneas vacías no cuentan.
+			}
+		}
+	}
+	fclose(out);
+
+	int fd = open(path, O_RDONLY);
+	const char* argv[] = { "read-tokens", "first-argument" };
+	gArguments = gBad = 0;
+	try {
+		om.process(2, const_cast<char**>(argv), fd, delimiter);
+	} catch(clipp::error::Exception& e) {
+		cerr << "ERROR: " << e.what() << endl;
+		close(fd);
+		return false;
+	}
+	close(fd);
+	remove(path);
+
+	const Option* define = om.getOption("define");
+	long badValues = 0;
+	for(int i = 0; define != NULL && i < define->countValues(); i++) {
+		ostringstream expected;
+		expected << "value-" << (i * 1000);
+		if(define->getAt(i) != expected.str()) {
+			badValues++;
+		}
+	}
+	cout << (delimiter == '\0' ? "NUL" : "Newline") << " delimited: "
+		 << gArguments << " arguments (" << gBad << " wrong), "
+		 << (define != NULL ? define->countValues() : 0) << " values of -D (" << badValues << " wrong), "
+		 << "countArguments() = " << om.countArguments() << endl;
+	return gBad == 0 && badValues == 0 && gArguments == count + 1;
+}
+
+int
+main(int argc, char** argv) {
+
+	OptionManager om;
+	om.option("define", 'D').alias("D").multiple().argumentRequired().description("Defines a macro.");
+	om.option("null", '0').alias("0").description("Elements in the standard input are separated by NUL.");
+	om.streamArguments(onArgument);
+
+	if(argc > 1) {
+		// Los elementos de la entrada estándar.
+		om.streamArguments(NULL);
+		bool null = (string(argv[1]) == "-0");
+		om.process(argc, argv, 0, null ? '\0' : '\n');
+		for(int i = 1; i < om.countArguments(); i++) {
+			cout << "Argument: " << om.getArgument(i) << endl;
+		}
+		return 0;
+	}
+
+	bool ok = check(om, "/tmp/clipp-read-tokens-0", '\0', 50000);
+	ok = check(om, "/tmp/clipp-read-tokens-n", '\n', 50000) && ok;
+
+	return ok ? 0 : 1;
+}
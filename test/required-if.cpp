@@ -0,0 +1,45 @@
+/*
+ * required-if.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Opciones obligatorias según otras: "--output" es obligatoria si está
+ * "--input", e "--input" lo es si no están ni "--stdin" ni "--url".
+ * "--stdin" tiene conflicto con "--url".
+ */
+int
+main(int argc, char** argv) {
+
+	OptionManager om(argc, argv);
+
+	om.option("input", 'i').alias("i").argumentRequired().requiredIfNotOption("stdin").requiredIfNotOption("url").description("Input file.");
+	om.option("output", 'o').alias("o").argumentRequired().requiredIfOption("input").description("Output file.");
+	om.option("stdin").conflictsWith("url").description("Reads from the standard input.");
+	om.option("url").argumentRequired().description("Reads from an URL.");
+
+	try {
+		om.process();
+	} catch(clipp::error::Exception& e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+
+	const Option* op;
+	while((op = om.next()) != NULL) {
+		cout << "Option '" << op->name() << "'" << (op->countValues() > 0 ? ": " + op->get() : "") << endl;
+	}
+
+	return 0;
+}
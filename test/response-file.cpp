@@ -0,0 +1,92 @@
+/*
+ * response-file.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Ficheros de respuestas: la línea de comandos se completa con los
+ * elementos de "@fichero", con comillas, "\" y ficheros anidados. Un
+ * fichero que se incluye a sí mismo es un error.
+ */
+
+static void
+write(const char* path, const char* content) {
+	ofstream out(path);
+	out << content;
+}
+
+static void
+show(OptionManager& om, int argc, const char** argv) {
+	try {
+		om.process(argc, const_cast<char**>(argv));
+	} catch(clipp::error::Exception& e) {
+		cout << "ERROR: " << e.what() << endl;
+		return;
+	}
+	const char* names[] = { "define", "output", "verbose" };
+	for(int n = 0; n < 3; n++) {
+		const Option* op = om.getOption(names[n]);
+		if(op != NULL) {
+			cout << "Option '" << op->name() << "':";
+			for(int i = 0; i < op->countValues(); i++) {
+				cout << " [" << op->getAt(i) << "]";
+			}
+			cout << endl;
+		}
+	}
+	for(int i = 1; i < om.countArguments(); i++) {
+		cout << "Argument: [" << om.getArgument(i) << "]" << endl;
+	}
+}
+
+int
+main() {
+
+	OptionManager om;
+	om.responseFiles(true);
+
+	om.option("define", 'D').alias("D").multiple().argumentRequired().description("Defines a macro.");
+	om.option("output", 'o').alias("o").argumentRequired().description("Output file.");
+	om.option("verbose", 'v').alias("v").description("More verbose output.");
+
+	write("/tmp/clipp-response-1.rsp", "-DNAME=value\n-D 'QUOTED=a b'\n--output \"out file.o\"\n@/tmp/clipp-response-2.rsp\nlast\\ argument\n");
+	write("/tmp/clipp-response-2.rsp", "-v\tnested.c  \"with \\\"quotes\\\"\"\n");
+	write("/tmp/clipp-response-3.rsp", "a.c @/tmp/clipp-response-4.rsp");
+	write("/tmp/clipp-response-4.rsp", "b.c @/tmp/clipp-response-3.rsp");
+
+	const char* nested[] = { "response-file", "first.c", "@/tmp/clipp-response-1.rsp", "-D", "AFTER" };
+	cout << "Nested response files:" << endl;
+	show(om, 5, nested);
+
+	const char* cycle[] = { "response-file", "@/tmp/clipp-response-3.rsp" };
+	cout << "Cycle:" << endl;
+	show(om, 2, cycle);
+
+	const char* missing[] = { "response-file", "@/tmp/clipp-response-missing.rsp" };
+	cout << "Missing file:" << endl;
+	show(om, 2, missing);
+
+	om.responseFiles(false);
+	cout << "Without expansion:" << endl;
+	show(om, 5, nested);
+
+	remove("/tmp/clipp-response-1.rsp");
+	remove("/tmp/clipp-response-2.rsp");
+	remove("/tmp/clipp-response-3.rsp");
+	remove("/tmp/clipp-response-4.rsp");
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * reuse-manager.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Analiza varias líneas de comandos con las mismas definiciones, primero
+ * con el resultado interno del OptionManager y luego con un ParseResult
+ * propio que se reutiliza. Si se pasan argumentos, se analizan también.
+ */
+int
+main(int argc, char** argv) {
+
+	OptionManager om;
+
+	om.option("verbose", 'v').alias("v").multiple().description("More verbose.");
+	om.option("input", 'i').alias("i").argumentRequired().description("Input file.");
+	om.option("count", 'c').argumentRequired().typeInteger().description("Count.");
+
+	const char* line1[] = { "reuse-manager", "-v", "--input", "a.txt", "arg1" };
+	const char* line2[] = { "reuse-manager", "--count=3", "-vv", "arg1", "arg2" };
+	const char* line3[] = { "reuse-manager", "--unknown" };
+
+	const char** lines[] = { line1, line2, line3 };
+	int counts[] = { 5, 5, 2 };
+
+	ParseResult result;
+	for(int i = 0; i < 3; i++) {
+		try {
+			const ParseResult& r = om.process(counts[i], const_cast<char**>(lines[i]));
+			cout << "Line " << i + 1 << ": " << r.countProcessedOptions() << " options, " << r.countArguments() << " arguments." << endl;
+			const Option* op;
+			while((op = om.next()) != NULL) {
+				cout << "  Option '" << op->name() << "' (" << op->occurrences() << ")" << (op->countValues() > 0 ? ": " + op->get() : "") << endl;
+			}
+
+			// El mismo análisis con un resultado propio (el OptionManager no cambia).
+			om.process(counts[i], const_cast<char**>(lines[i]), result);
+			cout << "  Own result: " << result.countProcessedOptions() << " options, last argument: " << result.lastArgument() << endl;
+		} catch(clipp::error::Exception& e) {
+			cerr << "Line " << i + 1 << ": ERROR: " << e.what() << endl;
+		}
+	}
+
+	if(argc > 1) {
+		try {
+			om.process(argc, argv, result);
+			cout << "Command line: " << result.countProcessedOptions() << " options, " << result.countArguments() << " arguments." << endl;
+		} catch(clipp::error::Exception& e) {
+			cerr << "Command line: ERROR: " << e.what() << endl;
+		}
+	}
+
+	return 0;
+}
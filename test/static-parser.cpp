@@ -0,0 +1,127 @@
+/*
+ * static-parser.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+#include <cli++/StaticParser.hpp>
+
+using namespace clipp;
+
+/**
+ * Analiza varias líneas de comandos con un esquema en tiempo de compilación
+ * y con el mismo esquema en un OptionManager, y muestra el resultado o el
+ * error de los dos (tienen que coincidir). Si se pasan argumentos, se
+ * analizan también.
+ */
+
+static int	gErrors = 0;
+
+struct Help : StaticOption<bool, StaticExclusive, 'h'> {
+	static constexpr const char* name() { return "help"; }
+};
+struct Verbose : StaticOption<bool, StaticMultiple, 'v'> {
+	static constexpr const char* name() { return "verbose"; }
+};
+struct Input : StaticOption<StringRef, StaticRequired, 'i'> {
+	static constexpr const char* name() { return "input"; }
+};
+struct Threads : StaticOption<int, StaticNone, 't'> {
+	static constexpr const char* name() { return "threads"; }
+};
+struct Ratio : StaticOption<double> {
+	static constexpr const char* name() { return "ratio"; }
+};
+struct Define : StaticOption<string, StaticMultiple, 'D'> {
+	static constexpr const char* name() { return "define"; }
+};
+
+typedef StaticParser<Help, Verbose, Input, Threads, Ratio, Define>	Parser;
+
+static string
+runStatic(Parser& parser, int argc, char** argv) {
+	try {
+		parser.process(argc, argv);
+	} catch(clipp::error::Exception& e) {
+		return string("ERROR: ") + e.what();
+	}
+	string result = "input=" + parser.get<Input>().str() + " verbose=" + StringFrom<unsigned>(parser.occurrences<Verbose>()) +
+			" threads=" + StringFrom<int>(parser.get<Threads>()) + " ratio=" + StringFrom<double>(parser.get<Ratio>()) + " defines=";
+	for(size_t i = 0; i < parser.get<Define>().size(); i++) {
+		result += parser.get<Define>()[i] + ";";
+	}
+	return result + " arguments=" + StringFrom<int>(parser.countArguments() - 1);
+}
+
+static string
+runDynamic(OptionManager& om, int argc, char** argv) {
+	try {
+		om.process(argc, argv);
+	} catch(clipp::error::Exception& e) {
+		return string("ERROR: ") + e.what();
+	}
+	string result = "input=" + om.getOption("input")->get() + " verbose=" + StringFrom<int>(om.hasOption("verbose") ? om.getOption("verbose")->occurrences() : 0) +
+			" threads=" + StringFrom<int>(om.hasOption("threads") ? om.getOption("threads")->get<int>(0) : 0) +
+			" ratio=" + StringFrom<double>(om.hasOption("ratio") ? om.getOption("ratio")->get<double>(0) : 0) + " defines=";
+	const Option* define = om.getOption("define");
+	for(int i = 0; define != NULL && i < define->countValues(); i++) {
+		result += define->getAt(i) + ";";
+	}
+	return result + " arguments=" + StringFrom<int>(om.countArguments() - 1);
+}
+
+int
+main(int argc, char** argv) {
+
+	OptionManager om;
+	om.option("help").alias("h").exclusive();
+	om.option("verbose").alias("v").multiple();
+	om.option("input").alias("i").argumentRequired().required();
+	om.option("threads").alias("t").argumentRequired().typeInteger();
+	om.option("ratio").argumentRequired().typeFloat();
+	om.option("define").alias("D").argumentRequired().multiple();
+
+	Parser parser;
+
+	const char* lines[][6] = {
+		{ "prog", "-vv", "--input", "a.txt", "--threads=4", "file" },
+		{ "prog", "-ia.txt", "-DX=1", "--define", "Y", "--ratio=0.5" },
+		{ "prog", "--input", "a.txt", "--threads", "four", NULL },
+		{ "prog", "-v", NULL },
+		{ "prog", "-h", "-v", NULL },
+		{ "prog", "--input", NULL },
+		{ "prog", "-i", "a", "-i", "b", NULL },
+		{ "prog", "-x", NULL },
+		{ "prog", "--verbose=3", "-i", "a", NULL },
+		{ "prog", "-i", "a", "--", "-v", NULL },
+	};
+
+	for(size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+		int count = 0;
+		while(count < 6 && lines[i][count] != NULL) {
+			count++;
+		}
+		char** line = const_cast<char**>(lines[i]);
+		string s = runStatic(parser, count, line);
+		string d = runDynamic(om, count, line);
+		cout << "Line " << i + 1 << (s == d ? " (same)" : " (DIFFERENT)") << ": " << s << endl;
+		if(s != d) {
+			cout << "  OptionManager: " << d << endl;
+			gErrors++;
+		}
+	}
+
+	if(argc > 1) {
+		cout << "Command line: " << runStatic(parser, argc, argv) << endl;
+	}
+
+	cout << (gErrors == 0 ? "OK" : "FAILED") << endl;
+	return gErrors == 0 ? 0 : 1;
+}
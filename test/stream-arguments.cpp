@@ -0,0 +1,49 @@
+/*
+ * stream-arguments.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Argumentos posicionales pasados según se analizan, sin guardarlos: se
+ * muestran al llegar y al final sólo se sabe cuántos hubo. Con más de 5
+ * argumentos el análisis falla en cuanto llega el sexto.
+ */
+
+static int
+onArgument(const StringRef argument, int position) {
+	cout << "Argument " << position << ": " << argument.str() << endl;
+	return 0;
+}
+
+int
+main(int argc, char** argv) {
+
+	OptionManager om(argc, argv);
+
+	om.option("verbose", 'v').alias("v").description("More verbose output.");
+	om.argumentCountRange().max = 6;	// El nombre del programa y 5 más.
+	om.streamArguments(onArgument);
+
+	try {
+		om.process();
+	} catch(clipp::error::Exception& e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+
+	cout << "Verbose: " << (om.hasOption("verbose") ? "yes" : "no") << endl;
+	cout << "Arguments: " << om.countArguments() - 1 << " (program: " << om.getArgument(0) << ")" << endl;
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * subcommands.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+using namespace clipp;
+
+/**
+ * Subcomandos: "subcommands [-v] build|run ...". Cada subcomando tiene sus
+ * opciones, su ayuda y su número de argumentos, y sus definiciones sólo se
+ * crean cuando se elige. Sin argumentos se prueban varias líneas de
+ * comandos; con argumentos se analizan esos.
+ */
+
+static int	gBuilt = 0;
+static int	gErrors = 0;
+
+static void
+build(OptionManager& om) {
+	gBuilt++;
+	om.usage("subcommands build [options] target...");
+	om.option("jobs", 'j').alias("j").typeInteger().argumentRequired().description("Number of parallel jobs.");
+	om.option("release").description("Optimized build.");
+	om.argumentCountRange().min = 2;
+}
+
+static void
+run(OptionManager& om) {
+	gBuilt++;
+	om.usage("subcommands run [options] [program]");
+	om.option("debug", 'g').alias("g").description("Run in the debugger.");
+	om.argumentCountRange().max = 2;
+}
+
+static void
+check(bool ok, const string what) {
+	cout << "  " << (ok ? "ok    " : "ERROR ") << what << endl;
+	if(!ok) {
+		gErrors++;
+	}
+}
+
+static void
+define(OptionManager& om) {
+	om.credits("subcommands 1.0");
+	om.usage("subcommands [-v] <command> [options]");
+	om.option("verbose", 'v').alias("v").description("Verbose output.");
+	om.subcommand("build", build, "Builds the targets.");
+	om.subcommand("run", run, "Runs a program.");
+}
+
+int
+main(int argc, char** argv) {
+	if(argc > 1) {
+		OptionManager om;
+		define(om);
+		try {
+			om.process(argc, argv);
+		} catch(clipp::error::Exception& e) {
+			cerr << "ERROR: " << e.what() << endl;
+			return 1;
+		}
+		if(om.selectedSubcommand().empty()) {
+			cout << om;
+		} else {
+			OptionManager& sub = om.subcommand(om.selectedSubcommand());
+			cout << "Command: " << om.selectedSubcommand() << endl << sub;
+			for(int i = 1; i < sub.countArguments(); i++) {
+				cout << "Argument: " << sub.getArgument(i) << endl;
+			}
+		}
+		return 0;
+	}
+
+	OptionManager om;
+	define(om);
+	cout << om << endl;
+	check(gBuilt == 0, "help does not build the subcommands");
+
+	cout << "subcommands -v build -j 4 all:" << endl;
+	const char* line1[] = { "subcommands", "-v", "build", "-j", "4", "all" };
+	om.process(6, const_cast<char**>(line1));
+	OptionManager& b = om.subcommand("build");
+	check(om.hasOption("verbose") && om.countArguments() == 1, "global option, no arguments");
+	check(om.selectedSubcommand() == "build", "build selected");
+	check(b.getOption("jobs") != NULL && b.getOption("jobs")->get<int>(0) == 4, "-j 4 in build");
+	check(b.countArguments() == 2 && b.getArgument(0) == "build" && b.getArgument(1) == "all", "build arguments");
+	check(gBuilt == 1, "only build has been built");
+
+	cout << "subcommands run -g:" << endl;
+	const char* line2[] = { "subcommands", "run", "-g" };
+	om.process(3, const_cast<char**>(line2));
+	check(!om.hasOption("verbose") && om.selectedSubcommand() == "run", "run selected");
+	check(om.subcommand("run").hasOption("debug"), "-g in run");
+	check(gBuilt == 2, "run built on first use");
+
+	cout << "subcommands -- build:" << endl;
+	const char* line3[] = { "subcommands", "--", "build" };
+	om.process(3, const_cast<char**>(line3));
+	check(om.selectedSubcommand().empty() && om.countArguments() == 2, "after '--' it is an argument");
+
+	cout << "subcommands file build:" << endl;
+	const char* line4[] = { "subcommands", "file", "build" };
+	om.process(3, const_cast<char**>(line4));
+	check(om.selectedSubcommand().empty() && om.countArguments() == 3, "only the first argument can be a subcommand");
+
+	cout << "Errors:" << endl;
+	const char* line5[] = { "subcommands", "build", "-g", "all" };
+	try {
+		om.process(4, const_cast<char**>(line5));
+		check(false, "-g is not an option of build");
+	} catch(clipp::error::InvalidOption& e) {
+		check(true, e.what());
+	}
+	const char* line6[] = { "subcommands", "build" };
+	try {
+		om.process(2, const_cast<char**>(line6));
+		check(false, "build needs a target");
+	} catch(clipp::error::Length& e) {
+		check(true, e.what());
+	}
+	try {
+		om.subcommand("deploy");
+		check(false, "deploy does not exist");
+	} catch(clipp::error::InvalidOption& e) {
+		check(true, e.what());
+	}
+	try {
+		om.subcommand("run", run);
+		check(false, "run already exists");
+	} catch(clipp::error::AlreadyExists& e) {
+		check(true, e.what());
+	}
+
+	cout << endl << om.subcommand("build");
+	cout << (gErrors == 0 ? "OK" : "FAILED") << endl;
+	return gErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+/*
+ * suggestions.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "TestLines.hpp"
+
+using namespace clipp;
+
+/**
+ * Sugerencias de opciones parecidas a una inválida. Sin argumentos se
+ * comprueban varias líneas; con argumentos se procesan como las de un
+ * programa normal.
+ */
+
+static void
+define(OptionManager& om) {
+	om.option("verbose", 'v').alias("loud").description("Verbose output.");
+	om.option("version").description("Show version.");
+	om.option("output").argumentRequired().description("Output file.");
+	om.option("color").alias("colour").description("Colored output.");
+	om.option("recursive", 'r').description("Recurse into directories.");
+	om.option("recurse").description("Same as --recursive.");
+}
+
+/**
+ * Procesa una línea (palabras separadas por espacios) y comprueba el
+ * mensaje del error y las sugerencias de la excepción.
+ */
+static void
+expect(OptionManager& om, const string line, const string expected, size_t suggestions = 0) {
+	test::Line argv("suggestions", line);
+	string got = "no error";
+	size_t count = 0;
+	try {
+		om.process(argv.argc(), argv.argv());
+	} catch(clipp::error::InvalidOption& e) {
+		got = e.what();
+		count = e.suggestions().size();
+	}
+	if(!test::check(line, got, got == expected && count == suggestions)) {
+		cout << "        expected: " << expected << " (" << suggestions << " suggestions, got " << count << ")" << endl;
+	}
+}
+
+int
+main(int argc, char** argv) {
+	OptionManager om;
+	define(om);
+	if(argc > 1) {
+		try {
+			om.process(argc, argv);
+		} catch(clipp::error::Exception& e) {
+			cerr << e.what() << endl;
+			return 1;
+		}
+		cout << "Processed " << om.countProcessedOptions() << " options." << endl;
+		return 0;
+	}
+
+	cout << "Typos:" << endl;
+	expect(om, "--verbos", "Invalid option: --verbos (did you mean --verbose?)", 1);
+	expect(om, "--recrusive", "Invalid option: --recrusive (did you mean --recursive, --recurse?)", 2);
+	expect(om, "--verison", "Invalid option: --verison (did you mean --version?)", 1);
+	expect(om, "--recurs", "Invalid option: --recurs (did you mean --recurse?)", 1);
+	expect(om, "--colou", "Invalid option: --colou (did you mean --color?)", 1);
+	expect(om, "--colr", "Invalid option: --colr (did you mean --color?)", 1);
+	expect(om, "--lod", "Invalid option: --lod (did you mean --loud?)", 1);
+	cout << "Other forms:" << endl;
+	expect(om, "--ouptut=file", "Invalid option: -ouptut (did you mean --output?)", 1);
+	expect(om, "--no-verbse", "Invalid option: --no-verbse (did you mean --no-verbose?)", 1);
+	expect(om, "-output", "Invalid option: -output (did you mean --output?)", 1);
+	cout << "Nothing close:" << endl;
+	expect(om, "--xyz", "Invalid option: --xyz");
+	expect(om, "-x", "Invalid option: -x");
+	cout << "Disabled:" << endl;
+	om.suggestions(0);
+	expect(om, "--verbos", "Invalid option: --verbos");
+	om.suggestions(1);
+	expect(om, "--recrusive", "Invalid option: --recrusive (did you mean --recursive?)", 1);
+
+	return test::result();
+}
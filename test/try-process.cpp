@@ -0,0 +1,115 @@
+/*
+ * try-process.cpp
+ *
+ *  Created on: 16/10/2026
+ *        User: diego
+ *      Author: Diego Lago <diego.lago.gonzalez@gmail.com>
+ */
+
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+#include <cli++/OptionManager.hpp>
+
+#include "TestLines.hpp"
+
+using namespace clipp;
+
+/**
+ * Análisis sin excepciones: cada línea se procesa con "process()" y con
+ * "tryProcess()" y los mensajes tienen que ser iguales; también se
+ * comprueban el tipo, la posición del elemento y la de la definición del
+ * error, y que se guarden todos con "collectAll".
+ */
+
+static void
+define(OptionManager& om) {
+	om.abbreviations(true);
+	om.option("verbose", 'v').alias("v").description("Verbose output.");
+	om.option("version").description("Show the version.");
+	om.option("level", 'l').alias("l").typeInteger().argumentRequired().description("Level.");
+	om.option("color").argumentRequired().validString("red").validString("blue").description("Color.");
+	om.option("output", 'o').alias("o").argumentRequired().required().description("Output file.");
+	om.option("user").argumentRequired().requiredIfOption("password").description("User.");
+	om.option("password").argumentRequired().description("Password.");
+	om.option("quiet", 'q').alias("q").conflictsWith("verbose").description("Quiet.");
+	om.option("help").exclusive().description("Help.");
+	om.option("x").argument().description("Optional argument.");
+	om.argumentCountRange().max = 3;
+}
+
+/**
+ * Procesa una línea de las dos formas y comprueba el mensaje, el tipo, el
+ * elemento y la definición del primer error ("" si no hay error).
+ */
+static void
+expect(OptionManager& om, const string line, OptionManager::Error error, int token, int slot) {
+	test::Line argv("try-process", line);
+	string thrown;
+	try {
+		om.process(argv.argc(), argv.argv());
+	} catch(clipp::error::Exception& e) {
+		thrown = e.what();
+	}
+	OptionManager::Status status = om.tryProcess(argv.argc(), argv.argv());
+	string message = (status.error != OptionManager::ERROR_NONE ? om.errorMessage(0) : string());
+	ostringstream got;
+	got << status.error << " " << status.token << " " << status.slot << " " << message;
+	if(!test::check(line, got.str(), message == thrown && status.error == error && status.token == token && status.slot == slot)) {
+		cout << "        thrown: " << thrown << endl;
+	}
+}
+
+/**
+ * Procesa una línea guardando todos los errores y comprueba cuántos hay.
+ */
+static void
+expectAll(OptionManager& om, const string line, int count) {
+	test::Line argv("try-process", line);
+	om.tryProcess(argv.argc(), argv.argv(), true);
+	test::check(line, StringFrom<int>(om.countErrors()) + " errors", om.countErrors() == count);
+	for(int i = 0; i < om.countErrors(); i++) {
+		cout << "        " << om.parseError(i).token << ": " << om.errorMessage(i) << endl;
+	}
+}
+
+int
+main(int argc, char** argv) {
+	OptionManager om;
+	define(om);
+	if(argc > 1) {
+		OptionManager::Status status = om.tryProcess(argc, argv, true);
+		for(int i = 0; i < om.countErrors(); i++) {
+			cerr << om.errorMessage(i) << endl;
+		}
+		return status.error == OptionManager::ERROR_NONE ? 0 : 1;
+	}
+
+	cout << "Same messages as the exceptions:" << endl;
+	expect(om, "-o out -v a b", OptionManager::ERROR_NONE, -1, -1);
+	expect(om, "-o out --verbsoe", OptionManager::ERROR_INVALID_OPTION, 3, -1);
+	expect(om, "-o out --no-verbsoe", OptionManager::ERROR_INVALID_OPTION, 3, -1);
+	expect(om, "-o out --levl=3", OptionManager::ERROR_INVALID_OPTION, 3, -1);
+	expect(om, "-o out -z", OptionManager::ERROR_INVALID_OPTION, 3, -1);
+	expect(om, "-o out --ver", OptionManager::ERROR_AMBIGUOUS_OPTION, 3, -1);
+	expect(om, "-o out -xv", OptionManager::ERROR_AMBIGUOUS_OPTION, 3, 9);
+	expect(om, "-o out --verbose=1", OptionManager::ERROR_INVALID_ARGUMENT, 3, 0);
+	expect(om, "-o out -l x", OptionManager::ERROR_INVALID_ARGUMENT, -1, 2);
+	expect(om, "-o out --color green", OptionManager::ERROR_INVALID_ARGUMENT, -1, 3);
+	expect(om, "-o", OptionManager::ERROR_REQUIRED_ARGUMENT, 1, 4);
+	expect(om, "-v", OptionManager::ERROR_REQUIRED_OPTION, -1, 4);
+	expect(om, "-o out --password p", OptionManager::ERROR_REQUIRED_OPTION, -1, 5);
+	expect(om, "-o out -q -v", OptionManager::ERROR_CONFLICT, -1, 7);
+	expect(om, "-o out -v -v", OptionManager::ERROR_MULTIPLE_OPTION, 4, 0);
+	expect(om, "--help -o out", OptionManager::ERROR_EXCLUSIVE_OPTION, -1, 8);
+	expect(om, "-o out a b c d", OptionManager::ERROR_LENGTH, -1, -1);
+
+	cout << "All the errors:" << endl;
+	expectAll(om, "-o out", 0);
+	expectAll(om, "--verbsoe -l x -q -v --password p a b c d", 6);
+	expectAll(om, "-v -v --ver -z", 4);
+
+	return test::result();
+}